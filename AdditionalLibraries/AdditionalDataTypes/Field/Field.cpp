@@ -6,6 +6,8 @@ Field::Field()
 {
     this->isNull = true;
     this->columnIndex = 0;
+    this->operatorType = OperatorNone;
+    this->conditionType = ConditionNone;
 }
 
 Field::Field(const string &data, const Constants::column_index_t& columnIndex, const bool &isNull)
@@ -13,6 +15,8 @@ Field::Field(const string &data, const Constants::column_index_t& columnIndex, c
     this->data = data;
     this->isNull = isNull;
     this->columnIndex = columnIndex;
+    this->operatorType = OperatorNone;
+    this->conditionType = ConditionNone;
 }
 
 Field::Field(const u16string &data, const Constants::column_index_t &columnIndex, const bool &isNull)
@@ -20,6 +24,17 @@ Field::Field(const u16string &data, const Constants::column_index_t &columnIndex
     this->unicodeData = data;
     this->isNull = isNull;
     this->columnIndex = columnIndex;
+    this->operatorType = OperatorNone;
+    this->conditionType = ConditionNone;
+}
+
+Field::Field(const vector<Field> &children, const ConditionType &conditionType)
+{
+    this->children = children;
+    this->isNull = false;
+    this->columnIndex = 0;
+    this->operatorType = OperatorNone;
+    this->conditionType = conditionType;
 }
 
 Field::Field(const string& data, const Constants::column_index_t& columnIndex , const Operator& operatorType, const ConditionType& conditionType, const bool& isNull)
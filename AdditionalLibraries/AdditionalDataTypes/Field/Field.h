@@ -18,7 +18,8 @@ class Field {
         Field();
         explicit Field(const string& data, const Constants::column_index_t& columnIndex , const bool& isNull = false);
         explicit Field(const u16string& data, const Constants::column_index_t& columnIndex , const bool& isNull = false);
-        explicit Field(const vector<Field>& children);
+        // a group of conditions evaluated together, combined with the conditions before it by conditionType
+        explicit Field(const vector<Field>& children, const Constants::ConditionType& conditionType = Constants::ConditionNone);
         explicit Field(const string& data
                         , const Constants::column_index_t& columnIndex
                         , const Constants::Operator& operatorType
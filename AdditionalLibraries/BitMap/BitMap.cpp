@@ -49,7 +49,7 @@ namespace ByteMaps
             data[position] = value;
     }
 
-    void BitMap::GetDataFromFile(const vector<char> &data, Constants::page_offset_t &offset)
+    void BitMap::GetDataFromFile(const span<const char> &data, Constants::page_offset_t &offset)
     {
         memcpy(&this->size, data.data() + offset, sizeof(Constants::bit_map_size_t));
         offset += sizeof(Constants::bit_map_size_t);
@@ -69,7 +69,7 @@ namespace ByteMaps
         }
     }
 
-    void BitMap::WriteDataToFile(fstream *filePtr)
+    void BitMap::WriteDataToFile(ostream *filePtr)
     {
         filePtr->write(reinterpret_cast<char *>(&this->size), sizeof(Constants::bit_map_size_t));
         filePtr->write(reinterpret_cast<char *>(this->data.data()), this->data.size() * sizeof(Constants::byte));
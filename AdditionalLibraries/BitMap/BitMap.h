@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <fstream>
 #include <vector>
+#include <span>
 #include "../../Database/Constants.h"
 
 using namespace std;
@@ -30,8 +31,8 @@ namespace ByteMaps
         [[nodiscard]] const bit_map_size_t &GetSize() const;
         [[nodiscard]] bit_map_size_t GetSizeInBytes() const;
 
-        void GetDataFromFile(const vector<char> &data, page_offset_t &offset);
-        void WriteDataToFile(fstream *filePtr);
+        void GetDataFromFile(const span<const char> &data, page_offset_t &offset);
+        void WriteDataToFile(ostream *filePtr);
         void Print() const;
 
         [[nodiscard]] const vector<Constants::byte> &GetData() const;
@@ -78,7 +78,7 @@ namespace ByteMaps {
             data[position] = value;
     }
 
-    void ByteMap::GetDataFromFile(const vector<char> &data, page_offset_t &offset, const page_size_t& byteMapSize)
+    void ByteMap::GetDataFromFile(const span<const char> &data, page_offset_t &offset, const page_size_t& byteMapSize)
     {
         for (bit_map_size_t i = 0; i < byteMapSize; i++)
         {
@@ -90,7 +90,7 @@ namespace ByteMaps {
         }
     }
 
-    void ByteMap::WriteDataToFile(fstream *filePtr)
+    void ByteMap::WriteDataToFile(ostream *filePtr)
     {
         filePtr->write(reinterpret_cast<const char*>(this->data.data()), this->data.size() * sizeof(Constants::byte));
     }
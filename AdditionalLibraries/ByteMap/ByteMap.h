@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <vector>
+#include <span>
 #include <stdexcept>
 #include <fstream>
 
@@ -29,8 +30,8 @@ namespace ByteMaps {
         void SetFreeSpace(const byte_map_pos_t& pos, const Constants::byte& percentage);
         page_size_t GetFreeSpace(const byte_map_pos_t& pos) const;
 
-        void GetDataFromFile(const vector<char> &data, page_offset_t &offset, const page_size_t& byteMapSize);
-        void WriteDataToFile(fstream* filePtr);
+        void GetDataFromFile(const span<const char> &data, page_offset_t &offset, const page_size_t& byteMapSize);
+        void WriteDataToFile(ostream* filePtr);
         void Print() const;
 
         void SetByte(const byte_map_pos_t& position, const Constants::byte& value);
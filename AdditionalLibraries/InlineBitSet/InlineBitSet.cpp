@@ -0,0 +1,168 @@
+#include "InlineBitSet.h"
+#include <cstring>
+
+namespace ByteMaps
+{
+    InlineBitSet::InlineBitSet()
+    {
+        this->heapBytes = nullptr;
+        this->size = 0;
+        memset(this->inlineBytes, 0, INLINE_BIT_SET_BYTES);
+    }
+
+    InlineBitSet::InlineBitSet(const bit_map_size_t &size) : InlineBitSet()
+    {
+        this->Resize(size);
+    }
+
+    InlineBitSet::InlineBitSet(const InlineBitSet &bitSet) : InlineBitSet()
+    {
+        *this = bitSet;
+    }
+
+    InlineBitSet::InlineBitSet(InlineBitSet &&bitSet) noexcept
+    {
+        this->size = bitSet.size;
+        this->heapBytes = bitSet.heapBytes;
+        memcpy(this->inlineBytes, bitSet.inlineBytes, INLINE_BIT_SET_BYTES);
+
+        bitSet.heapBytes = nullptr;
+        bitSet.size = 0;
+    }
+
+    InlineBitSet::~InlineBitSet() { delete[] this->heapBytes; }
+
+    InlineBitSet &InlineBitSet::operator=(const InlineBitSet &bitSet)
+    {
+        if (this == &bitSet)
+            return *this;
+
+        delete[] this->heapBytes;
+        this->heapBytes = nullptr;
+        this->size = 0;
+        memset(this->inlineBytes, 0, INLINE_BIT_SET_BYTES);
+
+        this->Resize(bitSet.size);
+
+        memcpy(this->GetBytes(), bitSet.GetBytes(), InlineBitSet::GetNumberOfBytes(bitSet.size));
+
+        return *this;
+    }
+
+    InlineBitSet &InlineBitSet::operator=(InlineBitSet &&bitSet) noexcept
+    {
+        if (this == &bitSet)
+            return *this;
+
+        delete[] this->heapBytes;
+
+        this->size = bitSet.size;
+        this->heapBytes = bitSet.heapBytes;
+        memcpy(this->inlineBytes, bitSet.inlineBytes, INLINE_BIT_SET_BYTES);
+
+        bitSet.heapBytes = nullptr;
+        bitSet.size = 0;
+
+        return *this;
+    }
+
+    bit_map_size_t InlineBitSet::GetNumberOfBytes(const bit_map_size_t &size) { return (size + 7) / 8; }
+
+    Constants::byte *InlineBitSet::GetBytes() { return (this->heapBytes != nullptr) ? this->heapBytes : this->inlineBytes; }
+
+    const Constants::byte *InlineBitSet::GetBytes() const { return (this->heapBytes != nullptr) ? this->heapBytes : this->inlineBytes; }
+
+    void InlineBitSet::Resize(const bit_map_size_t &newSize)
+    {
+        const bit_map_size_t currentNumberOfBytes = InlineBitSet::GetNumberOfBytes(this->size);
+        const bit_map_size_t newNumberOfBytes = InlineBitSet::GetNumberOfBytes(newSize);
+
+        // only tables wider than the inline bytes get here
+        if (newNumberOfBytes > INLINE_BIT_SET_BYTES && newNumberOfBytes > currentNumberOfBytes)
+        {
+            auto *newBytes = new Constants::byte[newNumberOfBytes]();
+            memcpy(newBytes, this->GetBytes(), currentNumberOfBytes);
+
+            delete[] this->heapBytes;
+            this->heapBytes = newBytes;
+        }
+
+        // bits dropped now must not come back if the set grows again
+        for (bit_map_pos_t position = newSize; position < this->size; position++)
+            this->GetBytes()[position / 8] &= ~(1 << (position % 8));
+
+        this->size = newSize;
+    }
+
+    void InlineBitSet::Set(const bit_map_pos_t &position, const bool &value)
+    {
+        if (position >= this->size)
+            this->Resize(position + 1);
+
+        Constants::byte *bytes = this->GetBytes();
+
+        if (value)
+        {
+            bytes[position / 8] |= (1 << (position % 8));
+            return;
+        }
+
+        bytes[position / 8] &= ~(1 << (position % 8));
+    }
+
+    bool InlineBitSet::Get(const bit_map_pos_t &position) const
+    {
+        if (position >= this->size)
+            return false;
+
+        return this->GetBytes()[position / 8] & (1 << (position % 8));
+    }
+
+    const bit_map_size_t &InlineBitSet::GetSize() const { return this->size; }
+
+    bit_map_size_t InlineBitSet::GetSizeInBytes() const { return InlineBitSet::GetNumberOfBytes(this->size) + sizeof(bit_map_size_t); }
+
+    bool InlineBitSet::HasAnySet() const
+    {
+        const Constants::byte *bytes = this->GetBytes();
+
+        for (bit_map_size_t i = 0; i < InlineBitSet::GetNumberOfBytes(this->size); i++)
+            if (bytes[i] != 0)
+                return true;
+
+        return false;
+    }
+
+    void InlineBitSet::GetDataFromFile(const span<const char> &data, page_offset_t &offset)
+    {
+        bit_map_size_t fileSize;
+        memcpy(&fileSize, data.data() + offset, sizeof(bit_map_size_t));
+        offset += sizeof(bit_map_size_t);
+
+        this->Resize(fileSize);
+
+        const bit_map_size_t bytesToRead = InlineBitSet::GetNumberOfBytes(fileSize);
+
+        memcpy(this->GetBytes(), data.data() + offset, bytesToRead);
+        offset += bytesToRead;
+    }
+
+    void InlineBitSet::WriteDataToFile(ostream *filePtr) const
+    {
+        filePtr->write(reinterpret_cast<const char *>(&this->size), sizeof(bit_map_size_t));
+        filePtr->write(reinterpret_cast<const char *>(this->GetBytes()), InlineBitSet::GetNumberOfBytes(this->size));
+    }
+
+    void InlineBitSet::WriteBitsToFile(ostream *filePtr, const bit_map_size_t &numberOfBits) const
+    {
+        const bit_map_size_t bytesToWrite = InlineBitSet::GetNumberOfBytes(numberOfBits);
+        const bit_map_size_t bytesSet = InlineBitSet::GetNumberOfBytes(this->size);
+
+        // positions past the size of the set are unset
+        for (bit_map_size_t i = 0; i < bytesToWrite; i++)
+        {
+            const char currentByte = (i < bytesSet) ? static_cast<char>(this->GetBytes()[i]) : 0;
+            filePtr->write(&currentByte, sizeof(char));
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <fstream>
+#include <span>
+#include "../../Database/Constants.h"
+
+using namespace std;
+using namespace Constants;
+
+namespace ByteMaps
+{
+    // bitset kept by value, its bits live inside it for up to INLINE_BIT_SET_BYTES * 8 positions and on the heap past that
+    // reads and writes the same bytes as BitMap, so either can read what the other wrote
+    class InlineBitSet
+    {
+        Constants::byte inlineBytes[INLINE_BIT_SET_BYTES];
+        Constants::byte *heapBytes;
+        bit_map_size_t size;
+
+    protected:
+        void Resize(const bit_map_size_t &newSize);
+        [[nodiscard]] Constants::byte *GetBytes();
+        [[nodiscard]] const Constants::byte *GetBytes() const;
+        [[nodiscard]] static bit_map_size_t GetNumberOfBytes(const bit_map_size_t &size);
+
+    public:
+        InlineBitSet();
+        explicit InlineBitSet(const bit_map_size_t &size);
+        InlineBitSet(const InlineBitSet &bitSet);
+        InlineBitSet(InlineBitSet &&bitSet) noexcept;
+        ~InlineBitSet();
+
+        InlineBitSet &operator=(const InlineBitSet &bitSet);
+        InlineBitSet &operator=(InlineBitSet &&bitSet) noexcept;
+
+        void Set(const bit_map_pos_t &position, const bool &value);
+
+        [[nodiscard]] bool Get(const bit_map_pos_t &position) const;
+        [[nodiscard]] const bit_map_size_t &GetSize() const;
+        [[nodiscard]] bit_map_size_t GetSizeInBytes() const;
+        [[nodiscard]] bool HasAnySet() const;
+
+        void GetDataFromFile(const span<const char> &data, page_offset_t &offset);
+        void WriteDataToFile(ostream *filePtr) const;
+        // only the bytes of the first numberOfBits bits, the reader has to know how many there are
+        void WriteBitsToFile(ostream *filePtr, const bit_map_size_t &numberOfBits) const;
+    };
+}
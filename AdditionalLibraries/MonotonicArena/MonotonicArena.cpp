@@ -0,0 +1,125 @@
+#include "MonotonicArena.h"
+#include <cstdint>
+#include <new>
+
+namespace Arenas
+{
+    // keeps the object behind it aligned as operator new would
+    constexpr size_t ALLOCATION_TAG_SIZE = alignof(max_align_t);
+
+    MonotonicArena::MonotonicArena(const size_t &chunkSize)
+    {
+        this->current = nullptr;
+        this->bytesLeft = 0;
+        this->chunkSize = chunkSize;
+        this->allocatedBytes = 0;
+    }
+
+    MonotonicArena::~MonotonicArena()
+    {
+        for (const auto &chunk : this->chunks)
+            ::operator delete(chunk, align_val_t(alignof(max_align_t)));
+    }
+
+    void *MonotonicArena::do_allocate(const size_t bytes, const size_t alignment)
+    {
+        size_t padding = (alignment - reinterpret_cast<uintptr_t>(this->current) % alignment) % alignment;
+
+        if (this->current == nullptr || padding + bytes > this->bytesLeft)
+        {
+            this->AddChunk(bytes + alignment);
+            padding = (alignment - reinterpret_cast<uintptr_t>(this->current) % alignment) % alignment;
+        }
+
+        char *allocation = this->current + padding;
+
+        this->current = allocation + bytes;
+        this->bytesLeft -= padding + bytes;
+        this->allocatedBytes += bytes;
+
+        return allocation;
+    }
+
+    // single allocations are never given back, the memory goes when the arena is reset or destroyed
+    void MonotonicArena::do_deallocate(void *, const size_t, const size_t) { }
+
+    bool MonotonicArena::do_is_equal(const pmr::memory_resource &other) const noexcept { return this == &other; }
+
+    void MonotonicArena::AddChunk(const size_t &minimumSize)
+    {
+        // objects bigger than a chunk get a chunk of their own
+        const size_t newChunkSize = (minimumSize > this->chunkSize) ? minimumSize : this->chunkSize;
+
+        char *chunk = static_cast<char *>(::operator new(newChunkSize, align_val_t(alignof(max_align_t))));
+
+        this->chunks.push_back(chunk);
+        this->current = chunk;
+        this->bytesLeft = newChunkSize;
+    }
+
+    size_t MonotonicArena::GetAllocatedBytes() const
+    {
+        size_t allocatedBytes = this->allocatedBytes;
+
+        for (const auto &childArena : this->childArenas)
+            allocatedBytes += childArena->GetAllocatedBytes();
+
+        return allocatedBytes;
+    }
+
+    MonotonicArena *MonotonicArena::CreateChildArena()
+    {
+        this->childArenas.push_back(make_unique<MonotonicArena>(this->chunkSize));
+
+        return this->childArenas.back().get();
+    }
+
+    void MonotonicArena::Reset()
+    {
+        this->allocatedBytes = 0;
+        this->childArenas.clear();
+
+        if (this->chunks.empty())
+            return;
+
+        for (size_t i = 1; i < this->chunks.size(); i++)
+            ::operator delete(this->chunks[i], align_val_t(alignof(max_align_t)));
+
+        this->chunks.resize(1);
+
+        // the first chunk can have been sized for an object bigger than chunkSize, only chunkSize of it is reused
+        this->current = this->chunks.front();
+        this->bytesLeft = this->chunkSize;
+    }
+
+    pmr::memory_resource *MonotonicArena::GetResource(MonotonicArena *arena) { return (arena != nullptr) ? arena : pmr::new_delete_resource(); }
+
+    void *ArenaObject::operator new(const size_t size) { return ArenaObject::operator new(size, nullptr); }
+
+    void *ArenaObject::operator new(const size_t size, MonotonicArena *arena)
+    {
+        char *allocation = (arena != nullptr)
+                            ? static_cast<char *>(arena->allocate(ALLOCATION_TAG_SIZE + size, alignof(max_align_t)))
+                            : static_cast<char *>(::operator new(ALLOCATION_TAG_SIZE + size));
+
+        *reinterpret_cast<MonotonicArena **>(allocation) = arena;
+
+        return allocation + ALLOCATION_TAG_SIZE;
+    }
+
+    void ArenaObject::operator delete(void *object)
+    {
+        if (object == nullptr)
+            return;
+
+        char *allocation = static_cast<char *>(object) - ALLOCATION_TAG_SIZE;
+
+        // arena memory goes back with the arena
+        if (*reinterpret_cast<MonotonicArena **>(allocation) != nullptr)
+            return;
+
+        ::operator delete(allocation);
+    }
+
+    void ArenaObject::operator delete(void *object, MonotonicArena *) { ArenaObject::operator delete(object); }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+using namespace std;
+
+namespace Arenas
+{
+    // bump allocator over chunks that are only given back all at once, when the arena is destroyed
+    // it never runs destructors, whatever is carved from it is still destructed by its owner
+    class MonotonicArena final : public pmr::memory_resource
+    {
+        vector<char *> chunks;
+        char *current;
+        size_t bytesLeft;
+        size_t chunkSize;
+        size_t allocatedBytes;
+        vector<unique_ptr<MonotonicArena>> childArenas;
+
+    protected:
+        void *do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+        [[nodiscard]] bool do_is_equal(const pmr::memory_resource &other) const noexcept override;
+        void AddChunk(const size_t &minimumSize);
+
+    public:
+        explicit MonotonicArena(const size_t &chunkSize);
+        MonotonicArena(const MonotonicArena &other) = delete;
+        ~MonotonicArena() override;
+
+        [[nodiscard]] size_t GetAllocatedBytes() const;
+
+        // hands back everything carved so far, the first chunk is kept and carved from again, child arenas are freed
+        void Reset();
+
+        // an arena of its own for a thread carving objects next to others, it is freed together with this one
+        // arenas are not synchronized, children are created before the threads using them start
+        MonotonicArena *CreateChildArena();
+
+        // the heap when there is no arena
+        static pmr::memory_resource *GetResource(MonotonicArena *arena);
+    };
+
+    // new (arena) carves the object from the arena and its delete gives nothing back, plain new and new (nullptr) go to the heap
+    // every allocation remembers where it came from so owners delete both kinds the same way
+    class ArenaObject
+    {
+    public:
+        static void *operator new(size_t size);
+        static void *operator new(size_t size, MonotonicArena *arena);
+        static void operator delete(void *object);
+        static void operator delete(void *object, MonotonicArena *arena);
+    };
+}
@@ -0,0 +1,248 @@
+#include "ThreadPool.h"
+#include <chrono>
+#include <limits>
+#include "../../Database/Constants.h"
+
+namespace Threading {
+    // queue of the worker running on this thread, none on threads outside the pool
+    static thread_local const ThreadPool *currentPool = nullptr;
+    static thread_local size_t currentWorkerIndex = numeric_limits<size_t>::max();
+
+    TaskGroup::TaskGroup()
+    {
+        this->pendingTasks = 0;
+        this->taskException = nullptr;
+    }
+
+    TaskGroup::~TaskGroup() { this->WaitForTasks(); }
+
+    void TaskGroup::Run(function<void()> task) { ThreadPool::Get().Submit(*this, std::move(task)); }
+
+    void TaskGroup::Wait()
+    {
+        this->WaitForTasks();
+
+        if (this->taskException == nullptr)
+            return;
+
+        const exception_ptr exception = this->taskException;
+        this->taskException = nullptr;
+
+        rethrow_exception(exception);
+    }
+
+    void TaskGroup::WaitForTasks()
+    {
+        ThreadPool &pool = ThreadPool::Get();
+
+        while (this->pendingTasks.load() > 0)
+        {
+            if (pool.TryRunTask())
+                continue;
+
+            // what is left is running on the workers, or was queued after the check above and is picked up on the next round
+            unique_lock lock(this->groupMutex);
+            this->groupCondition.wait_for(lock, chrono::milliseconds(1), [this] { return this->pendingTasks.load() == 0; });
+        }
+
+        lock_guard lock(this->groupMutex);
+    }
+
+    void TaskGroup::FinishTask(const exception_ptr &exception)
+    {
+        // counted down under the lock, WaitForTasks takes it once more before returning so the group is not destroyed while this still uses it
+        lock_guard lock(this->groupMutex);
+
+        if (exception != nullptr && this->taskException == nullptr)
+            this->taskException = exception;
+
+        if (this->pendingTasks.fetch_sub(1) == 1)
+            this->groupCondition.notify_all();
+    }
+
+    ThreadPool::ThreadPool()
+    {
+        this->queuedTasks = 0;
+        this->nextQueue = 0;
+        this->isStopping = false;
+
+        this->Start(Constants::WORKER_THREADS);
+    }
+
+    ThreadPool::~ThreadPool() { this->Stop(); }
+
+    ThreadPool &ThreadPool::Get()
+    {
+        static ThreadPool threadPool;
+
+        return threadPool;
+    }
+
+    void ThreadPool::Start(const size_t &numberOfThreads)
+    {
+        size_t workerCount = (numberOfThreads == 0) ? thread::hardware_concurrency() : numberOfThreads;
+
+        if (workerCount == 0)
+            workerCount = 1;
+
+        this->isStopping = false;
+
+        for (size_t i = 0; i < workerCount; i++)
+            this->queues.push_back(make_unique<WorkerQueue>());
+
+        for (size_t i = 0; i < workerCount; i++)
+            this->workers.emplace_back([this, i] { this->Run(i); });
+    }
+
+    void ThreadPool::Stop()
+    {
+        {
+            lock_guard lock(this->sleepMutex);
+            this->isStopping = true;
+        }
+
+        this->sleepCondition.notify_all();
+
+        for (auto &worker : this->workers)
+            worker.join();
+
+        this->workers.clear();
+        this->queues.clear();
+    }
+
+    void ThreadPool::Configure(const size_t &numberOfThreads)
+    {
+        call_once(this->configureFlag, [this, &numberOfThreads] { this->Resize(numberOfThreads); });
+    }
+
+    void ThreadPool::Resize(const size_t &numberOfThreads)
+    {
+        const size_t workerCount = (numberOfThreads == 0) ? thread::hardware_concurrency() : numberOfThreads;
+
+        if (workerCount == this->workers.size())
+            return;
+
+        this->Stop();
+        this->Start(numberOfThreads);
+    }
+
+    void ThreadPool::Submit(TaskGroup &group, function<void()> work)
+    {
+        group.pendingTasks++;
+
+        // a task queued by a worker goes to its own deque, it is the likeliest to run it while its data is still in cache
+        const size_t queueIndex = this->IsWorkerThread()
+                                    ? currentWorkerIndex
+                                    : this->nextQueue.fetch_add(1) % this->queues.size();
+
+        // counted before it is queued so the count never drops below the tasks in the deques
+        this->queuedTasks++;
+
+        {
+            lock_guard lock(this->queues[queueIndex]->queueMutex);
+            this->queues[queueIndex]->tasks.push_back(Task{ std::move(work), &group });
+        }
+
+        {
+            lock_guard lock(this->sleepMutex);
+        }
+
+        this->sleepCondition.notify_one();
+    }
+
+    bool ThreadPool::TryRunTask()
+    {
+        Task task;
+
+        const bool isWorker = this->IsWorkerThread();
+
+        if (!this->TryTakeAny(isWorker ? currentWorkerIndex : 0, isWorker, task))
+            return false;
+
+        ThreadPool::Execute(task);
+
+        return true;
+    }
+
+    void ThreadPool::Run(const size_t &workerIndex)
+    {
+        currentPool = this;
+        currentWorkerIndex = workerIndex;
+
+        while (true)
+        {
+            Task task;
+
+            if (this->TryTakeAny(workerIndex, true, task))
+            {
+                ThreadPool::Execute(task);
+                continue;
+            }
+
+            unique_lock lock(this->sleepMutex);
+
+            // queued tasks are finished before the pool stops
+            if (this->isStopping && this->queuedTasks.load() == 0)
+                return;
+
+            this->sleepCondition.wait(lock, [this] { return this->isStopping || this->queuedTasks.load() > 0; });
+        }
+    }
+
+    bool ThreadPool::TryTake(const size_t &queueIndex, const bool &isOwnQueue, Task &task)
+    {
+        WorkerQueue &queue = *this->queues[queueIndex];
+
+        lock_guard lock(queue.queueMutex);
+
+        if (queue.tasks.empty())
+            return false;
+
+        // the owner takes the newest task, thieves the oldest, which tends to be the biggest piece of work left
+        if (isOwnQueue)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+
+        this->queuedTasks--;
+
+        return true;
+    }
+
+    bool ThreadPool::TryTakeAny(const size_t &startIndex, const bool &isWorker, Task &task)
+    {
+        const size_t numberOfQueues = this->queues.size();
+
+        for (size_t offset = 0; offset < numberOfQueues; offset++)
+            if (this->TryTake((startIndex + offset) % numberOfQueues, isWorker && offset == 0, task))
+                return true;
+
+        return false;
+    }
+
+    void ThreadPool::Execute(Task &task)
+    {
+        exception_ptr exception = nullptr;
+
+        try
+        {
+            task.work();
+        }
+        catch (...)
+        {
+            exception = current_exception();
+        }
+
+        task.group->FinishTask(exception);
+    }
+
+    size_t ThreadPool::GetNumberOfThreads() const { return this->workers.size(); }
+
+    bool ThreadPool::IsWorkerThread() const { return currentPool == this; }
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace Threading {
+    class ThreadPool;
+
+    // tasks run on the pool and waited for together, the first exception one of them throws is rethrown by Wait
+    class TaskGroup final {
+        atomic<size_t> pendingTasks;
+        mutex groupMutex;
+        condition_variable groupCondition;
+        exception_ptr taskException;
+
+        friend class ThreadPool;
+
+    protected:
+        void FinishTask(const exception_ptr &exception);
+        void WaitForTasks();
+
+    public:
+        TaskGroup();
+        TaskGroup(const TaskGroup &other) = delete;
+        // waits for the tasks still running, their exceptions are dropped
+        ~TaskGroup();
+
+        void Run(function<void()> task);
+        // the waiting thread runs queued tasks itself meanwhile, so a task waiting for tasks of its own cannot starve the pool
+        void Wait();
+    };
+
+    typedef struct Task {
+        function<void()> work;
+        TaskGroup *group;
+    } Task;
+
+    // fixed number of workers, each with a deque of its own: a worker pushes and pops at the back of its deque and steals from the front of the others
+    // tasks submitted from outside the pool are spread over the deques round robin, idle workers sleep until a task is queued
+    class ThreadPool final {
+        typedef struct WorkerQueue {
+            deque<Task> tasks;
+            mutex queueMutex;
+        } WorkerQueue;
+
+        vector<unique_ptr<WorkerQueue>> queues;
+        vector<thread> workers;
+        mutex sleepMutex;
+        condition_variable sleepCondition;
+        atomic<size_t> queuedTasks;
+        atomic<size_t> nextQueue;
+        bool isStopping;
+        once_flag configureFlag;
+
+        ThreadPool();
+
+    protected:
+        void Start(const size_t &numberOfThreads);
+        void Stop();
+        // 0 starts one worker per hardware thread, the queued tasks are finished first
+        // the deques are freed, so nothing may submit or wait on the pool meanwhile
+        void Resize(const size_t &numberOfThreads);
+        void Run(const size_t &workerIndex);
+        bool TryTake(const size_t &queueIndex, const bool &isOwnQueue, Task &task);
+        bool TryTakeAny(const size_t &startIndex, const bool &isWorker, Task &task);
+        static void Execute(Task &task);
+
+    public:
+        ThreadPool(const ThreadPool &other) = delete;
+        ~ThreadPool();
+
+        static ThreadPool &Get();
+
+        void Submit(TaskGroup &group, function<void()> work);
+        // runs one queued task on the calling thread, false when there was none
+        bool TryRunTask();
+        // sizes the pool on the first call only, 0 is one worker per hardware thread
+        // databases call it when they are opened, later ones keep the size the first one chose since others may already be running tasks on it
+        void Configure(const size_t &numberOfThreads);
+
+        [[nodiscard]] size_t GetNumberOfThreads() const;
+        [[nodiscard]] bool IsWorkerThread() const;
+    };
+}
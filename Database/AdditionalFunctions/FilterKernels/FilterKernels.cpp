@@ -0,0 +1,387 @@
+#include "FilterKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef FILTER_KERNELS_X86_SUPPORTED
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// msvc emits any instruction set without flags, gcc and clang need the functions using one marked for it
+#if defined(__GNUC__) || defined(__clang__)
+#define FILTER_KERNELS_TARGET(instructionSet) __attribute__((target(instructionSet)))
+#else
+#define FILTER_KERNELS_TARGET(instructionSet)
+#endif
+
+using namespace Constants;
+
+// every operator is one of these, as it is or negated: NotEqual is a negated EQUAL, LessOrEqual a negated GREATER, Between a negated OUTSIDE
+enum class KernelComparison : uint8_t
+{
+    EQUAL = 0,
+    GREATER = 1,
+    LESS = 2,
+    OUTSIDE = 3
+};
+
+static FilterKernelLevel DetectKernelLevel();
+
+static const FilterKernelLevel supportedKernelLevel = DetectKernelLevel();
+static atomic<FilterKernelLevel> kernelLevel = supportedKernelLevel;
+
+#ifdef FILTER_KERNELS_X86_SUPPORTED
+static void ReadCpuid(const uint32_t &leaf, const uint32_t &subLeaf, uint32_t *registers)
+{
+#ifdef _MSC_VER
+    int values[4];
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subLeaf));
+    memcpy(registers, values, sizeof(values));
+#else
+    __cpuid_count(leaf, subLeaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+static uint64_t ReadExtendedControlRegister()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t low, high;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return (static_cast<uint64_t>(high) << 32) | low;
+#endif
+}
+#endif
+
+static FilterKernelLevel DetectKernelLevel()
+{
+#ifdef FILTER_KERNELS_X86_SUPPORTED
+    uint32_t registers[4];
+
+    ReadCpuid(0, 0, registers);
+    const uint32_t highestLeaf = registers[0];
+
+    ReadCpuid(1, 0, registers);
+
+    if ((registers[2] & (1u << 20)) == 0)
+        return FilterKernelLevel::SCALAR;
+
+    // the cpu having avx2 is not enough, the os has to save the ymm registers on context switches too
+    const bool isYmmStateSaved = (registers[2] & (1u << 27)) != 0 && (ReadExtendedControlRegister() & 0x6) == 0x6;
+
+    if (highestLeaf < 7 || !isYmmStateSaved)
+        return FilterKernelLevel::SSE42;
+
+    ReadCpuid(7, 0, registers);
+
+    return (registers[1] & (1u << 5)) != 0
+            ? FilterKernelLevel::AVX2
+            : FilterKernelLevel::SSE42;
+#else
+    return FilterKernelLevel::SCALAR;
+#endif
+}
+
+template<typename T, KernelComparison comparison, bool isNegated>
+static void CompareScalar(const T *values, const size_t &start, const size_t &size, const T &low, const T &high, uint64_t *selection)
+{
+    for (size_t i = start; i < size; i++)
+    {
+        bool isMet;
+
+        if constexpr (comparison == KernelComparison::EQUAL)
+            isMet = values[i] == low;
+        else if constexpr (comparison == KernelComparison::GREATER)
+            isMet = values[i] > low;
+        else if constexpr (comparison == KernelComparison::LESS)
+            isMet = values[i] < low;
+        else
+            isMet = (values[i] < low) | (values[i] > high);
+
+        selection[i / 64] |= static_cast<uint64_t>(isMet != isNegated) << (i % 64);
+    }
+}
+
+#ifdef FILTER_KERNELS_X86_SUPPORTED
+// every kernel compares a register of values at a time and moves the sign bits of the lanes into the selection, the tail is left to CompareScalar
+// the lanes never cross a selection word, 64 is a multiple of every lane count
+template<KernelComparison comparison, bool isNegated>
+FILTER_KERNELS_TARGET("avx2") static void CompareAvx2(const int32_t *values, const size_t &size, const int32_t &low, const int32_t &high, uint64_t *selection)
+{
+    const __m256i lowVector = _mm256_set1_epi32(low);
+    const __m256i highVector = _mm256_set1_epi32(high);
+
+    size_t i = 0;
+
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m256i valueVector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+
+        __m256i result;
+
+        if constexpr (comparison == KernelComparison::EQUAL)
+            result = _mm256_cmpeq_epi32(valueVector, lowVector);
+        else if constexpr (comparison == KernelComparison::GREATER)
+            result = _mm256_cmpgt_epi32(valueVector, lowVector);
+        else if constexpr (comparison == KernelComparison::LESS)
+            result = _mm256_cmpgt_epi32(lowVector, valueVector);
+        else
+            result = _mm256_or_si256(_mm256_cmpgt_epi32(lowVector, valueVector), _mm256_cmpgt_epi32(valueVector, highVector));
+
+        uint64_t bits = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(result)));
+
+        if constexpr (isNegated)
+            bits ^= 0xFF;
+
+        selection[i / 64] |= bits << (i % 64);
+    }
+
+    CompareScalar<int32_t, comparison, isNegated>(values, i, size, low, high, selection);
+}
+
+template<KernelComparison comparison, bool isNegated>
+FILTER_KERNELS_TARGET("avx2") static void CompareAvx2(const int64_t *values, const size_t &size, const int64_t &low, const int64_t &high, uint64_t *selection)
+{
+    const __m256i lowVector = _mm256_set1_epi64x(low);
+    const __m256i highVector = _mm256_set1_epi64x(high);
+
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4)
+    {
+        const __m256i valueVector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+
+        __m256i result;
+
+        if constexpr (comparison == KernelComparison::EQUAL)
+            result = _mm256_cmpeq_epi64(valueVector, lowVector);
+        else if constexpr (comparison == KernelComparison::GREATER)
+            result = _mm256_cmpgt_epi64(valueVector, lowVector);
+        else if constexpr (comparison == KernelComparison::LESS)
+            result = _mm256_cmpgt_epi64(lowVector, valueVector);
+        else
+            result = _mm256_or_si256(_mm256_cmpgt_epi64(lowVector, valueVector), _mm256_cmpgt_epi64(valueVector, highVector));
+
+        uint64_t bits = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(result)));
+
+        if constexpr (isNegated)
+            bits ^= 0xF;
+
+        selection[i / 64] |= bits << (i % 64);
+    }
+
+    CompareScalar<int64_t, comparison, isNegated>(values, i, size, low, high, selection);
+}
+
+template<KernelComparison comparison, bool isNegated>
+FILTER_KERNELS_TARGET("sse4.2") static void CompareSse42(const int32_t *values, const size_t &size, const int32_t &low, const int32_t &high, uint64_t *selection)
+{
+    const __m128i lowVector = _mm_set1_epi32(low);
+    const __m128i highVector = _mm_set1_epi32(high);
+
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4)
+    {
+        const __m128i valueVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+
+        __m128i result;
+
+        if constexpr (comparison == KernelComparison::EQUAL)
+            result = _mm_cmpeq_epi32(valueVector, lowVector);
+        else if constexpr (comparison == KernelComparison::GREATER)
+            result = _mm_cmpgt_epi32(valueVector, lowVector);
+        else if constexpr (comparison == KernelComparison::LESS)
+            result = _mm_cmpgt_epi32(lowVector, valueVector);
+        else
+            result = _mm_or_si128(_mm_cmpgt_epi32(lowVector, valueVector), _mm_cmpgt_epi32(valueVector, highVector));
+
+        uint64_t bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(result)));
+
+        if constexpr (isNegated)
+            bits ^= 0xF;
+
+        selection[i / 64] |= bits << (i % 64);
+    }
+
+    CompareScalar<int32_t, comparison, isNegated>(values, i, size, low, high, selection);
+}
+
+// _mm_cmpgt_epi64 is the sse4.2 instruction the level is named after
+template<KernelComparison comparison, bool isNegated>
+FILTER_KERNELS_TARGET("sse4.2") static void CompareSse42(const int64_t *values, const size_t &size, const int64_t &low, const int64_t &high, uint64_t *selection)
+{
+    const __m128i lowVector = _mm_set1_epi64x(low);
+    const __m128i highVector = _mm_set1_epi64x(high);
+
+    size_t i = 0;
+
+    for (; i + 2 <= size; i += 2)
+    {
+        const __m128i valueVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+
+        __m128i result;
+
+        if constexpr (comparison == KernelComparison::EQUAL)
+            result = _mm_cmpeq_epi64(valueVector, lowVector);
+        else if constexpr (comparison == KernelComparison::GREATER)
+            result = _mm_cmpgt_epi64(valueVector, lowVector);
+        else if constexpr (comparison == KernelComparison::LESS)
+            result = _mm_cmpgt_epi64(lowVector, valueVector);
+        else
+            result = _mm_or_si128(_mm_cmpgt_epi64(lowVector, valueVector), _mm_cmpgt_epi64(valueVector, highVector));
+
+        uint64_t bits = static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(result)));
+
+        if constexpr (isNegated)
+            bits ^= 0x3;
+
+        selection[i / 64] |= bits << (i % 64);
+    }
+
+    CompareScalar<int64_t, comparison, isNegated>(values, i, size, low, high, selection);
+}
+
+FILTER_KERNELS_TARGET("avx2") static size_t ClearNullsAvx2(const uint8_t *nulls, const size_t &size, uint64_t *selection)
+{
+    const __m256i zeroVector = _mm256_setzero_si256();
+
+    size_t i = 0;
+
+    for (; i + 32 <= size; i += 32)
+    {
+        const __m256i nullVector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(nulls + i));
+        const uint64_t nullBits = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(nullVector, zeroVector))) & 0xFFFFFFFFull;
+
+        selection[i / 64] &= ~(nullBits << (i % 64));
+    }
+
+    return i;
+}
+
+FILTER_KERNELS_TARGET("sse4.2") static size_t ClearNullsSse42(const uint8_t *nulls, const size_t &size, uint64_t *selection)
+{
+    const __m128i zeroVector = _mm_setzero_si128();
+
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i nullVector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(nulls + i));
+        const uint64_t nullBits = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(nullVector, zeroVector))) & 0xFFFFull;
+
+        selection[i / 64] &= ~(nullBits << (i % 64));
+    }
+
+    return i;
+}
+#endif
+
+template<typename T, KernelComparison comparison, bool isNegated>
+static void RunKernel(const T *values, const size_t &size, const T &low, const T &high, uint64_t *selection)
+{
+    memset(selection, 0, (size + 63) / 64 * sizeof(uint64_t));
+
+#ifdef FILTER_KERNELS_X86_SUPPORTED
+    switch (kernelLevel.load(memory_order_relaxed))
+    {
+        case FilterKernelLevel::AVX2:
+            CompareAvx2<comparison, isNegated>(values, size, low, high, selection);
+            return;
+        case FilterKernelLevel::SSE42:
+            CompareSse42<comparison, isNegated>(values, size, low, high, selection);
+            return;
+        default:
+            break;
+    }
+#endif
+
+    CompareScalar<T, comparison, isNegated>(values, 0, size, low, high, selection);
+}
+
+template<typename T>
+static void CompareByOperator(const T *values, const size_t &size, const Operator &operatorType, const T &constant, uint64_t *selection)
+{
+    switch (operatorType)
+    {
+        case OperatorNone:
+        case Equal:
+            RunKernel<T, KernelComparison::EQUAL, false>(values, size, constant, constant, selection);
+            break;
+        case NotEqual:
+            RunKernel<T, KernelComparison::EQUAL, true>(values, size, constant, constant, selection);
+            break;
+        case GreaterThan:
+            RunKernel<T, KernelComparison::GREATER, false>(values, size, constant, constant, selection);
+            break;
+        case LessOrEqual:
+            RunKernel<T, KernelComparison::GREATER, true>(values, size, constant, constant, selection);
+            break;
+        case LessThan:
+            RunKernel<T, KernelComparison::LESS, false>(values, size, constant, constant, selection);
+            break;
+        case GreaterOrEqual:
+            RunKernel<T, KernelComparison::LESS, true>(values, size, constant, constant, selection);
+            break;
+        default:
+            throw invalid_argument("FilterKernels::Compare: Unsupported operator");
+    }
+}
+
+void FilterKernels::Compare(const int32_t *values, const size_t &size, const Operator &operatorType, const int32_t &constant, uint64_t *selection)
+{
+    CompareByOperator(values, size, operatorType, constant, selection);
+}
+
+void FilterKernels::Compare(const int64_t *values, const size_t &size, const Operator &operatorType, const int64_t &constant, uint64_t *selection)
+{
+    CompareByOperator(values, size, operatorType, constant, selection);
+}
+
+void FilterKernels::Between(const int32_t *values, const size_t &size, const int32_t &low, const int32_t &high, uint64_t *selection)
+{
+    RunKernel<int32_t, KernelComparison::OUTSIDE, true>(values, size, low, high, selection);
+}
+
+void FilterKernels::Between(const int64_t *values, const size_t &size, const int64_t &low, const int64_t &high, uint64_t *selection)
+{
+    RunKernel<int64_t, KernelComparison::OUTSIDE, true>(values, size, low, high, selection);
+}
+
+void FilterKernels::ClearNulls(const uint8_t *nulls, const size_t &size, uint64_t *selection)
+{
+    size_t i = 0;
+
+#ifdef FILTER_KERNELS_X86_SUPPORTED
+    switch (kernelLevel.load(memory_order_relaxed))
+    {
+        case FilterKernelLevel::AVX2:
+            i = ClearNullsAvx2(nulls, size, selection);
+            break;
+        case FilterKernelLevel::SSE42:
+            i = ClearNullsSse42(nulls, size, selection);
+            break;
+        default:
+            break;
+    }
+#endif
+
+    for (; i < size; i++)
+        selection[i / 64] &= ~(static_cast<uint64_t>(nulls[i] != 0) << (i % 64));
+}
+
+FilterKernelLevel FilterKernels::GetSupportedKernelLevel() { return supportedKernelLevel; }
+
+FilterKernelLevel FilterKernels::GetKernelLevel() { return kernelLevel.load(memory_order_relaxed); }
+
+void FilterKernels::SetKernelLevel(const FilterKernelLevel &level)
+{
+    kernelLevel.store(min(level, supportedKernelLevel), memory_order_relaxed);
+}
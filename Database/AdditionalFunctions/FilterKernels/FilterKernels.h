@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "../../Constants.h"
+
+#if (defined(__x86_64__) || defined(_M_X64)) && __has_include(<immintrin.h>)
+#define FILTER_KERNELS_X86_SUPPORTED
+#endif
+
+using namespace std;
+
+// instruction set the kernels run with, picked once from CPUID, every level also has the ones below it
+enum class FilterKernelLevel : uint8_t
+{
+    SCALAR = 0,
+    SSE42 = 1,
+    AVX2 = 2
+};
+
+// comparisons of contiguous fixed width column values against constants, bit i of the selection is set when value i satisfies it
+// a selection holds (size + 63) / 64 words and is overwritten, the bits past size are left unset
+class FilterKernels {
+    public:
+        static void Compare(const int32_t *values, const size_t &size, const Constants::Operator &operatorType, const int32_t &constant, uint64_t *selection);
+        static void Compare(const int64_t *values, const size_t &size, const Constants::Operator &operatorType, const int64_t &constant, uint64_t *selection);
+
+        // low <= value <= high
+        static void Between(const int32_t *values, const size_t &size, const int32_t &low, const int32_t &high, uint64_t *selection);
+        static void Between(const int64_t *values, const size_t &size, const int64_t &low, const int64_t &high, uint64_t *selection);
+
+        // unsets the bits of the values whose null flag is set
+        static void ClearNulls(const uint8_t *nulls, const size_t &size, uint64_t *selection);
+
+        [[nodiscard]] static FilterKernelLevel GetSupportedKernelLevel();
+        [[nodiscard]] static FilterKernelLevel GetKernelLevel();
+        // anything above the supported level is lowered to it, used to compare the levels against each other
+        static void SetKernelLevel(const FilterKernelLevel &kernelLevel);
+};
@@ -1,5 +1,6 @@
 #include "MergeSort.h"
 #include "../../../Row/Row.h"
+#include "../../../../AdditionalLibraries/ThreadPool/ThreadPool.h"
 #include "../../SortingFunctions.h"
 
 using namespace DatabaseEngine::StorageTypes;
@@ -60,9 +61,21 @@ void MergeSort::Sort(vector<Row*> &rows, const int &left, const int &right, cons
     // Calculate the midpoint
     const int mid = left + (right - left) / 2;
 
-    // Sort first and second halves
-    MergeSort::Sort(rows, left, mid, sortConditions);
-    MergeSort::Sort(rows, mid + 1, right, sortConditions);
+    // Sort first and second halves, big ranges hand the first half to the pool and sort the second one meanwhile
+    if (static_cast<size_t>(right - left + 1) >= PARALLEL_SORT_MIN_ROWS)
+    {
+        Threading::TaskGroup leftHalfTask;
+        leftHalfTask.Run([&rows, left, mid, &sortConditions] { MergeSort::Sort(rows, left, mid, sortConditions); });
+
+        MergeSort::Sort(rows, mid + 1, right, sortConditions);
+
+        leftHalfTask.Wait();
+    }
+    else
+    {
+        MergeSort::Sort(rows, left, mid, sortConditions);
+        MergeSort::Sort(rows, mid + 1, right, sortConditions);
+    }
 
     // Merge the sorted halves
     MergeSort::Merge(rows, left, mid, right, sortConditions);
@@ -23,11 +23,12 @@ typedef struct AggregateResults {
 } AggregateResults;
 
 class SortingFunctions{
-         [[nodiscard]] static int CompareBlockByDataType(const DatabaseEngine::StorageTypes::Block*& firstBlock, const DatabaseEngine::StorageTypes::Block*& secondBlock);
-         [[nodiscard]] static string CreateGroupByKey(const DatabaseEngine::StorageTypes::Row* row, const vector<GroupCondition> &sortConditions);
          static long double ApplyAggregateFunctionToGroup(const vector<DatabaseEngine::StorageTypes::Row*>& rowGroup, const GroupCondition& condition);
 
     public:
+         // 1 if the first block is the smaller one, -1 if it is the bigger one, 0 if they are equal
+         [[nodiscard]] static int CompareBlockByDataType(const DatabaseEngine::StorageTypes::Block*& firstBlock, const DatabaseEngine::StorageTypes::Block*& secondBlock);
+         [[nodiscard]] static string CreateGroupByKey(const DatabaseEngine::StorageTypes::Row* row, const vector<GroupCondition> &sortConditions);
          [[nodiscard]] static bool CompareRows(const DatabaseEngine::StorageTypes::Row* firstRow, const DatabaseEngine::StorageTypes::Row* secondRow, const vector<SortCondition>& sortConditions);
          [[nodiscard]] static bool CompareRowsAscending(const DatabaseEngine::StorageTypes::Row* firstRow, const DatabaseEngine::StorageTypes::Row* secondRow, const column_index_t& columnIndex);
          [[nodiscard]] static bool CompareRowsDescending(const DatabaseEngine::StorageTypes::Row* firstRow, const DatabaseEngine::StorageTypes::Row* secondRow, const column_index_t& columnIndex);
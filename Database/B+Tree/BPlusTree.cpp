@@ -165,36 +165,42 @@ namespace Indexing
         this->database->SplitNodeFromIndexPage(tableId, newChild, nonClusteredIndexId);
     }
 
-    Node *BPlusTree::FindAppropriateNodeForInsert(const Key &key, int *indexPosition)
+    Node *BPlusTree::FindAppropriateNodeForInsert(const Key &key, int *indexPosition, PageGuard<IndexPage> &nodePage)
     {
         if (this->root == nullptr)
         {
             //maybe root page is removed and need to be reopened
             this->root = new Node(true, true, this->type == TreeType::Clustered);
-            this->InsertNodeToPage(this->root, 0);
+            this->rootPage = this->InsertNodeToPage(this->root, 0);
         }
 
         if (root->keys.size() == 2 * t - 1) // root is full,
         {
+            // the old root is split below, its page stays pinned until then
+            PageGuard<IndexPage> previousRootPage = std::move(this->rootPage);
+
             // create new root
             Node *newRoot = new Node(false, true, this->type == TreeType::Clustered);
-            this->InsertNodeToPage(newRoot, root->header.pageId);
+            this->rootPage = this->InsertNodeToPage(newRoot, root->header.pageId);
 
             // add current root as leaf
             newRoot->childrenHeaders.push_back(this->root->header);
             this->root->isRoot = false;
 
-            // split the root
+            // split the root, the new root page is pinned again by Database::UpdateTableIndexes if it moves
             this->SplitChild(newRoot, 0, this->root);
 
             // root is the newRoot
             root = newRoot;
         }
 
-        return this->GetNonFullNode(root, key, indexPosition);
+        // the root is pinned through rootPage
+        nodePage.Release();
+
+        return this->GetNonFullNode(root, key, indexPosition, nodePage);
     }
 
-    Node *BPlusTree::GetNonFullNode(Node *node, const Key &key, int *indexPosition)
+    Node *BPlusTree::GetNonFullNode(Node *node, const Key &key, int *indexPosition, PageGuard<IndexPage> &nodePage)
     {
         if (node->isLeaf)
         {
@@ -223,17 +229,27 @@ namespace Indexing
         const auto iterator = ranges::lower_bound(node->keys, key);
 
         int childIndex = iterator - node->keys.begin();
-        Node *child = this->GetNodeFromPage(node->childrenHeaders[childIndex]);
+
+        PageGuard<IndexPage> childPage;
+        Node *child = this->GetNodeFromPage(node->childrenHeaders[childIndex], childPage);
 
         if (child->keys.size() == 2 * t - 1)
         {
             SplitChild(node, childIndex, child);
 
+            // the split may have moved the node to another page
+            if (nodePage && nodePage->GetPageId() != node->header.pageId)
+                nodePage = StorageManager::Get().GetIndexPage(node->header.pageId);
+
             if (key > node->keys[childIndex])
                 childIndex++;
         }
 
-        return GetNonFullNode(this->GetNodeFromPage(node->childrenHeaders[childIndex]), key, indexPosition);
+        child = this->GetNodeFromPage(node->childrenHeaders[childIndex], childPage);
+
+        nodePage = std::move(childPage);
+
+        return GetNonFullNode(child, key, indexPosition, nodePage);
     }
 
     void BPlusTree::DeleteNode(const Node *node)
@@ -258,7 +274,9 @@ namespace Indexing
         if (!root)
             return;
 
-        Node *currentNode = this->SearchLeftMostLeafNode();
+        PageGuard<IndexPage> currentPage, previousPage;
+
+        Node *currentNode = this->SearchLeftMostLeafNode(currentPage);
         const Node *previousNode = nullptr;
 
         while (currentNode)
@@ -286,8 +304,12 @@ namespace Indexing
             if(currentNode->nextNodeHeader.pageId == 0)
                 return;
 
+            // the scan spans more than one leaf, read the following leaves ahead of it
+            StorageManager::Get().PrefetchIndexLeaves(currentNode->nextNodeHeader.pageId, currentNode->nextNodeHeader.indexPosition, this->table);
+
             previousNode = currentNode;
-            currentNode = this->GetNodeFromPage(currentNode->nextNodeHeader);
+            previousPage = std::move(currentPage);
+            currentNode = this->GetNodeFromPage(currentNode->nextNodeHeader, currentPage);
         }
     }
 
@@ -296,7 +318,9 @@ namespace Indexing
         if (!root)
             return;
 
-        Node *currentNode = this->SearchKey(minKey);
+        PageGuard<IndexPage> currentPage, previousPage;
+
+        Node *currentNode = this->SearchKey(minKey, currentPage);
         const Node *previousNode = nullptr;
 
         while (currentNode)
@@ -324,8 +348,12 @@ namespace Indexing
             if(currentNode->nextNodeHeader.pageId == 0)
                 return;
 
+            // the scan spans more than one leaf, read the following leaves ahead of it
+            StorageManager::Get().PrefetchIndexLeaves(currentNode->nextNodeHeader.pageId, currentNode->nextNodeHeader.indexPosition, this->table);
+
             previousNode = currentNode;
-            currentNode = this->GetNodeFromPage(currentNode->nextNodeHeader);
+            previousPage = std::move(currentPage);
+            currentNode = this->GetNodeFromPage(currentNode->nextNodeHeader, currentPage);
         }
     }
 
@@ -334,7 +362,9 @@ namespace Indexing
         if (!root)
             return;
 
-        const Node *currentNode = this->SearchKey(minKey);
+        PageGuard<IndexPage> currentPage, previousPage;
+
+        const Node *currentNode = this->SearchKey(minKey, currentPage);
         const Node *previousNode = nullptr;
 
         while (currentNode)
@@ -362,8 +392,12 @@ namespace Indexing
             if(currentNode->nextNodeHeader.pageId == 0)
                 return;
 
+            // the scan spans more than one leaf, read the following leaves ahead of it
+            StorageManager::Get().PrefetchIndexLeaves(currentNode->nextNodeHeader.pageId, currentNode->nextNodeHeader.indexPosition, this->table);
+
             previousNode = currentNode;
-            currentNode = this->GetNodeFromPage(currentNode->nextNodeHeader);
+            previousPage = std::move(currentPage);
+            currentNode = this->GetNodeFromPage(currentNode->nextNodeHeader, currentPage);
         }
     }
 
@@ -372,16 +406,9 @@ namespace Indexing
         if (!root)
             return;
 
-        Node *currentNode = root;
+        PageGuard<IndexPage> currentPage, previousPage;
 
-        while (!currentNode->isLeaf)
-        {
-            const auto iterator = ranges::lower_bound(currentNode->keys, key);
-
-            const int index = iterator - currentNode->keys.begin();
-
-            currentNode = this->GetNodeFromPage(currentNode->childrenHeaders[index]);
-        }
+        Node *currentNode = this->SearchKey(key, currentPage);
 
         const Node *previousNode = nullptr;
         while (currentNode)
@@ -404,8 +431,12 @@ namespace Indexing
                 }
             }
 
+            if(currentNode->nextNodeHeader.pageId == 0)
+                return;
+
             previousNode = currentNode;
-            currentNode = this->GetNodeFromPage(currentNode->nextNodeHeader);
+            previousPage = std::move(currentPage);
+            currentNode = this->GetNodeFromPage(currentNode->nextNodeHeader, currentPage);
         }
     }
 
@@ -420,13 +451,19 @@ namespace Indexing
 
     Node*& BPlusTree::GetRoot() { return this->root; }
 
-    void BPlusTree::SetRoot(Node *&node) { this->root = node; }
+    void BPlusTree::SetRoot(Node *&node, PageGuard<IndexPage> rootPage)
+    {
+        this->root = node;
+        this->rootPage = std::move(rootPage);
+    }
+
+    void BPlusTree::SetRootPage(PageGuard<IndexPage> rootPage) { this->rootPage = std::move(rootPage); }
 
     void BPlusTree::SetBranchingFactor(const int &branchingFactor) { this->t = branchingFactor; }
 
     const int &BPlusTree::GetBranchingFactor() const { return this->t; }
 
-    void BPlusTree::WriteTreeHeaderToFile(fstream *filePtr) const
+    void BPlusTree::WriteTreeHeaderToFile(ostream *filePtr) const
     {
         filePtr->write(reinterpret_cast<const char *>(&this->t), sizeof(int));
         filePtr->write(reinterpret_cast<const char *>(&this->tableId), sizeof(table_id_t));
@@ -436,7 +473,12 @@ namespace Indexing
 
     void BPlusTree::UpdateRowData(const Key& key, const BPlusTreeNonClusteredData& data) const
     {
-        Node* currentNode = this->SearchKey(key);
+        if (!root)
+            return;
+
+        PageGuard<IndexPage> currentPage, previousPage;
+
+        Node* currentNode = this->SearchKey(key, currentPage);
 
         if(currentNode == nullptr)
             return;
@@ -459,14 +501,18 @@ namespace Indexing
                 }
             }
 
+            if(currentNode->nextNodeHeader.pageId == 0)
+                return;
+
             previousNode = currentNode;
-            currentNode = this->GetNodeFromPage(currentNode->nextNodeHeader);
+            previousPage = std::move(currentPage);
+            currentNode = this->GetNodeFromPage(currentNode->nextNodeHeader, currentPage);
         }
     }
 
     const page_id_t & BPlusTree::GetFirstIndexPageId() const { return this->firstIndexPageId; }
 
-    void BPlusTree::ReadTreeHeaderFromFile(const vector<char> &data, page_offset_t &offSet)
+    void BPlusTree::ReadTreeHeaderFromFile(const span<const char> &data, page_offset_t &offSet)
     {
         memcpy(&this->t, data.data() + offSet, sizeof(int));
         offSet += sizeof(int);
@@ -490,7 +536,7 @@ namespace Indexing
         //    GetNodeSize(child, size);
     }
 
-    Node *BPlusTree::SearchKey(const Key &key) const
+    Node *BPlusTree::SearchKey(const Key &key, PageGuard<IndexPage> &nodePage) const
     {
         Node *currentNode = root;
 
@@ -500,25 +546,25 @@ namespace Indexing
 
             const int index = iterator - currentNode->keys.begin();
 
-           currentNode = this->GetNodeFromPage(currentNode->childrenHeaders[index]);
+           currentNode = this->GetNodeFromPage(currentNode->childrenHeaders[index], nodePage);
         }
 
         return currentNode;
     }
 
-    Node *BPlusTree::SearchLeftMostLeafNode() const
+    Node *BPlusTree::SearchLeftMostLeafNode(PageGuard<IndexPage> &nodePage) const
     {
         Node *currentNode = root;
         
         while (!currentNode->isLeaf)
-            currentNode = this->GetNodeFromPage(currentNode->childrenHeaders[0]);
+            currentNode = this->GetNodeFromPage(currentNode->childrenHeaders[0], nodePage);
 
         return currentNode;
     }
 
-    void BPlusTree::InsertNodeToPage(Node*& node, const page_id_t& parentPageId)
+    PageGuard<IndexPage> BPlusTree::InsertNodeToPage(Node*& node, const page_id_t& parentPageId)
     {
-        IndexPage* indexPage = parentPageId == 0 
+        PageGuard<IndexPage> indexPage = parentPageId == 0 
                                 ? this->database->FindOrAllocateNextIndexPage(this->tableId, parentPageId, node->currentNodeSize, this->nonClusteredIndexId)
                                 : StorageManager::Get().GetIndexPage(parentPageId);
 
@@ -527,15 +573,20 @@ namespace Indexing
         node->header.pageId = indexPage->GetPageId();
         
         this->firstIndexPageId = root->header.pageId;
+
+        return indexPage;
     }
 
-    Node* BPlusTree::GetNodeFromPage(const NodeHeader & header) const
+    Node* BPlusTree::GetNodeFromPage(const NodeHeader & header, PageGuard<IndexPage> &nodePage) const
     {
         const extent_id_t extentId = DatabaseEngine::Database::CalculateExtentIdByPageId(header.pageId);
 
-        const IndexPage* indexPage = StorageManager::Get().GetIndexPage(header.pageId, extentId, this->table);
+        // pinned before the previous page is let go, nodes of that page may still be read by the caller
+        PageGuard<IndexPage> indexPage = StorageManager::Get().GetIndexPage(header.pageId, extentId, this->table);
+
+        nodePage = std::move(indexPage);
 
-        return indexPage->GetNodeByIndex(header.indexPosition);
+        return nodePage->GetNodeByIndex(header.indexPosition);
     }
 
     void BPlusTree::PrintTree(const Node *node, const int &level)
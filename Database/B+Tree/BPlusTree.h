@@ -1,9 +1,11 @@
 ﻿#pragma once
 #include <vector>
+#include <span>
 #include "../../Database/Constants.h"
 #include <fstream>
 
 #include "../Column/Column.h"
+#include "../Storage/PageGuard/PageGuard.h"
 
 using namespace std;
 using namespace Constants;
@@ -119,6 +121,8 @@ namespace Indexing
         page_id_t firstIndexPageId;
         int t;
         Node *root;
+        // the page holding the root stays pinned while the tree points at the root
+        Storage::PageGuard<Pages::IndexPage> rootPage;
         TreeType type;
         int nonClusteredIndexId;
         DatabaseEngine::Database* database;
@@ -126,13 +130,14 @@ namespace Indexing
 
         void SplitChild(Node *parent, const int &index, Node *child);
         void PrintTree(const Node *node, const int &level);
-        Node *GetNonFullNode(Node *node, const Key &key, int *indexPosition);
+        Node *GetNonFullNode(Node *node, const Key &key, int *indexPosition, Storage::PageGuard<Pages::IndexPage> &nodePage);
         void DeleteNode(const Node *node);
-        [[nodiscard]] Node *SearchKey(const Key &key) const;
-        [[nodiscard]] Node* SearchLeftMostLeafNode() const;
-        void InsertNodeToPage(Node*& node, const page_id_t& parentPageId);
+        [[nodiscard]] Node *SearchKey(const Key &key, Storage::PageGuard<Pages::IndexPage> &nodePage) const;
+        [[nodiscard]] Node* SearchLeftMostLeafNode(Storage::PageGuard<Pages::IndexPage> &nodePage) const;
+        Storage::PageGuard<Pages::IndexPage> InsertNodeToPage(Node*& node, const page_id_t& parentPageId);
 
-        [[nodiscard]] Node* GetNodeFromPage(const NodeHeader& header) const;
+        // nodePage is moved to the page of the node, the node is only valid while nodePage is held
+        [[nodiscard]] Node* GetNodeFromPage(const NodeHeader& header, Storage::PageGuard<Pages::IndexPage> &nodePage) const;
         static int CalculateTreeDegree(const DatabaseEngine::StorageTypes::Table* table, const TreeType& treeType, const int& nonClusteredIndexId);
 
     public:
@@ -140,7 +145,8 @@ namespace Indexing
         BPlusTree();
         ~BPlusTree();
 
-        Node *FindAppropriateNodeForInsert(const Key &key, int *indexPosition);
+        // nodePage keeps the page of the returned leaf pinned, the leaf is only valid while it is held
+        Node *FindAppropriateNodeForInsert(const Key &key, int *indexPosition, Storage::PageGuard<Pages::IndexPage> &nodePage);
         void PrintTree();
 
         void RangeQuery(const Key &minKey, const Key &maxKey, vector<QueryData> &result) const;
@@ -151,15 +157,18 @@ namespace Indexing
 
         Node*& GetRoot();
 
-        void SetRoot(Node *&node);
+        void SetRoot(Node *&node, Storage::PageGuard<Pages::IndexPage> rootPage);
+
+        // called when the root node is moved to another page
+        void SetRootPage(Storage::PageGuard<Pages::IndexPage> rootPage);
 
         void SetBranchingFactor(const int &branchingFactor);
 
         [[nodiscard]] const int &GetBranchingFactor() const;
 
-        void WriteTreeHeaderToFile(fstream *filePtr) const;
+        void WriteTreeHeaderToFile(ostream *filePtr) const;
 
-        void ReadTreeHeaderFromFile(const vector<char> &data, page_offset_t &offSet);
+        void ReadTreeHeaderFromFile(const span<const char> &data, page_offset_t &offSet);
 
         void GetNodeSize(const Node *node, page_size_t &size) const;
 
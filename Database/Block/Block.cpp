@@ -4,10 +4,12 @@
 
 namespace DatabaseEngine::StorageTypes {
     
-    Block::Block(const void* data, const block_size_t& size, const Column* column)
+    Block::Block(const void* data, const block_size_t& size, const Column* column, Arenas::MonotonicArena* arena)
     {
         this->size = size;
         this->column = column;
+        this->arena = arena;
+        this->data = nullptr;
         this->SetData(data, size);
     }
 
@@ -16,16 +18,39 @@ namespace DatabaseEngine::StorageTypes {
         this->size = 0;
         this->column = column;
         this->data = nullptr;
+        this->arena = nullptr;
         // this->SetData(data, size);
     }
 
-    Block::Block(const Block *block)
+    Block::Block(const Block *block, Arenas::MonotonicArena* arena)
     {
         this->size = block->size;
         this->column = block->column;
+        this->arena = arena;
+        this->data = nullptr;
         this->SetData(block->data, block->size);
     }
 
+    Block::Block(const Block& block) : Block(&block) { }
+
+    Block::Block(Block&& block) noexcept
+    {
+        this->size = block.size;
+        this->column = block.column;
+        this->arena = block.arena;
+        this->data = block.data;
+
+        // inline values have to follow the block, everything else changes hands
+        if (block.IsDataInline())
+        {
+            memcpy(this->inlineData, block.inlineData, block.size);
+            this->data = this->inlineData;
+        }
+
+        block.data = nullptr;
+        block.size = 0;
+    }
+
     // Block::Block(Column* column)
     // {
     //     this->data = nullptr;
@@ -35,24 +60,55 @@ namespace DatabaseEngine::StorageTypes {
 
     Block::~Block()
     {
-        delete[] this->data;
+        this->ReleaseData();
 
         this->data = nullptr;
     }
 
+    bool Block::IsDataInline() const { return this->data == this->inlineData; }
+
+    void Block::ReleaseData()
+    {
+        if (this->arena == nullptr && !this->IsDataInline())
+            delete[] this->data;
+    }
+
     void Block::SetData(const void* inputData, const block_size_t& inputSize)
     {
         if (inputData == nullptr)
         {
+            this->ReleaseData();
+
             this->data = nullptr;
             this->size = 0;
 
             return;
         }
 
-        this->data = new object_t[inputSize];
-        memcpy(this->data, inputData, inputSize);
+        // the input may be this block's own data, it is copied before the old data goes
+        if (inputSize <= INLINE_BLOCK_SIZE)
+        {
+            object_t inputBytes[INLINE_BLOCK_SIZE];
+            memcpy(inputBytes, inputData, inputSize);
+
+            this->ReleaseData();
+
+            memcpy(this->inlineData, inputBytes, inputSize);
+
+            this->data = this->inlineData;
+            this->size = inputSize;
+
+            return;
+        }
+
+        object_t* newData = (this->arena != nullptr)
+                            ? static_cast<object_t*>(this->arena->allocate(inputSize, alignof(uint64_t)))
+                            : new object_t[inputSize];
+        memcpy(newData, inputData, inputSize);
+
+        this->ReleaseData();
 
+        this->data = newData;
         this->size = inputSize;
     }
 
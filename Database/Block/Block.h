@@ -2,6 +2,7 @@
 #include <iostream>
 #include <ostream>
 #include "../Constants.h"
+#include "../../AdditionalLibraries/MonotonicArena/MonotonicArena.h"
 
 using namespace std;
 using namespace Constants;
@@ -14,17 +15,31 @@ namespace DatabaseEngine::StorageTypes {
     class Column;
     enum class ColumnType : uint8_t;
     
-    class Block {
+    class Block : public Arenas::ArenaObject {
         object_t* data;
         block_size_t size;
         const Column* column;
+        // data is carved from it when set, nullptr keeps it on the heap
+        Arenas::MonotonicArena* arena;
+        // data points here for values of at most INLINE_BLOCK_SIZE bytes
+        alignas(uint64_t) object_t inlineData[INLINE_BLOCK_SIZE];
+
+    protected:
+        [[nodiscard]] bool IsDataInline() const;
+        void ReleaseData();
 
     public:
         explicit Block(const Column* column);
 
-        explicit Block(const Block* block);
+        explicit Block(const Block* block, Arenas::MonotonicArena* arena = nullptr);
+
+        Block(const void* data, const block_size_t& size, const Column* column, Arenas::MonotonicArena* arena = nullptr);
+
+        Block(Block&& block) noexcept;
+
+        Block(const Block& block);
 
-        Block(const void* data, const block_size_t& size, const Column* column);
+        Block& operator=(const Block& block) = delete;
 
         ~Block();
 
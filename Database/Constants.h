@@ -5,12 +5,47 @@
 namespace Constants
 {
     constexpr size_t PAGE_SIZE = 8 * 1024;
-    constexpr size_t MAX_NUMBER_OF_PAGES = 15000;
-    constexpr size_t MAX_NUMBER_SYSTEM_PAGES = 100000;
+    // default byte budget of the data page pool, the system page pool gets SYSTEM_POOL_RATIO times as much
+    constexpr size_t DATA_POOL_BYTES = 15000 * PAGE_SIZE;
+    constexpr double SYSTEM_POOL_RATIO = 100000.0 / 15000.0;
+    constexpr size_t BUFFER_POOL_SHARDS = 16;
+    constexpr int PAGE_LOAD_ATTEMPTS = 3;
+    constexpr uint32_t FLUSH_INTERVAL_MS = 100;
+    constexpr double FLUSH_DIRTY_RATIO = 0.1;
+    constexpr double MAX_DIRTY_RATIO = 0.5;
+    constexpr size_t FLUSH_BATCH_SIZE = 256;
+    constexpr size_t PREFETCH_DEPTH = 4;
+    constexpr size_t PREFETCH_QUEUE_SIZE = 64;
+    constexpr uint32_t IO_URING_QUEUE_DEPTH = 64;
+    constexpr size_t DIRECT_IO_ALIGNMENT = 4 * 1024;
+    constexpr size_t DIRECT_IO_FRAMES = 256;
+    constexpr size_t LATENCY_HISTOGRAM_BUCKETS = 24;
+    constexpr size_t METADATA_REGION_SLOTS = 1024;
     constexpr size_t EXTENT_SIZE = 8;
     constexpr size_t EXTENT_BYTE_SIZE = EXTENT_SIZE * PAGE_SIZE;
+    // longest run of consecutive dirty pages written with one call, an extent and its neighbour
+    constexpr size_t WRITE_COALESCE_PAGES = 2 * EXTENT_SIZE;
     constexpr size_t EXTENT_BIT_MAP_SIZE = 64000;
     constexpr size_t LARGE_DATA_OBJECT_SIZE = 1024;
+    // follows the header of data pages that carry a slot directory, older pages start their first row there
+    constexpr uint32_t SLOTTED_PAGE_MAGIC = 0x534C5444;
+    // slotted data pages whose rows are written in the compact row format
+    constexpr uint32_t COMPACT_ROW_PAGE_MAGIC = 0x534C5432;
+    // flags byte of a compact row, a bit map is only written when one of its bits is set
+    constexpr uint8_t COMPACT_ROW_HAS_NULLS = 0x01;
+    constexpr uint8_t COMPACT_ROW_HAS_LARGE_OBJECTS = 0x02;
+    // chunk size of the arenas decoded rows and query results are carved from
+    constexpr size_t ROW_ARENA_CHUNK_SIZE = 4 * PAGE_SIZE;
+    // values up to this size (every fixed width column type) are kept inside their Block instead of being allocated
+    constexpr size_t INLINE_BLOCK_SIZE = 8;
+    // bytes of the null and large object bits a row keeps inline, wider tables fall back to the heap
+    constexpr size_t INLINE_BIT_SET_BYTES = 8;
+    // rows a RowBatch carries per column, batch operators work through them in tight loops
+    constexpr size_t BATCH_SIZE = 1024;
+    // workers of the process wide thread pool, 0 starts one per hardware thread
+    constexpr size_t WORKER_THREADS = 0;
+    // ranges smaller than this are merge sorted on the thread that reaches them instead of being handed to the pool
+    constexpr size_t PARALLEL_SORT_MIN_ROWS = 4096;
 
     // table types
     typedef uint16_t table_id_t;
@@ -85,6 +120,34 @@ namespace Constants
         Or = 2
     };
 
+    enum class ReplacementPolicyType : uint8_t
+    {
+        LRU = 0,
+        CLOCK = 1,
+        TWO_QUEUE = 2
+    };
+
+    enum class IoBackendType : uint8_t
+    {
+        FSTREAM = 0,
+        IO_URING = 1,
+        POSITIONAL = 2,
+        MEMORY_MAPPED = 3,
+        DIRECT = 4
+    };
+
+    enum class RowFormat : uint8_t
+    {
+        FIXED_HEADER = 0,
+        COMPACT = 1
+    };
+
+    enum class AccessPattern : uint8_t
+    {
+        SEQUENTIAL = 0,
+        RANDOM = 1
+    };
+
     enum TreeType : uint8_t 
     {
         Clustered = 0,
@@ -1,5 +1,6 @@
 ﻿#include "Database.h"
 #include <cstdint>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 #include "./Pages/Header/HeaderPage.h"
@@ -11,6 +12,7 @@
 #include "Table/Table.h"
 #include "Column/Column.h"
 #include "Row/Row.h"
+#include "RowPredicate/RowPredicate.h"
 #include "Pages/LargeObject/LargeDataPage.h"
 #include "Storage/StorageManager/StorageManager.h"
 #include "Block/Block.h"
@@ -36,9 +38,15 @@ namespace DatabaseEngine
             throw runtime_error("Table size exceeds limit");
     }
 
+    void Database::ValidateWriteAccess(const string &operation) const
+    {
+        if (StorageManager::Get().IsReadOnly())
+            throw runtime_error("Database::" + operation + ": Database " + this->filename + " is opened read only");
+    }
+
     void Database::WriteHeaderToFile() const
     {
-        HeaderPage *metaDataPage = StorageManager::Get().GetHeaderPage(this->filename + this->fileExtension);
+        const PageGuard<HeaderPage> metaDataPage = StorageManager::Get().GetHeaderPage(this->filename + this->fileExtension);
 
         metaDataPage->SetDbHeader(this->header);
     }
@@ -98,7 +106,7 @@ namespace DatabaseEngine
         this->filename = dbName;
         this->fileExtension = ".db";
 
-        const HeaderPage *headerPage = StorageManager::Get().GetHeaderPage(this->filename + this->fileExtension);
+        const PageGuard<HeaderPage> headerPage = StorageManager::Get().GetHeaderPage(this->filename + this->fileExtension);
 
         this->header = *headerPage->GetDatabaseHeader();
         const vector<TableFullHeader> tablesFullHeaders = headerPage->GetTablesFullHeaders();
@@ -109,8 +117,12 @@ namespace DatabaseEngine
 
     Database::~Database()
     {
-        // save db header;
-        this->WriteHeaderToFile();
+        // save db header and the allocation metadata, read only databases are left untouched
+        if (!StorageManager::Get().IsReadOnly())
+        {
+            this->WriteHeaderToFile();
+            StorageManager::Get().FlushMetadataPages();
+        }
 
         for (const auto &dbTable : this->tables)
             delete dbTable;
@@ -118,6 +130,8 @@ namespace DatabaseEngine
 
     Table *Database::CreateTable(const string &tableName, const vector<StorageTypes::Column *> &columns, const vector<column_index_t> *clusteredKeyIndexes, const vector<vector<column_index_t>> *nonClusteredIndexes)
     {
+        this->ValidateWriteAccess("CreateTable");
+
         for (const auto& table : this->tables)
         {
             if(table->GetTableName() == tableName)
@@ -160,6 +174,8 @@ namespace DatabaseEngine
 
     void Database::DeleteTable(const string& tableName)
     {
+        this->ValidateWriteAccess("DeleteTable");
+
         const Table* table = nullptr;
         vector<Table*>::iterator it;
 
@@ -216,13 +232,15 @@ namespace DatabaseEngine
         StorageManager::Get().CreateGlobalAllocationMapPage(dbName + ".db", firstGamePageId);
         StorageManager::Get().CreatePageFreeSpacePage(dbName + ".db", firstPfsPageId);
 
-        HeaderPage *headerPage = StorageManager::Get().CreateHeaderPage(dbName + ".db");
+        const PageGuard<HeaderPage> headerPage = StorageManager::Get().CreateHeaderPage(dbName + ".db");
 
         headerPage->SetDbHeader(DatabaseHeader(dbName, 0, firstPfsPageId, firstGamePageId));
     }
 
-    void UseDatabase(const string &dbName, Database **db)
+    void UseDatabase(const string &dbName, Database **db, const StorageSettings &settings)
     {
+        StorageManager::Get().Configure(settings);
+
         *db = new Database(dbName);
     }
 
@@ -252,6 +270,8 @@ namespace DatabaseEngine
 
     void Database::DeleteDatabase() const
     {
+        this->ValidateWriteAccess("DeleteDatabase");
+
         const string path = this->filename + this->fileExtension;
 
         if (remove(path.c_str()) != 0)
@@ -261,6 +281,8 @@ namespace DatabaseEngine
     //optimize for multiple inserts
     void Database::InsertRowToPage(const table_id_t &tableId, vector<extent_id_t> &allocatedExtents, extent_id_t &lastExtentIndex, Row *row)
     {
+        this->ValidateWriteAccess("InsertRowToPage");
+
         const Table* table = this->GetTable(tableId);
         page_id_t rowPageId;int rowIndexPosition;
 
@@ -281,9 +303,9 @@ namespace DatabaseEngine
             this->InsertRowToNonClusteredIndex(tableId, row, i, nonClusteredIndexes[i], nonClusteredData);
     }
 
-    Page *Database::FindOrAllocateNextDataPage(PageFreeSpacePage *&pageFreeSpacePage, const page_id_t &pageId, const page_id_t &extentFirstPageId, const extent_id_t &extentId, const Table &table, extent_id_t *nextExtentId)
+    PageGuard<Page> Database::FindOrAllocateNextDataPage(PageFreeSpacePage *&pageFreeSpacePage, const page_id_t &pageId, const page_id_t &extentFirstPageId, const extent_id_t &extentId, const Table &table, extent_id_t *nextExtentId)
     {
-        Page *nextLeafPage = nullptr;
+        PageGuard<Page> nextLeafPage;
         if (pageId < extentFirstPageId + EXTENT_SIZE - 1)
         {
             for (page_id_t nextLeafPageId = pageId + 1; nextLeafPageId < extentFirstPageId + EXTENT_SIZE; nextLeafPageId++)
@@ -332,7 +354,7 @@ namespace DatabaseEngine
 
         if (tableMapPage == nullptr)
         {
-            Page *newPage = this->CreateDataPage(table.GetTableId());
+            const PageGuard<Page> newPage = this->CreateDataPage(table.GetTableId());
             newPage->InsertRow(row, rowIndex);
             *rowPageId = newPage->GetPageId();
 
@@ -365,13 +387,13 @@ namespace DatabaseEngine
                 // find potential candidate
                 if (rowCategory <= pageSizeCategory)
                 {
-                    Page *page = StorageManager::Get().GetPage(pageId, extentId, &table);
+                    const PageGuard<Page> page = StorageManager::Get().GetPage(pageId, extentId, &table);
 
                     if (row->GetTotalRowSize() > page->GetBytesLeft())
                         continue;
 
                     page->InsertRow(row, rowIndex);
-                    pageFreeSpacePage->SetPageMetaData(page);
+                    pageFreeSpacePage->SetPageMetaData(page.Get());
 
                     *rowPageId = pageId;
                     return;
@@ -379,16 +401,22 @@ namespace DatabaseEngine
             }
         }
 
-        Page *newPage = this->CreateDataPage(table.GetTableId());
+        const PageGuard<Page> newPage = this->CreateDataPage(table.GetTableId());
         newPage->InsertRow(row, rowIndex);
         *rowPageId = newPage->GetPageId();
     }
 
     void Database::UpdateTableRows(const table_id_t &tableId, const vector<Block*> &updateBlocks, const vector<Field> *conditions)
     {
+        this->ValidateWriteAccess("UpdateTableRows");
+
         //this is update heap table rows (which should be called if no index is selected)
         const Table *table = this->GetTable(tableId);
 
+        const unique_ptr<const RowPredicate> predicate = (conditions != nullptr && !conditions->empty())
+                                                        ? make_unique<const RowPredicate>(*table, *conditions)
+                                                        : nullptr;
+
         const IndexAllocationMapPage *tableMapPage = StorageManager::Get().GetIndexAllocationMapPage(table->GetTableHeader().indexAllocationMapPageId);
 
         vector<extent_id_t> tableExtentIds;
@@ -398,8 +426,12 @@ namespace DatabaseEngine
 
         vector<Row*> rowsToBeInserted;
 
-        for (const auto &extentId : tableExtentIds)
+        for (size_t extentIndex = 0; extentIndex < tableExtentIds.size(); extentIndex++)
         {
+            const extent_id_t &extentId = tableExtentIds[extentIndex];
+
+            StorageManager::Get().PrefetchExtents(tableExtentIds, extentIndex + 1, table);
+
             const page_id_t extentFirstPageId = Database::CalculateSystemPageOffset(extentId * EXTENT_SIZE);
 
             const page_id_t pfsPageId = Database::GetPfsAssociatedPage(extentFirstPageId);
@@ -415,18 +447,25 @@ namespace DatabaseEngine
                 if (pageFreeSpacePage->GetPageType(extentPageId) != PageType::DATA)
                     break;
 
-                Page *page = StorageManager::Get().GetPage(extentPageId, extentId, table);
+                const PageGuard<Page> page = StorageManager::Get().GetPage(extentPageId, extentId, table);
+
+                // pages without a matching row are checked through their views and never decoded
+                if(predicate != nullptr && !page->HasMatchingRow(*predicate))
+                    continue;
 
                 vector<Row*>* rows = page->GetDataRowsUnsafe();
 
                 vector<Row*>::iterator it;
 
-                for(it = rows->begin(); it != rows->end(); it++)
+                for(it = rows->begin(); it != rows->end();)
                 {
                     Row* row = *it;
 
-                    if(row == nullptr)
+                    if(row == nullptr || (predicate != nullptr && !predicate->Matches(row)))
+                    {
+                        it++;
                         continue;
+                    }
 
                     RowHeader* rowHeader = row->GetHeader();
 
@@ -436,7 +475,7 @@ namespace DatabaseEngine
                     {
                         const column_index_t& columnIndex = update->GetColumnIndex();
 
-                        if(rowHeader->largeObjectBitMap->Get(columnIndex))
+                        if(rowHeader->largeObjectBitMap.Get(columnIndex))
                         {
                             //do for LOBS
 
@@ -445,10 +484,10 @@ namespace DatabaseEngine
 
                         const bool isNull = update->GetBlockData() == nullptr;
 
-                        if(rowHeader->nullBitMap->Get(columnIndex) && isNull)
+                        if(rowHeader->nullBitMap.Get(columnIndex) && isNull)
                             continue;
-                        else if(rowHeader->nullBitMap->Get(columnIndex) && !isNull)
-                            rowHeader->nullBitMap->Set(columnIndex, false);
+                        else if(rowHeader->nullBitMap.Get(columnIndex) && !isNull)
+                            rowHeader->nullBitMap.Set(columnIndex, false);
 
                         //leverage table inserts to do this better
                         Block* newBlock = new Block(update);
@@ -460,20 +499,29 @@ namespace DatabaseEngine
 
                     if(currentRowSize > page->GetBytesLeft() + rowPreviousSize)
                     {
-                        rowsToBeInserted.push_back(row);
-                        rows->erase(it);
+                        // decoded rows are carved from this page's arena, which is freed when the page is evicted,
+                        // so the row leaves the page as a heap copy that no longer depends on it
+                        rowsToBeInserted.push_back(new Row(*row));
+                        delete row;
+
+                        it = rows->erase(it);
+
+                        page->UpdatePageSize();
+                        page->UpdateBytesLeft();
+                        pageFreeSpacePage->SetPageMetaData(page.Get());
                         continue;
                     }
 
                     //it sets dirty to true
                     page->UpdateBytesLeft(rowPreviousSize, currentRowSize);
-                    pageFreeSpacePage->SetPageMetaData(page);
+                    pageFreeSpacePage->SetPageMetaData(page.Get());
+                    it++;
                 }
                 
                 if(rowsToBeInserted.empty())
                     continue;
 
-                for(it = rowsToBeInserted.begin(); it != rowsToBeInserted.end(); it++)
+                for(it = rowsToBeInserted.begin(); it != rowsToBeInserted.end();)
                 {
                     Row* row = *it;
 
@@ -481,13 +529,16 @@ namespace DatabaseEngine
                         break;
 
                     if(row->GetTotalRowSize() > page->GetBytesLeft())
+                    {
+                        it++;
                         continue;
+                    }
 
                     page->InsertRow(row);
 
-                    pageFreeSpacePage->SetPageMetaData(page);
+                    pageFreeSpacePage->SetPageMetaData(page.Get());
 
-                    rowsToBeInserted.erase(it);
+                    it = rowsToBeInserted.erase(it);
                 }
             }
         }
@@ -505,8 +556,14 @@ namespace DatabaseEngine
 
     void Database::DeleteTableRows(const table_id_t& tableId, const vector<Field>* conditions)
     {
+        this->ValidateWriteAccess("DeleteTableRows");
+
          const Table *table = this->GetTable(tableId);
 
+        const unique_ptr<const RowPredicate> predicate = (conditions != nullptr && !conditions->empty())
+                                                        ? make_unique<const RowPredicate>(*table, *conditions)
+                                                        : nullptr;
+
         const IndexAllocationMapPage *tableMapPage = StorageManager::Get().GetIndexAllocationMapPage(table->GetTableHeader().indexAllocationMapPageId);
 
         vector<extent_id_t> tableExtentIds;
@@ -516,8 +573,12 @@ namespace DatabaseEngine
 
         vector<Row*> rowsToBeInserted;
 
-        for (const auto &extentId : tableExtentIds)
+        for (size_t extentIndex = 0; extentIndex < tableExtentIds.size(); extentIndex++)
         {
+            const extent_id_t &extentId = tableExtentIds[extentIndex];
+
+            StorageManager::Get().PrefetchExtents(tableExtentIds, extentIndex + 1, table);
+
             const page_id_t extentFirstPageId = Database::CalculateSystemPageOffset(extentId * EXTENT_SIZE);
 
             const page_id_t pfsPageId = Database::GetPfsAssociatedPage(extentFirstPageId);
@@ -533,24 +594,40 @@ namespace DatabaseEngine
                 if (pageFreeSpacePage->GetPageType(extentPageId) != PageType::DATA)
                     break;
 
-                Page *page = StorageManager::Get().GetPage(extentPageId, extentId, table);
+                const PageGuard<Page> page = StorageManager::Get().GetPage(extentPageId, extentId, table);
+
+                if(predicate != nullptr && !page->HasMatchingRow(*predicate))
+                    continue;
 
                 vector<Row*>* rows = page->GetDataRowsUnsafe();
 
+                // the rows that do not match keep their order
+                size_t keptRows = 0;
+
                 for(const auto& row: *rows)
+                {
+                    if(predicate != nullptr && !predicate->Matches(row))
+                    {
+                        (*rows)[keptRows++] = row;
+                        continue;
+                    }
+
                     delete row;
+                }
 
-                rows->clear();
+                rows->resize(keptRows);
 
                 page->UpdateBytesLeft();
                 page->UpdatePageSize();
-                pageFreeSpacePage->SetPageMetaData(page);
+                pageFreeSpacePage->SetPageMetaData(page.Get());
             }
         }
     }
 
     void Database::TruncateTable(const table_id_t & tableId)
     {
+        this->ValidateWriteAccess("TruncateTable");
+
         Table *table = this->tables.at(tableId);
 
         page_id_t indexAllocationMapPageId = table->GetTableHeader().indexAllocationMapPageId;
@@ -588,8 +665,10 @@ namespace DatabaseEngine
         table->SetIndexAllocationMapPageId(0);
     }
 
-    Page *Database::CreateDataPage(const table_id_t &tableId)
+    PageGuard<Page> Database::CreateDataPage(const table_id_t &tableId)
     {
+        this->ValidateWriteAccess("CreateDataPage");
+
         PageFreeSpacePage *pageFreeSpacePage = nullptr;
         extent_id_t newExtentId = 0;
         page_id_t lowerLimit = 0, newPageId = 0;
@@ -598,13 +677,15 @@ namespace DatabaseEngine
             return nullptr;
 
         for (page_id_t pageId = lowerLimit; pageId < newPageId + EXTENT_SIZE; pageId++)
-            pageFreeSpacePage->SetPageMetaData(StorageManager::Get().CreatePage(pageId));
+            pageFreeSpacePage->SetPageMetaData(StorageManager::Get().CreatePage(pageId).Get());
 
         return StorageManager::Get().GetPage(lowerLimit, newExtentId, this->tables[tableId]);
     }
 
-    LargeDataPage *Database::CreateLargeDataPage(const table_id_t &tableId)
+    PageGuard<LargeDataPage> Database::CreateLargeDataPage(const table_id_t &tableId)
     {
+        this->ValidateWriteAccess("CreateLargeDataPage");
+
         PageFreeSpacePage *pageFreeSpacePage = nullptr;
         extent_id_t newExtentId = 0;
         page_id_t lowerLimit = 0, newPageId = 0;
@@ -613,13 +694,15 @@ namespace DatabaseEngine
             return nullptr;
 
         for (page_id_t pageId = lowerLimit; pageId < newPageId + EXTENT_SIZE; pageId++)
-            pageFreeSpacePage->SetPageMetaData(StorageManager::Get().CreateLargeDataPage(pageId));
+            pageFreeSpacePage->SetPageMetaData(StorageManager::Get().CreateLargeDataPage(pageId).Get());
 
         return StorageManager::Get().GetLargeDataPage(lowerLimit, newExtentId, this->tables[tableId]);
     }
 
-    IndexPage *Database::CreateIndexPage(const table_id_t &tableId, const page_id_t& treeId)
+    PageGuard<IndexPage> Database::CreateIndexPage(const table_id_t &tableId, const page_id_t& treeId)
     {
+        this->ValidateWriteAccess("CreateIndexPage");
+
         PageFreeSpacePage *pageFreeSpacePage = nullptr;
         extent_id_t newExtentId = 0;
         page_id_t lowerLimit = 0, newPageId = 0;
@@ -629,10 +712,10 @@ namespace DatabaseEngine
 
         for (page_id_t pageId = lowerLimit; pageId < newPageId + EXTENT_SIZE; pageId++)
         {
-            IndexPage* indexPage = StorageManager::Get().CreateIndexPage(pageId);
+            const PageGuard<IndexPage> indexPage = StorageManager::Get().CreateIndexPage(pageId);
             indexPage->SetTreeId(treeId);
             
-            pageFreeSpacePage->SetPageMetaData(indexPage);
+            pageFreeSpacePage->SetPageMetaData(indexPage.Get());
         }
 
         return StorageManager::Get().GetIndexPage(lowerLimit, newExtentId, this->tables[tableId]);
@@ -710,7 +793,7 @@ namespace DatabaseEngine
         return this->tables[tableId];
     }
 
-    LargeDataPage *Database::GetTableLastLargeDataPage(const table_id_t &tableId, const page_size_t &minObjectSize)
+    PageGuard<LargeDataPage> Database::GetTableLastLargeDataPage(const table_id_t &tableId, const page_size_t &minObjectSize)
     {
         if (tableId >= this->tables.size())
             return nullptr;
@@ -721,7 +804,7 @@ namespace DatabaseEngine
             return nullptr;
 
         const IndexAllocationMapPage *tableMapPage = StorageManager::Get().GetIndexAllocationMapPage(tableMapPageId);
-        LargeDataPage *lastLargeDataPage = nullptr;
+        PageGuard<LargeDataPage> lastLargeDataPage;
 
         vector<extent_id_t> allocatedExtents;
         tableMapPage->GetAllocatedExtents(&allocatedExtents);
@@ -753,7 +836,7 @@ namespace DatabaseEngine
         return nullptr;
     }
 
-    LargeDataPage *Database::GetLargeDataPage(const page_id_t &pageId, const table_id_t &tableId)
+    PageGuard<LargeDataPage> Database::GetLargeDataPage(const page_id_t &pageId, const table_id_t &tableId)
     {
         if (tableId >= this->tables.size())
             return nullptr;
@@ -779,9 +862,10 @@ namespace DatabaseEngine
             }
         }
 
-        return (extentFound)
-                   ? StorageManager::Get().GetLargeDataPage(pageId, associatedExtentId, this->tables[tableId])
-                   : nullptr;
+        if (!extentFound)
+            return nullptr;
+
+        return StorageManager::Get().GetLargeDataPage(pageId, associatedExtentId, this->tables[tableId]);
     }
 
     void Database::SetPageMetaDataToPfs(const Page *page)
@@ -6,6 +6,8 @@
 
 #include "B+Tree/BPlusTree.h"
 #include "Column/Column.h"
+#include "Storage/PageGuard/PageGuard.h"
+#include "Storage/StorageSettings/StorageSettings.h"
 
 using namespace Constants;
 using namespace std;
@@ -70,6 +72,8 @@ class Database {
 protected:
     void ValidateTableCreation(StorageTypes::Table *table) const;
 
+    void ValidateWriteAccess(const string &operation) const;
+
     void WriteHeaderToFile() const;
 
     static bool IsSystemPage(const page_id_t &pageId);
@@ -155,15 +159,15 @@ public:
 
     void TruncateTable(const table_id_t& tableId);
   
-    Pages::Page *CreateDataPage(const table_id_t &tableId);
+    Storage::PageGuard<Pages::Page> CreateDataPage(const table_id_t &tableId);
 
-    Pages::LargeDataPage *CreateLargeDataPage(const table_id_t &tableId);
+    Storage::PageGuard<Pages::LargeDataPage> CreateLargeDataPage(const table_id_t &tableId);
 
-    Pages::LargeDataPage *GetTableLastLargeDataPage(const table_id_t &tableId, const page_size_t &minObjectSize);
+    Storage::PageGuard<Pages::LargeDataPage> GetTableLastLargeDataPage(const table_id_t &tableId, const page_size_t &minObjectSize);
 
-    Pages::LargeDataPage *GetLargeDataPage(const page_id_t &pageId, const table_id_t &tableId);
+    Storage::PageGuard<Pages::LargeDataPage> GetLargeDataPage(const page_id_t &pageId, const table_id_t &tableId);
 
-    Pages::IndexPage *CreateIndexPage(const table_id_t &tableId, const page_id_t& treeId = 0);
+    Storage::PageGuard<Pages::IndexPage> CreateIndexPage(const table_id_t &tableId, const page_id_t& treeId = 0);
 
     static void SetPageMetaDataToPfs(const Pages::Page *page);
 
@@ -173,14 +177,14 @@ public:
 
     static extent_id_t CalculateExtentIdByPageId(const page_id_t &pageId);
 
-    [[nodiscard]] Pages::Page *FindOrAllocateNextDataPage(  Pages::PageFreeSpacePage *&pageFreeSpacePage, 
+    [[nodiscard]] Storage::PageGuard<Pages::Page> FindOrAllocateNextDataPage(  Pages::PageFreeSpacePage *&pageFreeSpacePage, 
                                                             const page_id_t &pageId, 
                                                             const page_id_t &extentFirstPageId, 
                                                             const extent_id_t &extentId, 
                                                             const StorageTypes::Table &table, 
                                                             extent_id_t *nextExtentId);
 
-    [[nodiscard]] Pages::IndexPage* FindOrAllocateNextIndexPage(  const table_id_t& tableId
+    [[nodiscard]] Storage::PageGuard<Pages::IndexPage> FindOrAllocateNextIndexPage(  const table_id_t& tableId
                                                                 , const page_id_t &indexPageId
                                                                 , const int& nodeSize
                                                                 , const int& nonClusteredIndexId = -1
@@ -202,7 +206,7 @@ public:
 
 void CreateDatabase(const string &dbName);
 
-void UseDatabase(const string &dbName, Database **db);
+void UseDatabase(const string &dbName, Database **db, const Storage::StorageSettings &settings = Storage::StorageSettings());
 
 void PrintRows(const vector<StorageTypes::Row> &rows);
 
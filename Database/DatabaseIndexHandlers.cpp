@@ -42,7 +42,8 @@ namespace DatabaseEngine {
 
         int indexPosition = 0;
 
-        Node *node = tree->FindAppropriateNodeForInsert(key, &indexPosition);
+        PageGuard<IndexPage> nodePage;
+        Node *node = tree->FindAppropriateNodeForInsert(key, &indexPosition, nodePage);
 
         *rowIndex = indexPosition;
 
@@ -55,14 +56,14 @@ namespace DatabaseEngine {
         }
 
         //first Insert
-        Page *newPage = this->CreateDataPage(table->GetTableId());
+        const PageGuard<Page> newPage = this->CreateDataPage(table->GetTableId());
 
         const page_id_t &newPageId = newPage->GetPageId();
 
         PageFreeSpacePage *pageFreeSpacePage =  Database::GetAssociatedPfsPage(newPageId);
 
         // should never fail
-        Database::InsertRowToPage(pageFreeSpacePage, newPage, row, indexPosition);
+        Database::InsertRowToPage(pageFreeSpacePage, newPage.Get(), row, indexPosition);
 
         node->keys.insert(node->keys.begin() + indexPosition, key);
         node->currentNodeSize += key.GetKeySize();
@@ -81,7 +82,9 @@ namespace DatabaseEngine {
         const auto key = Database::CreateKey(indexedColumns, row);
 
         int indexPosition = 0;
-        Node *node = tree->FindAppropriateNodeForInsert(key, &indexPosition);
+
+        PageGuard<IndexPage> nodePage;
+        Node *node = tree->FindAppropriateNodeForInsert(key, &indexPosition, nodePage);
 
         node->keys.insert(node->keys.begin() + indexPosition, key);
         node->nonClusteredData.insert(node->nonClusteredData.begin() + indexPosition, data);
@@ -99,7 +102,7 @@ namespace DatabaseEngine {
 
         const extent_id_t pageExtentId = Database::CalculateExtentIdByPageId(pageId);
 
-        Page *page = StorageManager::Get().GetPage(pageId, pageExtentId, table);
+        const PageGuard<Page> page = StorageManager::Get().GetPage(pageId, pageExtentId, table);
 
         const page_id_t extentFirstPageId = Database::CalculateSystemPageOffsetByExtentId(pageExtentId);
 
@@ -107,16 +110,16 @@ namespace DatabaseEngine {
         extent_id_t nextExtentId = 0;
         PageFreeSpacePage *pageFreeSpacePage = Database::GetAssociatedPfsPage(pageId);
 
-        Page *nextLeafPage = this->FindOrAllocateNextDataPage(pageFreeSpacePage, pageId, extentFirstPageId, pageExtentId, *table, &nextExtentId);
+        const PageGuard<Page> nextLeafPage = this->FindOrAllocateNextDataPage(pageFreeSpacePage, pageId, extentFirstPageId, pageExtentId, *table, &nextExtentId);
 
         const page_id_t nextLeafPageId = nextLeafPage->GetPageId();
-        page->SplitPageRowByBranchingFactor(nextLeafPage, branchingFactor, *table);
+        page->SplitPageRowByBranchingFactor(nextLeafPage.Get(), branchingFactor, *table);
 
-        pageFreeSpacePage->SetPageMetaData(page);
-        pageFreeSpacePage->SetPageMetaData(nextLeafPage);
+        pageFreeSpacePage->SetPageMetaData(page.Get());
+        pageFreeSpacePage->SetPageMetaData(nextLeafPage.Get());
 
         secondNode->dataPageId = nextLeafPageId;
-        UpdateNonClusteredData(*table, nextLeafPage, nextLeafPageId);
+        UpdateNonClusteredData(*table, nextLeafPage.Get(), nextLeafPageId);
     }
 
     void Database::UpdateNonClusteredData(const Table& table, Page* nextLeafPage, const page_id_t& nextLeafPageId) const
@@ -144,7 +147,7 @@ namespace DatabaseEngine {
         }
     }
 
-	IndexPage* Database::FindOrAllocateNextIndexPage(const table_id_t& tableId, const page_id_t &indexPageId, const int& nodeSize, const int& nonClusteredIndexId, const bool& findPageDifferentFromCurrent)
+	PageGuard<IndexPage> Database::FindOrAllocateNextIndexPage(const table_id_t& tableId, const page_id_t &indexPageId, const int& nodeSize, const int& nonClusteredIndexId, const bool& findPageDifferentFromCurrent)
     {
         const auto& tableHeader = this->GetTable(tableId)->GetTableHeader();
 
@@ -158,7 +161,7 @@ namespace DatabaseEngine {
 
         if(indexPageId == 0)
         {
-            IndexPage* newIndexPage = this->CreateIndexPage(tableId, indexId);
+            PageGuard<IndexPage> newIndexPage = this->CreateIndexPage(tableId, indexId);
             
             newIndexPage->SetTreeType(isNonClusteredIndex 
                                     ? TreeType::NonClustered 
@@ -191,7 +194,7 @@ namespace DatabaseEngine {
                 if(pageFreeSpacePage->GetPageSizeCategory(nextIndexPageId) == 0)
                     continue;
 
-                IndexPage* indexPage = StorageManager::Get().GetIndexPage(nextIndexPageId, extentId, table);
+                PageGuard<IndexPage> indexPage = StorageManager::Get().GetIndexPage(nextIndexPageId, extentId, table);
 
                 if(indexPage->GetBytesLeft() < nodeSize
                     || indexPage->GetTreeId() != indexId)
@@ -205,7 +208,7 @@ namespace DatabaseEngine {
             }
         }
 
-        IndexPage* newIndexPage = this->CreateIndexPage(tableId, indexId);
+        PageGuard<IndexPage> newIndexPage = this->CreateIndexPage(tableId, indexId);
             
         newIndexPage->SetTreeType(isNonClusteredIndex 
                                 ? TreeType::NonClustered 
@@ -216,14 +219,14 @@ namespace DatabaseEngine {
 
     void Database::SplitNodeFromIndexPage(const table_id_t& tableId, Node*& node, const int& nonClusteredIndexId)
     {
-        IndexPage* overflowedPage = StorageManager::Get().GetIndexPage(node->header.pageId);
+        const PageGuard<IndexPage> overflowedPage = StorageManager::Get().GetIndexPage(node->header.pageId);
 
         overflowedPage->UpdateBytesLeft();
 
         if(overflowedPage->GetBytesLeft() > 0)
         {
             PageFreeSpacePage* overflowedPagePFS = Database::GetAssociatedPfsPage(overflowedPage->GetPageId());
-            overflowedPagePFS->SetPageMetaData(overflowedPage);
+            overflowedPagePFS->SetPageMetaData(overflowedPage.Get());
             return;
         }
 
@@ -233,7 +236,7 @@ namespace DatabaseEngine {
 
         const page_size_t availablePageBytes = PAGE_SIZE - PageHeader::GetPageHeaderSize() - IndexPageAdditionalHeader::GetAdditionalHeaderSize();
 
-        IndexPage* nextIndexPage = this->FindOrAllocateNextIndexPage(tableId, overflowedPage->GetPageId(), availablePageBytes, nonClusteredIndexId, true);
+        const PageGuard<IndexPage> nextIndexPage = this->FindOrAllocateNextIndexPage(tableId, overflowedPage->GetPageId(), availablePageBytes, nonClusteredIndexId, true);
 
         vector<Node*>* nextIndexPageNodes = nextIndexPage->GetNodesUnsafe();
 
@@ -263,17 +266,17 @@ namespace DatabaseEngine {
         nextIndexPage->UpdatePageSize();
 
         PageFreeSpacePage* overflowedPagePFS = Database::GetAssociatedPfsPage(overflowedPage->GetPageId());
-        overflowedPagePFS->SetPageMetaData(overflowedPage);
+        overflowedPagePFS->SetPageMetaData(overflowedPage.Get());
 
         PageFreeSpacePage* nextIndexPagePFS = Database::GetAssociatedPfsPage(nextIndexPageId);
-        nextIndexPagePFS->SetPageMetaData(nextIndexPage);
+        nextIndexPagePFS->SetPageMetaData(nextIndexPage.Get());
     }
 
     void Database::UpdateNodeConnections(Node *& node, const NodeHeader& newNodeHeader)
     {
         if (node->parentHeader.pageId != 0)
         {
-            IndexPage* parentNodeIndexPage = StorageManager::Get().GetIndexPage(node->parentHeader.pageId);
+            const PageGuard<IndexPage> parentNodeIndexPage = StorageManager::Get().GetIndexPage(node->parentHeader.pageId);
             const Node* parentNode = parentNodeIndexPage->GetNodeByIndex(node->parentHeader.indexPosition);
 
             for (int index = 0; index < parentNode->childrenHeaders.size(); index++)
@@ -291,14 +294,14 @@ namespace DatabaseEngine {
         {
             if (node->previousNodeHeader.pageId != 0)
             {
-                IndexPage* previousLeafNodeIndexPage = StorageManager::Get().GetIndexPage(node->previousNodeHeader.pageId);
+                const PageGuard<IndexPage> previousLeafNodeIndexPage = StorageManager::Get().GetIndexPage(node->previousNodeHeader.pageId);
 
                 previousLeafNodeIndexPage->UpdateNodeNextLeafHeader(node->previousNodeHeader.indexPosition, newNodeHeader);
             }
 
             if (node->nextNodeHeader.pageId != 0)
             {
-                IndexPage* nextLeafNodeIndexPage = StorageManager::Get().GetIndexPage(node->nextNodeHeader.pageId);
+                const PageGuard<IndexPage> nextLeafNodeIndexPage = StorageManager::Get().GetIndexPage(node->nextNodeHeader.pageId);
 
                 nextLeafNodeIndexPage->UpdateNodePreviousLeafHeader(node->nextNodeHeader.indexPosition, newNodeHeader);
             }
@@ -308,7 +311,7 @@ namespace DatabaseEngine {
 
         for (auto& child : node->childrenHeaders)
         {
-            IndexPage* childIndexPage = StorageManager::Get().GetIndexPage(child.pageId);
+            const PageGuard<IndexPage> childIndexPage = StorageManager::Get().GetIndexPage(child.pageId);
 
             childIndexPage->UpdateNodeParentHeader(child.indexPosition, newNodeHeader);
         }
@@ -318,7 +321,7 @@ namespace DatabaseEngine {
     {
         if (node->parentHeader.pageId != 0)
         {
-            IndexPage* parentNodeIndexPage = StorageManager::Get().GetIndexPage(node->parentHeader.pageId);
+            const PageGuard<IndexPage> parentNodeIndexPage = StorageManager::Get().GetIndexPage(node->parentHeader.pageId);
             const Node* parentNode = parentNodeIndexPage->GetNodeByIndex(node->parentHeader.indexPosition);
 
             for (int index = 0; index < parentNode->childrenHeaders.size(); index++)
@@ -336,14 +339,14 @@ namespace DatabaseEngine {
         {
             if (node->previousNodeHeader.pageId != 0)
             {
-                IndexPage* previousLeafNodeIndexPage = StorageManager::Get().GetIndexPage(node->previousNodeHeader.pageId);
+                const PageGuard<IndexPage> previousLeafNodeIndexPage = StorageManager::Get().GetIndexPage(node->previousNodeHeader.pageId);
 
                 previousLeafNodeIndexPage->UpdateNodeNextLeafHeader(node->previousNodeHeader.indexPosition, node->header);
             }
 
             if (node->nextNodeHeader.pageId != 0)
             {
-                IndexPage* nextLeafNodeIndexPage = StorageManager::Get().GetIndexPage(node->nextNodeHeader.pageId);
+                const PageGuard<IndexPage> nextLeafNodeIndexPage = StorageManager::Get().GetIndexPage(node->nextNodeHeader.pageId);
 
                 nextLeafNodeIndexPage->UpdateNodePreviousLeafHeader(node->nextNodeHeader.indexPosition, node->header);
             }
@@ -353,7 +356,7 @@ namespace DatabaseEngine {
 
         for (auto& child : node->childrenHeaders)
         {
-            IndexPage* childIndexPage = StorageManager::Get().GetIndexPage(child.pageId);
+            const PageGuard<IndexPage> childIndexPage = StorageManager::Get().GetIndexPage(child.pageId);
 
             childIndexPage->UpdateNodeParentHeader(child.indexPosition, node->header);
         }  
@@ -368,13 +371,16 @@ namespace DatabaseEngine {
 
         const bool isNonClusteredIndex = nonClusteredIndexId != -1;
 
+        // the tree keeps the page of its root pinned, the pin follows the root while the page it moved to is still pinned by the split
         if (isNonClusteredIndex)
         {
             table->SetNonClusteredIndexPageId(node->header.pageId, nonClusteredIndexId);
+            table->GetNonClusteredIndexTree(nonClusteredIndexId)->SetRootPage(StorageManager::Get().GetIndexPage(node->header.pageId));
             return;
         }
 
         table->SetClusteredIndexPageId(node->header.pageId);
+        table->GetClusteredIndexedTree()->SetRootPage(StorageManager::Get().GetIndexPage(node->header.pageId));
     }
 
     void Database::InsertRowToNonEmptyNode(Node *node, const Table &table, Row *row, const Key &key, const int &indexPosition)
@@ -383,9 +389,9 @@ namespace DatabaseEngine {
 
         const extent_id_t pageExtentId = Database::CalculateExtentIdByPageId(node->dataPageId);
 
-        Page *page = StorageManager::Get().GetPage(node->dataPageId, pageExtentId, &table);
+        const PageGuard<Page> page = StorageManager::Get().GetPage(node->dataPageId, pageExtentId, &table);
 
-        Database::InsertRowToPage(pageFreeSpacePage, page, row, indexPosition);
+        Database::InsertRowToPage(pageFreeSpacePage, page.Get(), row, indexPosition);
 
         //node->prevNodeSize = (node->prevNodeSize > 0) ? node->prevNodeSize : node->GetNodeSize();
 
@@ -49,13 +49,13 @@ namespace Pages {
         this->isDirty = true;
     }
 
-    void GlobalAllocationMapPage::WritePageToFile(fstream *filePtr)
+    void GlobalAllocationMapPage::WritePageToFile(ostream *filePtr)
     {
         this->WritePageHeaderToFile(filePtr);
         this->extentsMap->WriteDataToFile(filePtr);
     }
 
-    void GlobalAllocationMapPage::GetPageDataFromFile(const vector<char> &data, const Table *table, page_offset_t &offSet, fstream *filePtr)
+    void GlobalAllocationMapPage::GetPageDataFromFile(const span<const char> &data, const Table *table, page_offset_t &offSet, fstream *filePtr)
     {
         this->extentsMap->GetDataFromFile(data, offSet);
     }
@@ -23,8 +23,8 @@ namespace Pages {
         ~GlobalAllocationMapPage() override;
         extent_id_t AllocateExtent();
         void DeallocateExtent(const extent_id_t& extentId);
-        void WritePageToFile(fstream *filePtr) override;
-        void GetPageDataFromFile(const vector<char>& data, const DatabaseEngine::StorageTypes::Table* table, page_offset_t& offSet, fstream* filePtr) override;
+        void WritePageToFile(ostream *filePtr) override;
+        void GetPageDataFromFile(const span<const char>& data, const DatabaseEngine::StorageTypes::Table* table, page_offset_t& offSet, fstream* filePtr) override;
         [[nodiscard]] bool IsFull() const;
     };
 }
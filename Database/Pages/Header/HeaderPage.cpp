@@ -35,7 +35,7 @@ namespace Pages
         delete this->databaseHeader;
     }
 
-    void HeaderPage::WritePageToFile(fstream *filePtr)
+    void HeaderPage::WritePageToFile(ostream *filePtr)
     {
         this->WritePageHeaderToFile(filePtr);
 
@@ -93,7 +93,7 @@ namespace Pages
         }
     }
 
-    void HeaderPage::GetPageDataFromFile(const vector<char> &data, const Table *table, page_offset_t &offSet, fstream *filePtr)
+    void HeaderPage::GetPageDataFromFile(const span<const char> &data, const Table *table, page_offset_t &offSet, fstream *filePtr)
     {
         memcpy(&this->databaseHeader->databaseNameSize, data.data() + offSet, sizeof(header_literal_t));
         offSet += sizeof(header_literal_t);
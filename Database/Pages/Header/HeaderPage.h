@@ -20,8 +20,8 @@ namespace Pages {
         explicit HeaderPage();
         explicit HeaderPage(const PageHeader &pageHeader);
         ~HeaderPage() override;
-        void WritePageToFile(fstream* filePtr) override;
-        void GetPageDataFromFile(const vector<char>& data, const DatabaseEngine::StorageTypes::Table* table, page_offset_t& offSet, fstream* filePtr) override;
+        void WritePageToFile(ostream* filePtr) override;
+        void GetPageDataFromFile(const span<const char>& data, const DatabaseEngine::StorageTypes::Table* table, page_offset_t& offSet, fstream* filePtr) override;
         void SetDbHeader(const DatabaseEngine::DatabaseHeader& databaseHeader);
         void SetTableHeader(const DatabaseEngine::StorageTypes::Table* table);
         [[nodiscard]] const DatabaseEngine::DatabaseHeader* GetDatabaseHeader() const;
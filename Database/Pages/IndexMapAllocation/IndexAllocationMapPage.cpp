@@ -12,7 +12,7 @@ namespace Pages {
     {
         this->additionalHeader.tableId = tableId;
         this->additionalHeader.startingExtentId = startingExtentId;
-        this->header.bytesLeft -= (sizeof(table_id_t) + sizeof(extent_id_t));
+        this->header.bytesLeft = PAGE_SIZE - PageHeader::GetPageHeaderSize() - (sizeof(table_id_t) + sizeof(extent_id_t));
         this->ownedExtents = new BitMap(GAM_PAGE_SIZE);
         this->isDirty = true;
         this->header.pageType = PageType::IAM;
@@ -90,13 +90,13 @@ namespace Pages {
         return (IndexAllocationMapPage::CalculatePageIdOffsetByGamPageId(globalAllocationMapPageId) + lastAllocatedExtent);
     }
 
-    void IndexAllocationMapPage::GetPageDataFromFile(const vector<char> &data, const Table *table, page_offset_t &offSet,fstream *filePtr)
+    void IndexAllocationMapPage::GetPageDataFromFile(const span<const char> &data, const Table *table, page_offset_t &offSet,fstream *filePtr)
     {
         this->GetAdditionalHeaderFromFile(data, offSet);
         this->ownedExtents->GetDataFromFile(data, offSet);
     }
 
-    void IndexAllocationMapPage::WritePageToFile(fstream *filePtr)
+    void IndexAllocationMapPage::WritePageToFile(ostream *filePtr)
     {
         this->WritePageHeaderToFile(filePtr);
 
@@ -125,13 +125,13 @@ namespace Pages {
 
     IndexAllocationPageAdditionalHeader::~IndexAllocationPageAdditionalHeader() = default;
 
-    void IndexAllocationMapPage::GetAdditionalHeaderFromFile(const vector<char> &data, page_offset_t &offSet)
+    void IndexAllocationMapPage::GetAdditionalHeaderFromFile(const span<const char> &data, page_offset_t &offSet)
     {
         memcpy(&this->additionalHeader, data.data() + offSet, sizeof(IndexAllocationPageAdditionalHeader));
         offSet += sizeof(IndexAllocationPageAdditionalHeader);
     }
 
-    void IndexAllocationMapPage::WriteAdditionalHeaderToFile(fstream* filePtr)
+    void IndexAllocationMapPage::WriteAdditionalHeaderToFile(ostream* filePtr)
     {
         filePtr->write(reinterpret_cast<const char*>(&this->additionalHeader), sizeof(IndexAllocationPageAdditionalHeader));
     }
@@ -25,8 +25,8 @@ namespace Pages {
         uint16_t lastAllocatedExtentId;
 
     protected:
-        void GetAdditionalHeaderFromFile(const vector<char> &data, page_offset_t &offSet);
-        void WriteAdditionalHeaderToFile(fstream* filePtr);
+        void GetAdditionalHeaderFromFile(const span<const char> &data, page_offset_t &offSet);
+        void WriteAdditionalHeaderToFile(ostream* filePtr);
         static page_id_t CalculatePageIdOffsetByGamPageId(const page_id_t& globalAllocationMapPageId);
     
     public:
@@ -38,8 +38,8 @@ namespace Pages {
         void GetAllocatedExtents(vector<extent_id_t>* allocatedExtents) const;
         void GetAllocatedExtents(vector<extent_id_t>* allocatedExtents, const extent_id_t& startingExtentIndex) const;
         [[nodiscard]] extent_id_t GetLastAllocatedExtent() const;
-        void GetPageDataFromFile(const vector<char>& data, const DatabaseEngine::StorageTypes::Table* table, page_offset_t& offSet, fstream* filePtr) override;
-        void WritePageToFile(fstream* filePtr) override;
+        void GetPageDataFromFile(const span<const char>& data, const DatabaseEngine::StorageTypes::Table* table, page_offset_t& offSet, fstream* filePtr) override;
+        void WritePageToFile(ostream* filePtr) override;
         void SetNextPageId(const page_id_t& nextPageId);
         const page_id_t& GetNextPageId() const;
     };
@@ -10,14 +10,14 @@ using namespace DatabaseEngine::StorageTypes;
 
 namespace Pages {
 
-void IndexPage::WriteAdditionalHeaderToFile(fstream * filePtr) const
+void IndexPage::WriteAdditionalHeaderToFile(ostream * filePtr) const
 {
     filePtr->write(reinterpret_cast<const char*>(&this->additionalHeader.treeType), sizeof(TreeType));
     filePtr->write(reinterpret_cast<const char*>(&this->additionalHeader.treeId), sizeof(page_id_t));
     filePtr->write(reinterpret_cast<const char*>(&this->additionalHeader.numberOfSubKeys), sizeof(uint8_t));
 }
 
-void IndexPage::ReadAdditionalHeaderFromFile(const vector<char>& data, page_offset_t & offSet)
+void IndexPage::ReadAdditionalHeaderFromFile(const span<const char>& data, page_offset_t & offSet)
 {
     memcpy(&this->additionalHeader.treeType, data.data() + offSet, sizeof(TreeType));
     offSet += sizeof(TreeType);
@@ -32,6 +32,8 @@ void IndexPage::ReadAdditionalHeaderFromFile(const vector<char>& data, page_offs
 IndexPage::IndexPage(const page_id_t &pageId, const bool &isPageCreation) : Page(pageId, isPageCreation) 
 {
   this->header.pageType = PageType::INDEX;
+  // index pages have no slot directory
+  this->header.bytesLeft = PAGE_SIZE - PageHeader::GetPageHeaderSize();
 }
 
 IndexPage::IndexPage(const PageHeader &pageHeader) : Page(pageHeader) { }
@@ -42,7 +44,7 @@ IndexPage::~IndexPage()
         delete node;
 }
 
-void IndexPage::GetPageDataFromFile(const vector<char> &data, const Table *table, page_offset_t &offSet, fstream *filePtr) 
+void IndexPage::GetPageDataFromFile(const span<const char> &data, const Table *table, page_offset_t &offSet, fstream *filePtr) 
 {
     this->ReadAdditionalHeaderFromFile(data, offSet);
     const vector<ColumnType> indexedColumnTypes = table->GetColumnTypeByTreeId(this->additionalHeader.treeId);
@@ -142,7 +144,7 @@ void IndexPage::GetPageDataFromFile(const vector<char> &data, const Table *table
     }
 }
 
-void IndexPage::WritePageToFile(fstream *filePtr) 
+void IndexPage::WritePageToFile(ostream *filePtr) 
 {
     if (!this->nodes.empty())
         this->additionalHeader.numberOfSubKeys = this->nodes.front()->keys.front().subKeys.size();
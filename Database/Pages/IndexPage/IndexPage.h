@@ -38,16 +38,16 @@ namespace Pages {
 		vector<column_index_t> indexedColumns;
 
 		protected:
-			void WriteAdditionalHeaderToFile(fstream* filePtr) const;
-			void ReadAdditionalHeaderFromFile(const vector<char>& data, page_offset_t &offSet);
+			void WriteAdditionalHeaderToFile(ostream* filePtr) const;
+			void ReadAdditionalHeaderFromFile(const span<const char>& data, page_offset_t &offSet);
 
 		public:
 			IndexPage(const page_id_t &pageId, const bool &isPageCreation);
 			explicit IndexPage(const PageHeader &pageHeader);
 			~IndexPage() override;
 
-			void GetPageDataFromFile(const vector<char> &data, const DatabaseEngine::StorageTypes::Table *table, page_offset_t &offSet, fstream *filePtr) override;
-			void WritePageToFile(fstream *filePtr) override;
+			void GetPageDataFromFile(const span<const char> &data, const DatabaseEngine::StorageTypes::Table *table, page_offset_t &offSet, fstream *filePtr) override;
+			void WritePageToFile(ostream *filePtr) override;
 
 			void SetTreeType(const TreeType& treeType);
 			void SetTreeId(const page_id_t& treeId);
@@ -34,6 +34,8 @@ namespace Pages {
     LargeDataPage::LargeDataPage(const page_id_t& pageId, const bool& isPageCreation) : Page(pageId, isPageCreation)
     {
         this->header.pageType = PageType::LOB;
+        // large object pages have no slot directory
+        this->header.bytesLeft = PAGE_SIZE - PageHeader::GetPageHeaderSize();
     }
 
     LargeDataPage::LargeDataPage() : Page()
@@ -50,7 +52,7 @@ namespace Pages {
             delete dataObject;
     }
 
-    void LargeDataPage::GetPageDataFromFile(const vector<char> &data, const Table *table, page_offset_t& offSet, fstream* filePtr)
+    void LargeDataPage::GetPageDataFromFile(const span<const char> &data, const Table *table, page_offset_t& offSet, fstream* filePtr)
     {
         for(int i = 0; i < this->header.pageSize; i++)
         {
@@ -74,7 +76,7 @@ namespace Pages {
 
     }
 
-    void LargeDataPage::WritePageToFile(fstream *filePtr)
+    void LargeDataPage::WritePageToFile(ostream *filePtr)
     {
         this->WritePageHeaderToFile(filePtr);
 
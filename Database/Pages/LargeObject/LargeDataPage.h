@@ -42,8 +42,8 @@ namespace Pages {
         explicit LargeDataPage();
         explicit LargeDataPage(const PageHeader& pageHeader);
         ~LargeDataPage() override;
-        void GetPageDataFromFile(const vector<char>& data, const DatabaseEngine::StorageTypes::Table* table, page_offset_t& offSet, fstream* filePtr) override;
-        void WritePageToFile(fstream* filePtr) override;
+        void GetPageDataFromFile(const span<const char>& data, const DatabaseEngine::StorageTypes::Table* table, page_offset_t& offSet, fstream* filePtr) override;
+        void WritePageToFile(ostream* filePtr) override;
         DataObject* InsertObject(const object_t* object, const page_size_t& size, page_offset_t* objectPosition);
         DataObject* GetObject(const page_offset_t& offset);
     };
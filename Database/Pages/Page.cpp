@@ -2,14 +2,20 @@
 #include "../Database.h"
 #include "../Table/Table.h"
 #include "../Row/Row.h"
+#include "../RowView/RowView.h"
+#include "../RowPredicate/RowPredicate.h"
 #include "./LargeObject/LargeDataPage.h"
 #include "../../AdditionalLibraries/BitMap/BitMap.h"
 #include "../Block/Block.h"
+#include <atomic>
+#include <limits>
 
 using namespace DatabaseEngine::StorageTypes;
 
 namespace Pages
 {
+    static atomic<bool> isRowArenaEnabled = true;
+
     PageHeader::PageHeader()
     {
         this->pageType = PageType::DATA;
@@ -25,20 +31,27 @@ namespace Pages
     Page::Page(const page_id_t &pageId, const bool &isPageCreation)
     {
         this->header.pageId = pageId;
+        this->header.bytesLeft -= Page::GetSlotDirectoryHeaderSize();
         this->isDirty = isPageCreation;
         this->header.pageType = PageType::DATA;
+        this->table = nullptr;
+        this->imageRowFormat = RowFormat::COMPACT;
     }
 
     Page::Page()
     {
         this->isDirty = false;
         this->header.pageType = PageType::DATA;
+        this->table = nullptr;
+        this->imageRowFormat = RowFormat::COMPACT;
     }
 
     Page::Page(const PageHeader &pageHeader)
     {
         this->header = pageHeader;
         this->isDirty = false;
+        this->table = nullptr;
+        this->imageRowFormat = RowFormat::COMPACT;
     }
 
     Page::~Page()
@@ -50,6 +63,7 @@ namespace Pages
     void Page::InsertRow(Row *row, int* indexPosition)
     {
         this->rows.push_back(row);
+        this->rowOffsets.push_back(0);
         
         if(indexPosition != nullptr)
             *indexPosition = this->rows.size() - 1;
@@ -62,6 +76,7 @@ namespace Pages
     void Page::InsertRow(Row *row, const int& indexPosition)
     {
         this->rows.insert(this->rows.begin() + indexPosition, row);
+        this->rowOffsets.insert(this->rowOffsets.begin() + indexPosition, 0);
         this->header.bytesLeft -= row->GetTotalRowSize();
         this->header.pageSize++;
         this->isDirty = true;
@@ -72,56 +87,129 @@ namespace Pages
         this->isDirty = true;
     }
 
-    void Page::GetPageDataFromFile(const vector<char> &data, const Table *table, page_offset_t &offSet, fstream *filePtr)
+    void Page::GetPageDataFromFile(const span<const char> &data, const Table *table, page_offset_t &offSet, fstream *filePtr)
     {
-        const auto &columns = table->GetColumns();
+        this->table = table;
+
+        uint32_t pageFormat;
+        memcpy(&pageFormat, data.data() + offSet, sizeof(uint32_t));
 
-        for (int i = 0; i < this->header.pageSize; i++)
+        // empty pages are written slotted and compact from now on, whatever they were written as before
+        if (this->header.pageSize == 0)
         {
-            Row *row = new Row(*table);
-            RowHeader *rowHeader = row->GetHeader();
+            this->header.bytesLeft = PAGE_SIZE - PageHeader::GetPageHeaderSize() - Page::GetSlotDirectoryHeaderSize();
+            return;
+        }
 
-            memcpy(&rowHeader->rowSize, data.data() + offSet, sizeof(row_size_t));
-            offSet += sizeof(row_size_t);
+        this->pageImage.assign(data.begin(), data.end());
 
-            memcpy(&rowHeader->maxRowSize, data.data() + offSet, sizeof(size_t));
-            offSet += sizeof(size_t);
+        const bool isSlotted = pageFormat == COMPACT_ROW_PAGE_MAGIC || pageFormat == SLOTTED_PAGE_MAGIC;
 
-            rowHeader->nullBitMap->GetDataFromFile(data, offSet);
-            rowHeader->largeObjectBitMap->GetDataFromFile(data, offSet);
+        this->imageRowFormat = (pageFormat == COMPACT_ROW_PAGE_MAGIC) ? RowFormat::COMPACT : RowFormat::FIXED_HEADER;
 
-            for (int j = 0; j < columns.size(); j++)
-            {
-                if (rowHeader->nullBitMap->Get(j))
-                {
-                    Block *block = new Block(nullptr, 0, columns[j]);
+        if (isSlotted)
+        {
+            offSet += sizeof(uint32_t);
 
-                    row->InsertColumnData(block, j);
+            page_size_t rowCount;
+            memcpy(&rowCount, data.data() + offSet, sizeof(page_size_t));
+            offSet += sizeof(page_size_t);
 
-                    continue;
-                }
+            this->rowOffsets.resize(rowCount);
+            memcpy(this->rowOffsets.data(), data.data() + offSet, rowCount * sizeof(page_offset_t));
+            offSet += rowCount * sizeof(page_offset_t);
+
+            this->rows.assign(rowCount, nullptr);
+
+            return;
+        }
+
+        // pages written before the slot directory existed, their row boundaries are found by walking the rows
+        for (page_size_t i = 0; i < this->header.pageSize; i++)
+        {
+            this->rowOffsets.push_back(offSet);
+
+            offSet += RowView(data.data() + offSet, RowFormat::FIXED_HEADER).GetSerializedSize();
+        }
+
+        this->rows.assign(this->header.pageSize, nullptr);
+    }
+
+    void Page::MaterializeRows()
+    {
+        if (this->pageImage.empty())
+            return;
+
+        for (page_size_t rowIndex = 0; rowIndex < this->rows.size(); rowIndex++)
+            this->MaterializeRow(rowIndex);
+
+        // every row is decoded, the image has nothing left to serve
+        this->pageImage = vector<char>();
+    }
+
+    Row *Page::MaterializeRow(const page_size_t &rowIndex)
+    {
+        if (this->rows[rowIndex] != nullptr)
+            return this->rows[rowIndex];
 
-                block_size_t bytesToRead;
+        const auto &columns = this->table->GetColumns();
+        const RowView rowView = this->GetRowView(rowIndex);
 
-                memcpy(&bytesToRead, data.data() + offSet, sizeof(block_size_t));
-                offSet += sizeof(block_size_t);
+        if (this->rowArena == nullptr && isRowArenaEnabled.load(memory_order_relaxed))
+            this->rowArena = make_shared<Arenas::MonotonicArena>(ROW_ARENA_CHUNK_SIZE);
 
-                object_t *bytes = new unsigned char[bytesToRead];
-                memcpy(bytes, data.data() + offSet, bytesToRead);
+        Arenas::MonotonicArena *arena = this->rowArena.get();
 
-                offSet += bytesToRead;
+        Row *row = new (arena) Row(*this->table);
+        RowHeader *rowHeader = row->GetHeader();
+
+        // rowSize is summed up again as the blocks are inserted
+        rowHeader->nullBitMap = ByteMaps::InlineBitSet(rowView.GetNumberOfColumns());
+        rowHeader->largeObjectBitMap = ByteMaps::InlineBitSet(rowView.GetNumberOfColumns());
+
+        const char *column = rowView.GetFirstColumn();
+
+        for (int j = 0; j < columns.size(); j++)
+        {
+            if (rowView.IsNull(j))
+            {
+                rowHeader->nullBitMap.Set(j, true);
 
-                Block *block = new Block(bytes, bytesToRead, columns[j]);
+                Block *block = new (arena) Block(nullptr, 0, columns[j], arena);
 
                 row->InsertColumnData(block, j);
 
-                delete[] bytes;
+                continue;
             }
-            this->rows.push_back(row);
+
+            rowHeader->largeObjectBitMap.Set(j, rowView.IsLargeObject(j));
+
+            block_size_t bytesToRead;
+            const object_t *blockData = rowView.ReadColumn(column, bytesToRead);
+
+            Block *block = new (arena) Block(blockData, bytesToRead, columns[j], arena);
+
+            row->InsertColumnData(block, j);
         }
+
+        this->rows[rowIndex] = row;
+
+        return row;
+    }
+
+    bool Page::IsImageUnchanged() const
+    {
+        if (this->pageImage.empty())
+            return false;
+
+        for (const auto &row : this->rows)
+            if (row != nullptr)
+                return false;
+
+        return true;
     }
 
-    void Page::WritePageHeaderToFile(fstream *filePtr) const
+    void Page::WritePageHeaderToFile(ostream *filePtr) const
     {
         filePtr->write(reinterpret_cast<const char *>(&this->header.pageId), sizeof(page_id_t));
         filePtr->write(reinterpret_cast<const char *>(&this->header.pageSize), sizeof(page_size_t));
@@ -129,23 +217,79 @@ namespace Pages
         filePtr->write(reinterpret_cast<const char *>(&this->header.pageType), sizeof(PageType));
     }
 
-    void Page::WritePageToFile(fstream *filePtr)
+    void Page::WritePageToFile(ostream *filePtr)
     {
+        // not modified since it was read, the image goes back as it is
+        if (this->IsImageUnchanged())
+        {
+            this->WritePageHeaderToFile(filePtr);
+
+            const page_size_t pageHeaderSize = PageHeader::GetPageHeaderSize();
+
+            filePtr->write(this->pageImage.data() + pageHeaderSize, static_cast<streamsize>(this->pageImage.size() - pageHeaderSize));
+            return;
+        }
+
+        // rows of older formats are rewritten compact, which frees the space their headers took
+        if (!this->pageImage.empty() && this->imageRowFormat != RowFormat::COMPACT)
+        {
+            this->MaterializeRows();
+            this->RecalculateBytesLeft();
+        }
+
         this->WritePageHeaderToFile(filePtr);
 
-        for (const auto &row : this->rows)
+        const auto rowCount = static_cast<page_size_t>(this->rows.size());
+
+        auto rowOffset = static_cast<page_offset_t>(PageHeader::GetPageHeaderSize() + Page::GetSlotDirectoryHeaderSize() + rowCount * sizeof(page_offset_t));
+
+        filePtr->write(reinterpret_cast<const char *>(&COMPACT_ROW_PAGE_MAGIC), sizeof(uint32_t));
+        filePtr->write(reinterpret_cast<const char *>(&rowCount), sizeof(page_size_t));
+
+        for (page_size_t rowIndex = 0; rowIndex < rowCount; rowIndex++)
         {
-            RowHeader *rowHeader = row->GetHeader();
+            filePtr->write(reinterpret_cast<const char *>(&rowOffset), sizeof(page_offset_t));
+
+            const Row *row = this->rows[rowIndex];
+
+            rowOffset += (row != nullptr)
+                            ? Page::GetSerializedRowSize(row)
+                            : this->GetRowView(rowIndex).GetSerializedSize();
+        }
+
+        for (page_size_t rowIndex = 0; rowIndex < this->rows.size(); rowIndex++)
+        {
+            const Row *row = this->rows[rowIndex];
+
+            // rows never decoded are still in their serialized form
+            if (row == nullptr)
+            {
+                filePtr->write(this->pageImage.data() + this->rowOffsets[rowIndex], this->GetRowView(rowIndex).GetSerializedSize());
+                continue;
+            }
+
+            const RowHeader *rowHeader = row->GetHeader();
+
+            const auto numberOfColumns = static_cast<bit_map_size_t>(row->GetData().size());
+            const bool hasNulls = rowHeader->nullBitMap.HasAnySet();
+            const bool hasLargeObjects = rowHeader->largeObjectBitMap.HasAnySet();
+
+            const char flags = static_cast<char>((hasNulls ? COMPACT_ROW_HAS_NULLS : 0) | (hasLargeObjects ? COMPACT_ROW_HAS_LARGE_OBJECTS : 0));
+
+            RowView::WriteVarInt(filePtr, rowHeader->rowSize);
+            RowView::WriteVarInt(filePtr, numberOfColumns);
+            filePtr->write(&flags, sizeof(char));
+
+            if (hasNulls)
+                rowHeader->nullBitMap.WriteBitsToFile(filePtr, numberOfColumns);
 
-            filePtr->write(reinterpret_cast<const char *>(&rowHeader->rowSize), sizeof(row_size_t));
-            filePtr->write(reinterpret_cast<const char *>(&rowHeader->maxRowSize), sizeof(size_t));
-            rowHeader->nullBitMap->WriteDataToFile(filePtr);
-            rowHeader->largeObjectBitMap->WriteDataToFile(filePtr);
+            if (hasLargeObjects)
+                rowHeader->largeObjectBitMap.WriteBitsToFile(filePtr, numberOfColumns);
 
             column_index_t columnIndex = 0;
             for (const auto &block : row->GetData())
             {
-                if (rowHeader->nullBitMap->Get(columnIndex))
+                if (rowHeader->nullBitMap.Get(columnIndex))
                 {
                     columnIndex++;
                     continue;
@@ -153,7 +297,7 @@ namespace Pages
 
                 block_size_t dataSize = block->GetBlockSize();
 
-                filePtr->write(reinterpret_cast<const char *>(&dataSize), sizeof(block_size_t));
+                RowView::WriteVarInt(filePtr, dataSize);
 
                 const auto &data = block->GetBlockData();
 
@@ -164,25 +308,43 @@ namespace Pages
         }
     }
 
+    page_offset_t Page::GetSerializedRowSize(const Row *row)
+    {
+        // the row's total size also counts its slot directory entry
+        return static_cast<page_offset_t>(row->GetTotalRowSize() - sizeof(page_offset_t));
+    }
+
     void Page::SetFileName(const string &filename) { this->filename = filename; }
 
     void Page::SetPageId(const page_id_t &pageId) { this->header.pageId = pageId; }
 
-    void Page::UpdatePageSize() { this->header.pageSize = this->rows.size(); }
+    void Page::SetPageDirtyStatus(const bool &isDirty) { this->isDirty = isDirty; }
+
+    void Page::UpdatePageSize()
+    {
+        this->header.pageSize = this->rows.size();
+    }
 
     void Page::UpdateBytesLeft()
     {
-        this->header.bytesLeft = PAGE_SIZE - this->header.GetPageHeaderSize();
+        this->MaterializeRows();
+        this->RecalculateBytesLeft();
+
+        this->isDirty = true;
+    }
+
+    void Page::RecalculateBytesLeft()
+    {
+        this->header.bytesLeft = PAGE_SIZE - this->header.GetPageHeaderSize() - Page::GetSlotDirectoryHeaderSize();
 
         for (const auto &row : this->rows)
             this->header.bytesLeft -= row->GetTotalRowSize();
-
-        this->isDirty = true;
     }
 
     void Page::UpdateBytesLeft(const row_size_t& previousRowSize, const row_size_t& currentRowSize)
     {
-        this->header.bytesLeft += static_cast<int64_t>(currentRowSize) -static_cast<int64_t>(previousRowSize);
+        // a row that grew takes space from the page
+        this->header.bytesLeft += static_cast<int64_t>(previousRowSize) - static_cast<int64_t>(currentRowSize);
 
         this->isDirty = true;
     }
@@ -199,104 +361,165 @@ namespace Pages
 
     const PageType &Page::GetPageType() const { return this->header.pageType; }
 
-    void Page::UpdateRows(const vector<Block> *updates, const vector<Field> *conditions)
+    page_size_t Page::GetSlotDirectoryHeaderSize() { return sizeof(uint32_t) + sizeof(page_size_t); }
+
+    bool Page::HasRowView(const page_size_t &rowIndex) const { return this->rows[rowIndex] == nullptr; }
+
+    RowView Page::GetRowView(const page_size_t &rowIndex) const { return RowView(this->pageImage.data() + this->rowOffsets[rowIndex], this->imageRowFormat); }
+
+    Row *Page::GetRow(const page_size_t &rowIndex) { return this->MaterializeRow(rowIndex); }
+
+    const Row *Page::GetDecodedRow(const page_size_t &rowIndex) const { return this->rows[rowIndex]; }
+
+    bool Page::IsRowMatch(const page_size_t &rowIndex, const RowPredicate &predicate) const
     {
-        for (const auto &row : this->rows)
-        {
-            bool updateRow = false;
-            if (conditions != nullptr)
-            {
-                // for (const auto &condition : *conditions)
-                //     if (*condition != row->GetData()[condition->GetColumnIndex()])
-                //     {
-                //         updateRow = true;
-                //         break;
-                //     }
-
-                if (updateRow)
-                    continue;
-            }
-        }
+        return this->HasRowView(rowIndex)
+                ? predicate.Matches(this->GetRowView(rowIndex))
+                : predicate.Matches(this->rows[rowIndex]);
+    }
 
-        this->isDirty = true;
+    bool Page::HasMatchingRow(const RowPredicate &predicate) const
+    {
+        for (page_size_t rowIndex = 0; rowIndex < this->rows.size(); rowIndex++)
+            if (this->IsRowMatch(rowIndex, predicate))
+                return true;
+
+        return false;
     }
 
-    void Page::GetRows(vector<Row> *copiedRows, const Table &table, const size_t &rowsToSelect, const vector<Field> *conditions) const
+    void Page::GetRows(vector<Row> *copiedRows, const Table &table, const size_t &rowsToSelect, const vector<column_index_t> *selectedColumnIndices, const RowPredicate *predicate, Arenas::MonotonicArena *resultArena) const
     {
-        for (const auto &row : this->rows)
+        for (page_size_t rowIndex = 0; rowIndex < this->rows.size(); rowIndex++)
         {
             if (copiedRows->size() >= rowsToSelect)
                 return;
 
-            if (conditions != nullptr)
+            if (predicate != nullptr && !this->IsRowMatch(rowIndex, *predicate))
+                continue;
+
+            if (this->HasRowView(rowIndex))
             {
-                bool skipRow = false;
-                // for (const auto &condition : *conditions)
-                //     if (condition != row->GetData()[condition->GetColumnIndex()])
-                //     {
-                //         skipRow = true;
-                //         break;
-                //     }
-
-                if (skipRow)
-                    continue;
+                this->CopyRowView(copiedRows, table, this->GetRowView(rowIndex), selectedColumnIndices, resultArena);
+                continue;
             }
 
-            RowHeader *rowHeader = row->GetHeader();
+            Page::CopyRow(copiedRows, table, this->rows[rowIndex], selectedColumnIndices, resultArena);
+        }
+    }
 
-            vector<Block *> copyBlocks;
+    void Page::CopyRow(vector<Row> *copiedRows, const Table &table, const Row *row, const vector<column_index_t> *selectedColumnIndices, Arenas::MonotonicArena *resultArena)
+    {
+        const RowHeader *rowHeader = row->GetHeader();
 
-            for (const auto &block : row->GetData())
-            {
-                Block *blockCopy = new Block(block);
-                if (rowHeader->largeObjectBitMap->Get(block->GetColumnIndex()))
-                {
-                    DataObjectPointer objectPointer;
-                    memcpy(&objectPointer, block->GetBlockData(), sizeof(DataObjectPointer));
+        const auto &rowData = row->GetData();
 
-                    uint32_t objectSize;
-                    unsigned char *largeValue = row->GetLargeObjectValue(objectPointer, &objectSize);
-                    blockCopy->SetData(largeValue, objectSize);
+        vector<Block *> copyBlocks;
 
-                    delete[] largeValue;
-                }
+        const size_t numberOfColumns = (selectedColumnIndices != nullptr) ? selectedColumnIndices->size() : rowData.size();
+
+        for (size_t i = 0; i < numberOfColumns; i++)
+        {
+            const auto &block = rowData[(selectedColumnIndices != nullptr) ? (*selectedColumnIndices)[i] : i];
+
+            Block *blockCopy = new Block(block);
+            if (rowHeader->largeObjectBitMap.Get(block->GetColumnIndex()))
+            {
+                DataObjectPointer objectPointer;
+                memcpy(&objectPointer, block->GetBlockData(), sizeof(DataObjectPointer));
+
+                uint32_t objectSize;
+                unsigned char *largeValue = row->GetLargeObjectValue(objectPointer, &objectSize);
+                blockCopy->SetData(largeValue, objectSize);
 
-                copyBlocks.push_back(blockCopy);
+                delete[] largeValue;
             }
-            copiedRows->emplace_back(table, copyBlocks, rowHeader->nullBitMap);
+
+            copyBlocks.push_back(blockCopy);
         }
+
+        copiedRows->emplace_back(table, copyBlocks, &rowHeader->nullBitMap, resultArena);
+
+        // the row keeps copies of its own
+        for (const auto &copyBlock : copyBlocks)
+            delete copyBlock;
     }
 
-    void Page::GetRowByIndex(vector<Row>*& rows, const Table &table, const int &indexPosition, const vector<column_index_t>& selectedColumnIndices) const
+    void Page::CopyRowView(vector<Row> *copiedRows, const Table &table, const RowView &rowView, const vector<column_index_t> *selectedColumnIndices, Arenas::MonotonicArena *resultArena) const
     {
-        const auto &row = this->rows[indexPosition];
-
-        const RowHeader *rowHeader = row->GetHeader();
+        const auto &columns = table.GetColumns();
 
         vector<Block *> copyBlocks;
 
-        const auto& rowData = row->GetData();
-        for(const auto& columnIndex: selectedColumnIndices)
+        const size_t numberOfColumns = (selectedColumnIndices != nullptr) ? selectedColumnIndices->size() : columns.size();
+
+        size_t lastColumnIndex = 0;
+        for (size_t i = 0; i < numberOfColumns; i++)
+            lastColumnIndex = max<size_t>(lastColumnIndex, (selectedColumnIndices != nullptr) ? (*selectedColumnIndices)[i] : i);
+
+        // one pass over the row up to the last selected column finds them all, the columns after it are never read
+        const object_t *columnData[numeric_limits<column_index_t>::max() + 1];
+        block_size_t columnSizes[numeric_limits<column_index_t>::max() + 1];
+
+        const char *column = rowView.GetFirstColumn();
+
+        for (size_t j = 0; j <= lastColumnIndex; j++)
         {
-            const auto& block = rowData[columnIndex];
+            columnData[j] = nullptr;
+            columnSizes[j] = 0;
 
-            Block *blockCopy = new Block(block);
-            if (rowHeader->largeObjectBitMap->Get(block->GetColumnIndex()))
+            if (j >= rowView.GetNumberOfColumns() || rowView.IsNull(j))
+                continue;
+
+            columnData[j] = rowView.ReadColumn(column, columnSizes[j]);
+        }
+
+        for (size_t i = 0; i < numberOfColumns; i++)
+        {
+            const column_index_t columnIndex = (selectedColumnIndices != nullptr) ? (*selectedColumnIndices)[i] : static_cast<column_index_t>(i);
+
+            const block_size_t blockSize = columnSizes[columnIndex];
+            const object_t *blockData = columnData[columnIndex];
+
+            if (blockData != nullptr && rowView.IsLargeObject(columnIndex))
             {
                 DataObjectPointer objectPointer;
-                memcpy(&objectPointer, block->GetBlockData(), sizeof(DataObjectPointer));
+                memcpy(&objectPointer, blockData, sizeof(DataObjectPointer));
 
                 uint32_t objectSize;
-                const unsigned char *largeValue = row->GetLargeObjectValue(objectPointer, &objectSize);
-                blockCopy->SetData(largeValue, objectSize);
+                unsigned char *largeValue = Row::GetLargeObjectValue(table, objectPointer, &objectSize);
+
+                Block *block = new Block(columns[columnIndex]);
+                block->SetData(largeValue, objectSize);
 
                 delete[] largeValue;
+
+                copyBlocks.push_back(block);
+                continue;
             }
 
-            copyBlocks.push_back(blockCopy);
+            copyBlocks.push_back(new Block(blockData, blockSize, columns[columnIndex]));
+        }
+
+        ByteMaps::InlineBitSet nullBitMap(rowView.GetNumberOfColumns());
+
+        for (bit_map_pos_t i = 0; i < rowView.GetNumberOfColumns(); i++)
+            nullBitMap.Set(i, rowView.IsNull(i));
+
+        copiedRows->emplace_back(table, copyBlocks, &nullBitMap, resultArena);
+
+        for (const auto &copyBlock : copyBlocks)
+            delete copyBlock;
+    }
+
+    void Page::GetRowByIndex(vector<Row>*& rows, const Table &table, const int &indexPosition, const vector<column_index_t>& selectedColumnIndices, Arenas::MonotonicArena *resultArena) const
+    {
+        if (this->HasRowView(indexPosition))
+        {
+            this->CopyRowView(rows, table, this->GetRowView(indexPosition), &selectedColumnIndices, resultArena);
+            return;
         }
 
-        rows->emplace_back(table, copyBlocks, rowHeader->nullBitMap);
+        Page::CopyRow(rows, table, this->rows[indexPosition], &selectedColumnIndices, resultArena);
     }
 
     void Page::SplitPageRowByBranchingFactor(Page *nextLeafPage, const int &branchingFactor, const Table &table)
@@ -304,61 +527,79 @@ namespace Pages
         if (table.GetTableType() != TableType::CLUSTERED)
             return;
 
+        this->MaterializeRows();
+
         vector<Row *> *nextLeafPageDataRows = nextLeafPage->GetDataRowsUnsafe();
 
         nextLeafPageDataRows->assign(this->rows.begin() + branchingFactor, this->rows.end());
+        nextLeafPage->rowOffsets.assign(nextLeafPageDataRows->size(), 0);
+
+        if (this->rowArena != nullptr)
+            nextLeafPage->adoptedRowArenas.push_back(this->rowArena);
+
+        nextLeafPage->adoptedRowArenas.insert(nextLeafPage->adoptedRowArenas.end(), this->adoptedRowArenas.begin(), this->adoptedRowArenas.end());
 
         nextLeafPage->UpdatePageSize();
         nextLeafPage->UpdateBytesLeft();
 
         this->rows.resize(branchingFactor);
+        this->rowOffsets.resize(branchingFactor);
 
         this->UpdatePageSize();
         this->UpdateBytesLeft();
     }
 
-    vector<DatabaseEngine::StorageTypes::Row *>* Page::GetDataRowsUnsafe() { return &this->rows; }
+    void Page::SetRowArenaEnabled(const bool &isEnabled) { isRowArenaEnabled.store(isEnabled, memory_order_relaxed); }
 
-    void Page::UpdateRows(const vector<Block*> *updates, const vector<Field> *conditions)
+    vector<DatabaseEngine::StorageTypes::Row *>* Page::GetDataRowsUnsafe()
     {
-        //add condition checking prior to update
+        this->MaterializeRows();
+
+        return &this->rows;
+    }
+
+    void Page::UpdateRows(const vector<Block*> *updates, const RowPredicate *predicate)
+    {
+        // a page none of whose rows match is left as it was read
+        if (predicate != nullptr && !this->HasMatchingRow(*predicate))
+            return;
+
+        this->MaterializeRows();
+
         for (auto &row : this->rows)
         {
+            if (row == nullptr || (predicate != nullptr && !predicate->Matches(row)))
+                continue;
+
             RowHeader *rowHeader = row->GetHeader();
-            
-            vector<Block*> rowData = row->GetData();
+
+            const row_size_t previousRowSize = row->GetTotalRowSize();
+
+            const vector<Block*>& rowData = row->GetData();
 
             for(const auto& update: *updates)
             {
                 const auto& columnIndex = update->GetColumnIndex();
 
-                if (rowHeader->largeObjectBitMap->Get(columnIndex))
+                if (rowHeader->largeObjectBitMap.Get(columnIndex))
                 {
                     //set lob objects
 
                     continue;
                 }
 
-                if(row)
+                Block *block = rowData[columnIndex];
 
-                rowData[columnIndex]->SetData(update->GetBlockData(), update->GetBlockSize());
-            }
+                rowHeader->rowSize -= block->GetBlockSize();
 
-            for (const auto &block : row->GetData())
-            {
-                Block *blockCopy = new Block(block);
-                if (rowHeader->largeObjectBitMap->Get(block->GetColumnIndex()))
-                {
-                    DataObjectPointer objectPointer;
-                    memcpy(&objectPointer, block->GetBlockData(), sizeof(DataObjectPointer));
-
-                    uint32_t objectSize;
-                    unsigned char *largeValue = row->GetLargeObjectValue(objectPointer, &objectSize);
-                    blockCopy->SetData(largeValue, objectSize);
+                block->SetData(update->GetBlockData(), update->GetBlockSize());
 
-                    delete[] largeValue;
-                }
+                rowHeader->rowSize += block->GetBlockSize();
+                rowHeader->nullBitMap.Set(columnIndex, update->GetBlockData() == nullptr);
             }
+
+            //it sets dirty to true
+            this->UpdateBytesLeft(previousRowSize, row->GetTotalRowSize());
         }
     }
 }
@@ -1,7 +1,10 @@
 #pragma once
+#include <memory>
 #include <vector>
+#include <span>
 #include <string>
 #include "../Constants.h"
+#include "../../AdditionalLibraries/MonotonicArena/MonotonicArena.h"
 #include "../../AdditionalLibraries/AdditionalDataTypes/Field/Field.h"
 
 class RowCondition;
@@ -13,6 +16,8 @@ namespace DatabaseEngine::StorageTypes
 {
     class Block;
     class Row;
+    class RowPredicate;
+    class RowView;
     class Table;
 }
 
@@ -30,15 +35,34 @@ namespace Pages
         static page_size_t GetPageHeaderSize();
     } PageHeader;
 
+    // data pages are slotted: header | COMPACT_ROW_PAGE_MAGIC | row count | row offsets | compact rows
+    // pages carrying SLOTTED_PAGE_MAGIC or no magic at all hold FIXED_HEADER rows, they are still read and are rewritten compact once modified
+    // a page read from disk keeps its image and is read through RowViews, a row is deserialized the first time it is asked for
     class Page
     {
+        // nullptr until decoded, the row then lives at rowOffsets[index] in pageImage
         vector<DatabaseEngine::StorageTypes::Row *> rows;
+        vector<char> pageImage;
+        vector<page_offset_t> rowOffsets;
+        // decoded rows are carved from it and freed with it, rows split off to another page keep this arena alive there
+        shared_ptr<Arenas::MonotonicArena> rowArena;
+        vector<shared_ptr<Arenas::MonotonicArena>> adoptedRowArenas;
+        const DatabaseEngine::StorageTypes::Table *table;
+        // format of the rows in pageImage
+        RowFormat imageRowFormat;
 
     protected:
         bool isDirty;
         string filename;
         PageHeader header;
-        void WritePageHeaderToFile(fstream *filePtr) const;
+        void WritePageHeaderToFile(ostream *filePtr) const;
+        void MaterializeRows();
+        DatabaseEngine::StorageTypes::Row *MaterializeRow(const page_size_t &rowIndex);
+        [[nodiscard]] bool IsImageUnchanged() const;
+        void RecalculateBytesLeft();
+        static void CopyRow(vector<DatabaseEngine::StorageTypes::Row> *copiedRows, const DatabaseEngine::StorageTypes::Table &table, const DatabaseEngine::StorageTypes::Row *row, const vector<column_index_t> *selectedColumnIndices, Arenas::MonotonicArena *resultArena);
+        void CopyRowView(vector<DatabaseEngine::StorageTypes::Row> *copiedRows, const DatabaseEngine::StorageTypes::Table &table, const DatabaseEngine::StorageTypes::RowView &rowView, const vector<column_index_t> *selectedColumnIndices, Arenas::MonotonicArena *resultArena) const;
+        static page_offset_t GetSerializedRowSize(const DatabaseEngine::StorageTypes::Row *row);
 
     public:
         explicit Page(const page_id_t &pageId, const bool &isPageCreation = false);
@@ -49,13 +73,13 @@ namespace Pages
         void InsertRow(DatabaseEngine::StorageTypes::Row *row, int* indexPosition = nullptr);
         void InsertRow(DatabaseEngine::StorageTypes::Row *row, const int& indexPosition);
         void DeleteRow(DatabaseEngine::StorageTypes::Row *row);
-        void UpdateRows(const vector<DatabaseEngine::StorageTypes::Block> *updates, const vector<Field> *conditions);
 
-        virtual void GetPageDataFromFile(const vector<char> &data, const DatabaseEngine::StorageTypes::Table *table, page_offset_t &offSet, fstream *filePtr);
-        virtual void WritePageToFile(fstream *filePtr);
+        virtual void GetPageDataFromFile(const span<const char> &data, const DatabaseEngine::StorageTypes::Table *table, page_offset_t &offSet, fstream *filePtr);
+        virtual void WritePageToFile(ostream *filePtr);
 
         void SetFileName(const string &filename);
         void SetPageId(const page_id_t &pageId);
+        void SetPageDirtyStatus(const bool &isDirty);
         void UpdatePageSize();
         virtual void UpdateBytesLeft();
         void UpdateBytesLeft(const row_size_t& previousRowSize, const row_size_t& currentRowSize);
@@ -65,13 +89,28 @@ namespace Pages
         [[nodiscard]] const bool &GetPageDirtyStatus() const;
         [[nodiscard]] const page_size_t &GetBytesLeft() const;
 
-        void GetRows(vector<DatabaseEngine::StorageTypes::Row> *copiedRows, const DatabaseEngine::StorageTypes::Table &table, const size_t &rowsToSelect, const vector<Field> *conditions = nullptr) const;
-        void UpdateRows(const vector<DatabaseEngine::StorageTypes::Block*>* updates, const vector<Field> *conditions = nullptr);
+        // only the selected columns are read and copied, every column when selectedColumnIndices is nullptr
+        // rows the predicate rejects are skipped before anything is copied, a nullptr predicate matches every row
+        void GetRows(vector<DatabaseEngine::StorageTypes::Row> *copiedRows, const DatabaseEngine::StorageTypes::Table &table, const size_t &rowsToSelect, const vector<column_index_t> *selectedColumnIndices, const DatabaseEngine::StorageTypes::RowPredicate *predicate = nullptr, Arenas::MonotonicArena *resultArena = nullptr) const;
+        void UpdateRows(const vector<DatabaseEngine::StorageTypes::Block*>* updates, const DatabaseEngine::StorageTypes::RowPredicate *predicate = nullptr);
+        // checked through the views, rows are not decoded for it
+        [[nodiscard]] bool HasMatchingRow(const DatabaseEngine::StorageTypes::RowPredicate &predicate) const;
+        [[nodiscard]] bool IsRowMatch(const page_size_t &rowIndex, const DatabaseEngine::StorageTypes::RowPredicate &predicate) const;
 
         [[nodiscard]] page_size_t GetPageSize() const;
+        [[nodiscard]] static page_size_t GetSlotDirectoryHeaderSize();
+
+        // a row has a view as long as it has not been decoded, decoded rows may have been modified in place
+        [[nodiscard]] bool HasRowView(const page_size_t &rowIndex) const;
+        [[nodiscard]] DatabaseEngine::StorageTypes::RowView GetRowView(const page_size_t &rowIndex) const;
+        [[nodiscard]] DatabaseEngine::StorageTypes::Row *GetRow(const page_size_t &rowIndex);
+        // nullptr while the row is still read through its view
+        [[nodiscard]] const DatabaseEngine::StorageTypes::Row *GetDecodedRow(const page_size_t &rowIndex) const;
         [[nodiscard]] const PageType &GetPageType() const;
-        void GetRowByIndex(vector<DatabaseEngine::StorageTypes::Row>*& rows, const DatabaseEngine::StorageTypes::Table &table, const int &indexPosition, const vector<column_index_t>& selectedColumnIndices) const;
+        void GetRowByIndex(vector<DatabaseEngine::StorageTypes::Row>*& rows, const DatabaseEngine::StorageTypes::Table &table, const int &indexPosition, const vector<column_index_t>& selectedColumnIndices, Arenas::MonotonicArena *resultArena = nullptr) const;
         [[nodiscard]] vector<DatabaseEngine::StorageTypes::Row *> *GetDataRowsUnsafe();
+        // on by default, off decodes every row object on the heap as before, kept to compare the two
+        static void SetRowArenaEnabled(const bool &isEnabled);
         void SplitPageRowByBranchingFactor(Page *nextLeafPage, const int &branchingFactor, const DatabaseEngine::StorageTypes::Table &table);
     };
 }
\ No newline at end of file
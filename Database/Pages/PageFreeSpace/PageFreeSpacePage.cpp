@@ -66,12 +66,12 @@ namespace Pages {
         this->isDirty = true;
     }
 
-    void PageFreeSpacePage::GetPageDataFromFile(const vector<char> &data, const Table *table, page_offset_t &offSet,fstream *filePtr)
+    void PageFreeSpacePage::GetPageDataFromFile(const span<const char> &data, const Table *table, page_offset_t &offSet,fstream *filePtr)
     {
         this->pageMap->GetDataFromFile(data, offSet, this->header.pageSize);
     }
 
-    void PageFreeSpacePage::WritePageToFile(fstream *filePtr)
+    void PageFreeSpacePage::WritePageToFile(ostream *filePtr)
     {
         this->WritePageHeaderToFile(filePtr);
 
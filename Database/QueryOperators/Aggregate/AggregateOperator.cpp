@@ -0,0 +1,147 @@
+#include "AggregateOperator.h"
+#include <limits>
+#include "../../AdditionalFunctions/AggregateFunctions/AggregateFunctions.h"
+
+using namespace DatabaseEngine::StorageTypes;
+
+namespace QueryOperators {
+    AggregateOperator::Group::Group(const Row &row) : row(row)
+    {
+        this->rowCount = 0;
+        this->averageSum = 0;
+        this->results.min = numeric_limits<long double>::max();
+        this->results.max = numeric_limits<long double>::lowest();
+    }
+
+    AggregateOperator::AggregateOperator(QueryOperator *child, const vector<GroupCondition> &groupConditions)
+        : QueryOperator(child)
+    {
+        this->groupConditions = groupConditions;
+        this->groupPosition = 0;
+        this->isAggregated = false;
+    }
+
+    AggregateOperator::~AggregateOperator() = default;
+
+    void AggregateOperator::Open()
+    {
+        this->groupPositions.clear();
+        this->groups.clear();
+        this->groupPosition = 0;
+        this->isAggregated = false;
+
+        QueryOperator::Open();
+    }
+
+    void AggregateOperator::AggregateChildRows()
+    {
+        const Row *row;
+
+        while (this->child->Next(row))
+        {
+            const auto [groupIterator, isNewGroup] = this->groupPositions.try_emplace(SortingFunctions::CreateGroupByKey(row, this->groupConditions), this->groups.size());
+
+            if (isNewGroup)
+                this->groups.emplace_back(*row);
+
+            this->AddRowToGroup(this->groups[groupIterator->second], row);
+        }
+
+        for (auto &group : this->groups)
+            this->FinishGroup(group);
+
+        this->isAggregated = true;
+    }
+
+    void AggregateOperator::AddRowToGroup(Group &group, const Row *row) const
+    {
+        group.rowCount++;
+
+        for (const auto &condition : this->groupConditions)
+        {
+            const Block *block = row->GetData()[condition.GetColumnIndex()];
+
+            switch (condition.GetAggregateFunction())
+            {
+                case NONE:
+                case COUNT:
+                default:
+                    if (!row->GetNullBitMapValue(condition.GetColumnIndex()))
+                        group.results.count++;
+                    break;
+                case SUM:
+                    AggregateFunctions::SumByColumnType(group.results.sum, block);
+                    break;
+                case AVERAGE:
+                    AggregateFunctions::SumByColumnType(group.averageSum, block);
+                    break;
+                case MIN:
+                    AggregateFunctions::CompareMinWithRow(group.results.min, block);
+                    break;
+                case MAX:
+                    AggregateFunctions::CompareMaxWithRow(group.results.max, block);
+                    break;
+            }
+        }
+    }
+
+    void AggregateOperator::FinishGroup(Group &group) const
+    {
+        // constant values replace whatever was folded, as they do in the AggregateFunctions over whole groups
+        for (const auto &condition : this->groupConditions)
+        {
+            const long double *constantValue = condition.GetConstantValue();
+
+            switch (condition.GetAggregateFunction())
+            {
+                case NONE:
+                case COUNT:
+                default:
+                    if (constantValue != nullptr)
+                        group.results.count = group.rowCount;
+                    break;
+                case SUM:
+                    if (constantValue != nullptr)
+                        group.results.sum = *constantValue;
+                    break;
+                case MIN:
+                    if (constantValue != nullptr)
+                        group.results.min = *constantValue;
+                    break;
+                case MAX:
+                    if (constantValue != nullptr)
+                        group.results.max = *constantValue;
+                    break;
+                case AVERAGE:
+                    group.results.average = (constantValue != nullptr)
+                                            ? *constantValue
+                                            : group.averageSum / static_cast<long double>(group.rowCount);
+                    break;
+            }
+        }
+    }
+
+    bool AggregateOperator::Next(const Row *&row)
+    {
+        if (!this->isAggregated)
+            this->AggregateChildRows();
+
+        if (this->groupPosition >= this->groups.size())
+            return false;
+
+        row = &this->groups[this->groupPosition].row;
+        this->groupPosition++;
+
+        return true;
+    }
+
+    void AggregateOperator::Close()
+    {
+        this->groupPositions = unordered_map<string, size_t>();
+        this->groups = vector<Group>();
+
+        QueryOperator::Close();
+    }
+
+    const AggregateResults &AggregateOperator::GetAggregateResults() const { return this->groups[this->groupPosition - 1].results; }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../QueryOperator.h"
+#include "../../AdditionalFunctions/SortingFunctions.h"
+#include "../../Row/Row.h"
+#include "../../../AdditionalLibraries/AdditionalDataTypes/GroupCondition/GroupCondition.h"
+
+namespace QueryOperators {
+    using namespace std;
+
+    // blocking hash aggregate: the first Next folds every row of its child into its group, grouped by the columns of the conditions as GroupBy does
+    // only the first row and the running aggregates of each group are kept, a group's row is handed out with its results in GetAggregateResults
+    class AggregateOperator final : public QueryOperator {
+        typedef struct Group
+        {
+            DatabaseEngine::StorageTypes::Row row;
+            AggregateResults results;
+            uint64_t rowCount;
+            long double averageSum;
+
+            explicit Group(const DatabaseEngine::StorageTypes::Row &row);
+        } Group;
+
+        vector<GroupCondition> groupConditions;
+        unordered_map<string, size_t> groupPositions;
+        vector<Group> groups;
+        size_t groupPosition;
+        bool isAggregated;
+
+    protected:
+        void AggregateChildRows();
+        void AddRowToGroup(Group &group, const DatabaseEngine::StorageTypes::Row *row) const;
+        void FinishGroup(Group &group) const;
+
+    public:
+        AggregateOperator(QueryOperator *child, const vector<GroupCondition> &groupConditions);
+        ~AggregateOperator() override;
+
+        void Open() override;
+        [[nodiscard]] bool Next(const DatabaseEngine::StorageTypes::Row *&row) override;
+        void Close() override;
+
+        // results of the group whose row the last Next handed out
+        [[nodiscard]] const AggregateResults &GetAggregateResults() const;
+    };
+}
@@ -0,0 +1,305 @@
+#include "BatchAggregateOperator.h"
+#include <limits>
+#include <stdexcept>
+
+namespace QueryOperators {
+    BatchAggregateOperator::Group::Group()
+    {
+        this->rowCount = 0;
+        this->averageSum = 0;
+        this->results.min = numeric_limits<long double>::max();
+        this->results.max = numeric_limits<long double>::lowest();
+    }
+
+    BatchAggregateOperator::BatchAggregateOperator(BatchOperator *child, const vector<GroupCondition> &groupConditions)
+        : BatchOperator(child)
+    {
+        this->groupConditions = groupConditions;
+        this->groupBatchPosition = 0;
+        this->isAggregated = false;
+        this->rowGroupIds.reserve(BATCH_SIZE);
+    }
+
+    BatchAggregateOperator::~BatchAggregateOperator() = default;
+
+    void BatchAggregateOperator::Open()
+    {
+        this->conditionColumnPositions.clear();
+        this->groupIds.clear();
+        this->groups.clear();
+        this->groupBatches.clear();
+        this->groupBatchPosition = 0;
+        this->isAggregated = false;
+
+        BatchOperator::Open();
+    }
+
+    void BatchAggregateOperator::AggregateChildBatches()
+    {
+        RowBatch *batch;
+
+        while (this->child->Next(batch))
+        {
+            if (batch->GetSelection().empty())
+                continue;
+
+            if (this->conditionColumnPositions.empty())
+                for (const auto &condition : this->groupConditions)
+                {
+                    const int columnPosition = batch->FindColumn(condition.GetColumnIndex());
+
+                    if (columnPosition < 0)
+                        throw invalid_argument("BatchAggregateOperator::AggregateChildBatches: Condition column is not in the batch");
+
+                    this->conditionColumnPositions.push_back(columnPosition);
+                }
+
+            const bool isSingleGroup = this->AssignGroups(*batch);
+
+            for (size_t i = 0; i < this->groupConditions.size(); i++)
+                this->FoldCondition(*batch, i, isSingleGroup);
+        }
+
+        for (auto &group : this->groups)
+            this->FinishGroup(group);
+
+        this->isAggregated = true;
+    }
+
+    bool BatchAggregateOperator::AssignGroups(const RowBatch &batch)
+    {
+        const vector<uint16_t> &selection = batch.GetSelection();
+
+        this->rowGroupIds.resize(selection.size());
+        this->previousKey.clear();
+
+        bool isSingleGroup = true;
+        uint32_t previousGroupId = 0;
+
+        for (size_t i = 0; i < selection.size(); i++)
+        {
+            this->key.clear();
+
+            for (const auto &columnPosition : this->conditionColumnPositions)
+                batch.GetColumn(columnPosition).AppendKeyBytes(this->key, selection[i]);
+
+            // rows of a group often come one after another, those skip the hash lookup
+            if (i > 0 && this->key == this->previousKey)
+            {
+                this->rowGroupIds[i] = previousGroupId;
+                this->groups[previousGroupId].rowCount++;
+                continue;
+            }
+
+            const auto [groupIterator, isNewGroup] = this->groupIds.try_emplace(this->key, static_cast<uint32_t>(this->groups.size()));
+
+            if (isNewGroup)
+            {
+                this->groups.emplace_back();
+
+                if (this->groupBatches.empty() || this->groupBatches.back()->IsFull())
+                    this->groupBatches.push_back(make_unique<RowBatch>(batch.GetTable(), batch.GetColumnIndices()));
+
+                this->groupBatches.back()->AppendRow(batch, selection[i]);
+            }
+
+            isSingleGroup = isSingleGroup && (i == 0 || groupIterator->second == previousGroupId);
+
+            previousGroupId = groupIterator->second;
+            this->previousKey.swap(this->key);
+
+            this->rowGroupIds[i] = previousGroupId;
+            this->groups[previousGroupId].rowCount++;
+        }
+
+        return isSingleGroup;
+    }
+
+    void BatchAggregateOperator::FoldCondition(const RowBatch &batch, const size_t &conditionIndex, const bool &isSingleGroup)
+    {
+        const ColumnVector &column = batch.GetColumn(this->conditionColumnPositions[conditionIndex]);
+        const AggregateFunction &aggregateFunction = this->groupConditions[conditionIndex].GetAggregateFunction();
+        const vector<uint16_t> &selection = batch.GetSelection();
+
+        switch (column.GetVectorType())
+        {
+            case VectorType::INT32:
+                this->FoldValues(column.GetInt32Values(), column.GetNulls(), selection, aggregateFunction, isSingleGroup);
+                break;
+            case VectorType::INT64:
+                this->FoldValues(column.GetInt64Values(), column.GetNulls(), selection, aggregateFunction, isSingleGroup);
+                break;
+            case VectorType::DATE_TIME:
+                this->FoldValues(column.GetDateTimeValues(), column.GetNulls(), selection, aggregateFunction, isSingleGroup);
+                break;
+            case VectorType::STRING:
+            {
+                if (aggregateFunction != NONE && aggregateFunction != COUNT)
+                    throw invalid_argument("BatchAggregateOperator::FoldCondition: Only COUNT is supported over string columns");
+
+                // only the null flags are read, the values of the column do not matter to a count
+                this->FoldValues(column.GetNulls(), column.GetNulls(), selection, aggregateFunction, isSingleGroup);
+                break;
+            }
+        }
+    }
+
+    template<typename T>
+    void BatchAggregateOperator::FoldValues(const T *values, const uint8_t *nulls, const vector<uint16_t> &selection, const AggregateFunction &aggregateFunction, const bool &isSingleGroup)
+    {
+        const uint16_t *positions = selection.data();
+        const size_t size = selection.size();
+
+        // a batch of a single group folds into locals and touches its group once
+        if (isSingleGroup)
+        {
+            Group &group = this->groups[this->rowGroupIds[0]];
+
+            switch (aggregateFunction)
+            {
+                case NONE:
+                case COUNT:
+                default:
+                {
+                    uint64_t count = 0;
+                    for (size_t i = 0; i < size; i++)
+                        count += nulls[positions[i]] == 0;
+
+                    group.results.count += count;
+                    break;
+                }
+                case SUM:
+                case AVERAGE:
+                {
+                    long double sum = 0;
+                    for (size_t i = 0; i < size; i++)
+                        sum += (nulls[positions[i]] == 0) ? values[positions[i]] : 0;
+
+                    (aggregateFunction == SUM ? group.results.sum : group.averageSum) += sum;
+                    break;
+                }
+                case MIN:
+                {
+                    long double min = group.results.min;
+                    for (size_t i = 0; i < size; i++)
+                        if (nulls[positions[i]] == 0 && values[positions[i]] < min)
+                            min = values[positions[i]];
+
+                    group.results.min = min;
+                    break;
+                }
+                case MAX:
+                {
+                    long double max = group.results.max;
+                    for (size_t i = 0; i < size; i++)
+                        if (nulls[positions[i]] == 0 && values[positions[i]] > max)
+                            max = values[positions[i]];
+
+                    group.results.max = max;
+                    break;
+                }
+            }
+
+            return;
+        }
+
+        const uint32_t *rowGroupIds = this->rowGroupIds.data();
+        Group *groups = this->groups.data();
+
+        switch (aggregateFunction)
+        {
+            case NONE:
+            case COUNT:
+            default:
+                for (size_t i = 0; i < size; i++)
+                    groups[rowGroupIds[i]].results.count += nulls[positions[i]] == 0;
+                break;
+            case SUM:
+                for (size_t i = 0; i < size; i++)
+                    if (nulls[positions[i]] == 0)
+                        groups[rowGroupIds[i]].results.sum += values[positions[i]];
+                break;
+            case AVERAGE:
+                for (size_t i = 0; i < size; i++)
+                    if (nulls[positions[i]] == 0)
+                        groups[rowGroupIds[i]].averageSum += values[positions[i]];
+                break;
+            case MIN:
+                for (size_t i = 0; i < size; i++)
+                    if (nulls[positions[i]] == 0 && values[positions[i]] < groups[rowGroupIds[i]].results.min)
+                        groups[rowGroupIds[i]].results.min = values[positions[i]];
+                break;
+            case MAX:
+                for (size_t i = 0; i < size; i++)
+                    if (nulls[positions[i]] == 0 && values[positions[i]] > groups[rowGroupIds[i]].results.max)
+                        groups[rowGroupIds[i]].results.max = values[positions[i]];
+                break;
+        }
+    }
+
+    void BatchAggregateOperator::FinishGroup(Group &group) const
+    {
+        // constant values replace whatever was folded, as they do in AggregateOperator
+        for (const auto &condition : this->groupConditions)
+        {
+            const long double *constantValue = condition.GetConstantValue();
+
+            switch (condition.GetAggregateFunction())
+            {
+                case NONE:
+                case COUNT:
+                default:
+                    if (constantValue != nullptr)
+                        group.results.count = group.rowCount;
+                    break;
+                case SUM:
+                    if (constantValue != nullptr)
+                        group.results.sum = *constantValue;
+                    break;
+                case MIN:
+                    if (constantValue != nullptr)
+                        group.results.min = *constantValue;
+                    break;
+                case MAX:
+                    if (constantValue != nullptr)
+                        group.results.max = *constantValue;
+                    break;
+                case AVERAGE:
+                    group.results.average = (constantValue != nullptr)
+                                            ? *constantValue
+                                            : group.averageSum / static_cast<long double>(group.rowCount);
+                    break;
+            }
+        }
+    }
+
+    bool BatchAggregateOperator::Next(RowBatch *&batch)
+    {
+        if (!this->isAggregated)
+            this->AggregateChildBatches();
+
+        if (this->groupBatchPosition >= this->groupBatches.size())
+            return false;
+
+        batch = this->groupBatches[this->groupBatchPosition].get();
+        this->groupBatchPosition++;
+
+        return true;
+    }
+
+    void BatchAggregateOperator::Close()
+    {
+        this->groupIds = unordered_map<string, uint32_t>();
+        this->groups = vector<Group>();
+        this->groupBatches = vector<unique_ptr<RowBatch>>();
+
+        BatchOperator::Close();
+    }
+
+    const AggregateResults &BatchAggregateOperator::GetAggregateResults(const size_t &position) const
+    {
+        return this->groups[(this->groupBatchPosition - 1) * BATCH_SIZE + position].results;
+    }
+
+    size_t BatchAggregateOperator::GetNumberOfGroups() const { return this->groups.size(); }
+}
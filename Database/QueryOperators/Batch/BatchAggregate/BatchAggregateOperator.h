@@ -0,0 +1,60 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../BatchOperator.h"
+#include "../RowBatch.h"
+#include "../../../AdditionalFunctions/SortingFunctions.h"
+#include "../../../../AdditionalLibraries/AdditionalDataTypes/GroupCondition/GroupCondition.h"
+
+namespace QueryOperators {
+    using namespace std;
+
+    // blocking hash aggregate over batches, grouped by the columns of the conditions as GroupBy does, the column index of a condition is the table's
+    // every batch is first mapped to group ids row by row, then each condition is folded in a loop over the typed values of its column
+    // the first row of every group is handed out in batches, GetAggregateResults gives the results of a group by its position in the last one
+    class BatchAggregateOperator final : public BatchOperator {
+        typedef struct Group
+        {
+            AggregateResults results;
+            uint64_t rowCount;
+            long double averageSum;
+
+            Group();
+        } Group;
+
+        vector<GroupCondition> groupConditions;
+        vector<int> conditionColumnPositions;
+        unordered_map<string, uint32_t> groupIds;
+        vector<Group> groups;
+        vector<unique_ptr<RowBatch>> groupBatches;
+        // group of every selected row of the batch being folded
+        vector<uint32_t> rowGroupIds;
+        string key;
+        string previousKey;
+        size_t groupBatchPosition;
+        bool isAggregated;
+
+    protected:
+        void AggregateChildBatches();
+        // true when every selected row of the batch falls into the same group
+        bool AssignGroups(const RowBatch &batch);
+        void FoldCondition(const RowBatch &batch, const size_t &conditionIndex, const bool &isSingleGroup);
+        void FinishGroup(Group &group) const;
+
+        template<typename T>
+        void FoldValues(const T *values, const uint8_t *nulls, const vector<uint16_t> &selection, const AggregateFunction &aggregateFunction, const bool &isSingleGroup);
+
+    public:
+        BatchAggregateOperator(BatchOperator *child, const vector<GroupCondition> &groupConditions);
+        ~BatchAggregateOperator() override;
+
+        void Open() override;
+        [[nodiscard]] bool Next(RowBatch *&batch) override;
+        void Close() override;
+
+        [[nodiscard]] const AggregateResults &GetAggregateResults(const size_t &position) const;
+        [[nodiscard]] size_t GetNumberOfGroups() const;
+    };
+}
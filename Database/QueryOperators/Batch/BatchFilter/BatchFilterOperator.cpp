@@ -0,0 +1,268 @@
+#include "BatchFilterOperator.h"
+#include <cstring>
+#include <stdexcept>
+#include "../../../../AdditionalLibraries/AdditionalDataTypes/Field/Field.h"
+#include "../../../AdditionalFunctions/FilterKernels/FilterKernels.h"
+#include "../../../Block/Block.h"
+#include "../../../Column/Column.h"
+#include "../../../Table/Table.h"
+
+using namespace DatabaseEngine::StorageTypes;
+
+namespace QueryOperators {
+    // DATE_TIME values are handed to the 64 bit kernels as they are
+    static_assert(sizeof(time_t) == sizeof(int64_t));
+
+    BatchFilterOperator::BatchFilterOperator(BatchOperator *child, const Table *table, const vector<Field> &conditions)
+        : BatchOperator(child), conditionArena(ROW_ARENA_CHUNK_SIZE)
+    {
+        this->table = table;
+        this->conditions = conditions;
+        this->matches.resize((BATCH_SIZE + 63) / 64);
+        this->conditionMatches.resize((BATCH_SIZE + 63) / 64);
+    }
+
+    BatchFilterOperator::~BatchFilterOperator() = default;
+
+    void BatchFilterOperator::Open()
+    {
+        this->conditionValues.clear();
+        this->conditionArena.Reset();
+
+        // every condition is converted to its column type once instead of once per batch
+        for (const auto &condition : this->conditions)
+        {
+            // the kernels compare flat conditions against non null values, groups and null checks are left to RowPredicate
+            if (!condition.GetChildren().empty())
+                throw invalid_argument("BatchFilterOperator::Open: Grouped conditions are not supported");
+
+            if (condition.GetIsNull())
+                throw invalid_argument("BatchFilterOperator::Open: IS NULL and IS NOT NULL conditions are not supported");
+
+            const Column *column = this->table->GetColumns()[condition.GetColumnIndex()];
+
+            if (column->GetColumnType() == ColumnType::Decimal)
+                throw invalid_argument("BatchFilterOperator::Open: Decimal conditions are not supported");
+
+            const Block *conditionBlock = this->table->CreateConditionBlock(condition);
+
+            ColumnVector conditionValue(column);
+            conditionValue.Append(conditionBlock->GetBlockData(), conditionBlock->GetBlockSize(), this->conditionArena);
+            this->conditionValues.push_back(conditionValue);
+
+            delete conditionBlock;
+        }
+
+        this->FuseBetweenConditions();
+
+        BatchOperator::Open();
+    }
+
+    void BatchFilterOperator::FuseBetweenConditions()
+    {
+        this->betweenConditions.assign(this->conditions.size(), -1);
+        this->isBetweenBound.assign(this->conditions.size(), false);
+
+        for (size_t i = 0; i + 1 < this->conditions.size(); i++)
+        {
+            const Field &condition = this->conditions[i];
+            const Field &nextCondition = this->conditions[i + 1];
+
+            if (this->isBetweenBound[i] || condition.GetColumnIndex() != nextCondition.GetColumnIndex())
+                continue;
+
+            if (this->conditionValues[i].GetVectorType() == VectorType::STRING)
+                continue;
+
+            const bool isRange = (condition.GetOperatorType() == GreaterOrEqual && nextCondition.GetOperatorType() == LessOrEqual)
+                                 || (condition.GetOperatorType() == LessOrEqual && nextCondition.GetOperatorType() == GreaterOrEqual);
+
+            // conditions fold left to right, the pair can only be evaluated on its own when it is joined to what comes before it by And
+            const bool isJoinedByAnd = nextCondition.GetConditionType() != ConditionType::Or
+                                       && (i == 0 || condition.GetConditionType() != ConditionType::Or);
+
+            if (!isRange || !isJoinedByAnd)
+                continue;
+
+            this->betweenConditions[i] = static_cast<int>(i + 1);
+            this->isBetweenBound[i + 1] = true;
+        }
+    }
+
+    bool BatchFilterOperator::Next(RowBatch *&batch)
+    {
+        while (this->child->Next(batch))
+        {
+            if (this->conditions.empty())
+                return true;
+
+            const size_t numberOfWords = (batch->GetSize() + 63) / 64;
+
+            for (size_t i = 0; i < this->conditions.size(); i++)
+            {
+                // evaluated as the upper or lower bound of the BETWEEN before it
+                if (this->isBetweenBound[i])
+                    continue;
+
+                if (i == 0)
+                {
+                    this->MatchCondition(*batch, i, this->matches.data());
+                    continue;
+                }
+
+                this->MatchCondition(*batch, i, this->conditionMatches.data());
+
+                uint64_t *result = this->matches.data();
+                const uint64_t *conditionResult = this->conditionMatches.data();
+
+                if (this->conditions[i].GetConditionType() == ConditionType::Or)
+                    for (size_t j = 0; j < numberOfWords; j++)
+                        result[j] |= conditionResult[j];
+                else
+                    for (size_t j = 0; j < numberOfWords; j++)
+                        result[j] &= conditionResult[j];
+            }
+
+            // the rows the child already dropped stay dropped
+            vector<uint16_t> &selection = batch->GetSelection();
+            const uint64_t *result = this->matches.data();
+
+            size_t selectedRows = 0;
+            for (const auto &position : selection)
+                if ((result[position / 64] >> (position % 64)) & 1)
+                    selection[selectedRows++] = position;
+
+            selection.resize(selectedRows);
+
+            if (selectedRows > 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    void BatchFilterOperator::Close()
+    {
+        this->conditionValues.clear();
+        this->conditionArena.Reset();
+
+        BatchOperator::Close();
+    }
+
+    void BatchFilterOperator::MatchCondition(const RowBatch &batch, const size_t &conditionIndex, uint64_t *result) const
+    {
+        const Field &condition = this->conditions[conditionIndex];
+        const ColumnVector &conditionValue = this->conditionValues[conditionIndex];
+
+        const int columnPosition = batch.FindColumn(condition.GetColumnIndex());
+
+        if (columnPosition < 0)
+            throw invalid_argument("BatchFilterOperator::MatchCondition: Condition column is not in the batch");
+
+        const ColumnVector &column = batch.GetColumn(columnPosition);
+        const size_t size = column.GetSize();
+        const Operator &operatorType = condition.GetOperatorType();
+
+        if (this->betweenConditions[conditionIndex] >= 0)
+        {
+            const size_t boundIndex = this->betweenConditions[conditionIndex];
+
+            if (operatorType == GreaterOrEqual)
+                this->MatchBetween(column, conditionIndex, boundIndex, result);
+            else
+                this->MatchBetween(column, boundIndex, conditionIndex, result);
+        }
+        else
+            switch (column.GetVectorType())
+            {
+                case VectorType::INT32:
+                    FilterKernels::Compare(column.GetInt32Values(), size, operatorType, conditionValue.GetInt32Values()[0], result);
+                    break;
+                case VectorType::INT64:
+                    FilterKernels::Compare(column.GetInt64Values(), size, operatorType, conditionValue.GetInt64Values()[0], result);
+                    break;
+                case VectorType::DATE_TIME:
+                    FilterKernels::Compare(reinterpret_cast<const int64_t *>(column.GetDateTimeValues()), size, operatorType, static_cast<int64_t>(conditionValue.GetDateTimeValues()[0]), result);
+                    break;
+                case VectorType::STRING:
+                    BatchFilterOperator::CompareStrings(column.GetStringValues(), conditionValue.GetStringValues()[0], size, operatorType, result);
+                    break;
+            }
+
+        // null never satisfies a comparison
+        FilterKernels::ClearNulls(column.GetNulls(), size, result);
+    }
+
+    void BatchFilterOperator::MatchBetween(const ColumnVector &column, const size_t &lowConditionIndex, const size_t &highConditionIndex, uint64_t *result) const
+    {
+        const ColumnVector &low = this->conditionValues[lowConditionIndex];
+        const ColumnVector &high = this->conditionValues[highConditionIndex];
+        const size_t size = column.GetSize();
+
+        switch (column.GetVectorType())
+        {
+            case VectorType::INT32:
+                FilterKernels::Between(column.GetInt32Values(), size, low.GetInt32Values()[0], high.GetInt32Values()[0], result);
+                break;
+            case VectorType::INT64:
+                FilterKernels::Between(column.GetInt64Values(), size, low.GetInt64Values()[0], high.GetInt64Values()[0], result);
+                break;
+            case VectorType::DATE_TIME:
+                FilterKernels::Between(reinterpret_cast<const int64_t *>(column.GetDateTimeValues()), size, static_cast<int64_t>(low.GetDateTimeValues()[0]), static_cast<int64_t>(high.GetDateTimeValues()[0]), result);
+                break;
+            default:
+                throw invalid_argument("BatchFilterOperator::MatchBetween: Unsupported column type");
+        }
+    }
+
+    void BatchFilterOperator::CompareStrings(const string_view *values, const string_view &value, const size_t &size, const Operator &operatorType, uint64_t *result)
+    {
+        memset(result, 0, (size + 63) / 64 * sizeof(uint64_t));
+
+        for (size_t i = 0; i < size; i++)
+        {
+            const int comparison = BatchFilterOperator::CompareString(values[i], value);
+
+            bool isConditionMet;
+
+            switch (operatorType)
+            {
+                case OperatorNone:
+                case Equal:
+                    isConditionMet = comparison == 0;
+                    break;
+                case NotEqual:
+                    isConditionMet = comparison != 0;
+                    break;
+                case GreaterThan:
+                    isConditionMet = comparison > 0;
+                    break;
+                case LessThan:
+                    isConditionMet = comparison < 0;
+                    break;
+                case GreaterOrEqual:
+                    isConditionMet = comparison >= 0;
+                    break;
+                case LessOrEqual:
+                    isConditionMet = comparison <= 0;
+                    break;
+                default:
+                    throw invalid_argument("BatchFilterOperator::CompareStrings: Unsupported operator");
+            }
+
+            result[i / 64] |= static_cast<uint64_t>(isConditionMet) << (i % 64);
+        }
+    }
+
+    int BatchFilterOperator::CompareString(const string_view &first, const string_view &second)
+    {
+        if (first.size() < second.size()) return -1;
+        if (first.size() > second.size()) return 1;
+
+        const int result = first.compare(second);
+
+        if (result < 0) return -1;
+        if (result > 0) return 1;
+        return 0;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <string_view>
+#include <vector>
+#include "../BatchOperator.h"
+#include "../RowBatch.h"
+
+class Field;
+
+namespace DatabaseEngine::StorageTypes {
+    class Table;
+}
+
+namespace QueryOperators {
+    using namespace std;
+
+    // narrows the selection of its child's batches down to the rows that satisfy the conditions, the column index of a condition is the table's
+    // every condition is evaluated over the whole batch into a bitmask, one bit a row, the masks are combined by ConditionType and the selection is rebuilt from the result
+    // a GreaterOrEqual and a LessOrEqual on the same column joined by And are evaluated together as one BETWEEN
+    // grouped conditions, null conditions and Decimal columns are rejected on Open, rows with a null in a compared column never match
+    class BatchFilterOperator final : public BatchOperator {
+        const DatabaseEngine::StorageTypes::Table *table;
+        vector<Field> conditions;
+        // the constant of every condition as a one value vector of its column
+        vector<ColumnVector> conditionValues;
+        Arenas::MonotonicArena conditionArena;
+        // the condition evaluated together with this one as a BETWEEN, -1 for none
+        vector<int> betweenConditions;
+        vector<bool> isBetweenBound;
+        vector<uint64_t> matches;
+        vector<uint64_t> conditionMatches;
+
+    protected:
+        void FuseBetweenConditions();
+        void MatchCondition(const RowBatch &batch, const size_t &conditionIndex, uint64_t *result) const;
+        void MatchBetween(const ColumnVector &column, const size_t &lowConditionIndex, const size_t &highConditionIndex, uint64_t *result) const;
+
+        static void CompareStrings(const string_view *values, const string_view &value, const size_t &size, const Operator &operatorType, uint64_t *result);
+        // same order as SortingFunctions::CompareBlockByDataType, shorter strings first, then byte by byte
+        [[nodiscard]] static int CompareString(const string_view &first, const string_view &second);
+
+    public:
+        BatchFilterOperator(BatchOperator *child, const DatabaseEngine::StorageTypes::Table *table, const vector<Field> &conditions);
+        ~BatchFilterOperator() override;
+
+        void Open() override;
+        [[nodiscard]] bool Next(RowBatch *&batch) override;
+        void Close() override;
+    };
+}
@@ -0,0 +1,19 @@
+#include "BatchOperator.h"
+
+namespace QueryOperators {
+    BatchOperator::BatchOperator(BatchOperator *child) { this->child = child; }
+
+    BatchOperator::~BatchOperator() { delete this->child; }
+
+    void BatchOperator::Open()
+    {
+        if (this->child != nullptr)
+            this->child->Open();
+    }
+
+    void BatchOperator::Close()
+    {
+        if (this->child != nullptr)
+            this->child->Close();
+    }
+}
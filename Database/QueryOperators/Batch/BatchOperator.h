@@ -0,0 +1,25 @@
+#pragma once
+#include "../../Constants.h"
+
+using namespace Constants;
+
+namespace QueryOperators {
+    class RowBatch;
+
+    // batch at a time counterpart of QueryOperator: every Next hands out a RowBatch of up to BATCH_SIZE rows until it returns false
+    // a batch handed out stays valid until the next Next or Close on the same operator, the rows in it are the ones its selection lists
+    class BatchOperator {
+    protected:
+        // the operator batches are pulled from, owned and deleted by this one
+        BatchOperator *child;
+
+    public:
+        explicit BatchOperator(BatchOperator *child = nullptr);
+        BatchOperator(const BatchOperator &other) = delete;
+        virtual ~BatchOperator();
+
+        virtual void Open();
+        [[nodiscard]] virtual bool Next(RowBatch *&batch) = 0;
+        virtual void Close();
+    };
+}
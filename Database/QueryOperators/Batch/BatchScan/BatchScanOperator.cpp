@@ -0,0 +1,126 @@
+#include "BatchScanOperator.h"
+#include "../../../Database.h"
+#include "../../../Table/Table.h"
+#include "../../../Row/Row.h"
+#include "../../../RowView/RowView.h"
+#include "../../../Pages/Page.h"
+#include "../../../Pages/IndexMapAllocation/IndexAllocationMapPage.h"
+#include "../../../Pages/PageFreeSpace/PageFreeSpacePage.h"
+#include "../../../Storage/StorageManager/StorageManager.h"
+
+using namespace DatabaseEngine;
+using namespace DatabaseEngine::StorageTypes;
+using namespace Pages;
+using namespace Storage;
+
+namespace QueryOperators {
+    BatchScanOperator::BatchScanOperator(const Table *table, const vector<column_index_t> &selectedColumnIndices)
+        : batch(*table, selectedColumnIndices)
+    {
+        this->table = table;
+        this->tableMapPage = nullptr;
+        this->pageFreeSpacePage = nullptr;
+        this->extentPosition = 0;
+        this->extentId = 0;
+        this->nextPageId = 0;
+        this->extentEndPageId = 0;
+        this->rowIndex = 0;
+    }
+
+    BatchScanOperator::~BatchScanOperator() = default;
+
+    void BatchScanOperator::Open()
+    {
+        this->extentIds.clear();
+        this->extentPosition = 0;
+        this->nextPageId = 0;
+        this->extentEndPageId = 0;
+        this->page.Release();
+
+        const page_id_t indexAllocationMapPageId = this->table->GetTableHeader().indexAllocationMapPageId;
+
+        if (indexAllocationMapPageId == 0)
+            return;
+
+        this->tableMapPage = StorageManager::Get().GetIndexAllocationMapPage(indexAllocationMapPageId);
+        this->tableMapPage->GetAllocatedExtents(&this->extentIds);
+    }
+
+    bool BatchScanOperator::NextPage()
+    {
+        this->page.Release();
+
+        while (true)
+        {
+            if (this->nextPageId >= this->extentEndPageId)
+            {
+                if (this->extentPosition >= this->extentIds.size())
+                    return false;
+
+                this->extentId = this->extentIds[this->extentPosition];
+                this->extentPosition++;
+
+                const page_id_t extentFirstPageId = Database::CalculateSystemPageOffset(this->extentId * EXTENT_SIZE);
+
+                this->pageFreeSpacePage = StorageManager::Get().GetPageFreeSpacePage(Database::GetPfsAssociatedPage(extentFirstPageId));
+
+                this->nextPageId = (this->tableMapPage->GetPageId() != extentFirstPageId)
+                                    ? extentFirstPageId
+                                    : extentFirstPageId + 1;
+
+                this->extentEndPageId = extentFirstPageId + EXTENT_SIZE;
+
+                continue;
+            }
+
+            if (this->pageFreeSpacePage->GetPageType(this->nextPageId) != PageType::DATA)
+            {
+                this->nextPageId = this->extentEndPageId;
+                continue;
+            }
+
+            this->page = StorageManager::Get().GetPage(this->nextPageId, this->extentId, this->table);
+            this->nextPageId++;
+            this->rowIndex = 0;
+
+            if (this->page->GetPageSize() == 0)
+                continue;
+
+            return true;
+        }
+    }
+
+    bool BatchScanOperator::Next(RowBatch *&batch)
+    {
+        this->batch.Clear();
+
+        // a batch can span pages, only the page being read is pinned
+        while (!this->batch.IsFull())
+        {
+            if (this->page == nullptr || this->rowIndex >= this->page->GetPageSize())
+                if (!this->NextPage())
+                    break;
+
+            if (this->page->HasRowView(this->rowIndex))
+                this->batch.AppendRow(this->page->GetRowView(this->rowIndex));
+            else
+                this->batch.AppendRow(this->page->GetDecodedRow(this->rowIndex));
+
+            this->rowIndex++;
+        }
+
+        if (this->batch.GetSize() == 0)
+            return false;
+
+        batch = &this->batch;
+
+        return true;
+    }
+
+    void BatchScanOperator::Close()
+    {
+        this->batch.Clear();
+        this->page.Release();
+        this->extentIds.clear();
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+#include "../BatchOperator.h"
+#include "../RowBatch.h"
+#include "../../../Storage/PageGuard/PageGuard.h"
+
+namespace Pages {
+    class Page;
+    class IndexAllocationMapPage;
+    class PageFreeSpacePage;
+}
+
+namespace QueryOperators {
+    using namespace std;
+
+    // reads the data pages of the table into batches of the selected columns, every column when none are given
+    // values go from the page image straight into the column vectors, no Row or Block is built for rows that were never decoded
+    class BatchScanOperator final : public BatchOperator {
+        const DatabaseEngine::StorageTypes::Table *table;
+        const Pages::IndexAllocationMapPage *tableMapPage;
+        const Pages::PageFreeSpacePage *pageFreeSpacePage;
+        vector<extent_id_t> extentIds;
+        size_t extentPosition;
+        extent_id_t extentId;
+        page_id_t nextPageId;
+        page_id_t extentEndPageId;
+        Storage::PageGuard<Pages::Page> page;
+        page_size_t rowIndex;
+        RowBatch batch;
+
+    protected:
+        bool NextPage();
+
+    public:
+        BatchScanOperator(const DatabaseEngine::StorageTypes::Table *table, const vector<column_index_t> &selectedColumnIndices);
+        ~BatchScanOperator() override;
+
+        void Open() override;
+        [[nodiscard]] bool Next(RowBatch *&batch) override;
+        void Close() override;
+    };
+}
@@ -0,0 +1,204 @@
+#include "BatchSortOperator.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace QueryOperators {
+    BatchSortOperator::BatchSortOperator(BatchOperator *child, const vector<SortCondition> &sortConditions)
+        : BatchOperator(child)
+    {
+        this->sortConditions = sortConditions;
+        this->rowPosition = 0;
+        this->isSorted = false;
+    }
+
+    BatchSortOperator::~BatchSortOperator() = default;
+
+    void BatchSortOperator::Open()
+    {
+        this->batches.clear();
+        this->sortKeys.clear();
+        this->sortedRows.clear();
+        this->outputBatch.reset();
+        this->rowPosition = 0;
+        this->isSorted = false;
+
+        BatchOperator::Open();
+    }
+
+    void BatchSortOperator::SortChildBatches()
+    {
+        RowBatch *batch;
+
+        // the child reuses its batch, the selected rows are copied into full batches of their own
+        while (this->child->Next(batch))
+            for (const auto &position : batch->GetSelection())
+            {
+                if (this->batches.empty() || this->batches.back()->IsFull())
+                {
+                    if (!this->batches.empty())
+                        this->ExtractSortKeys(*this->batches.back());
+
+                    this->batches.push_back(make_unique<RowBatch>(batch->GetTable(), batch->GetColumnIndices()));
+                }
+
+                this->batches.back()->AppendRow(*batch, position);
+            }
+
+        if (!this->batches.empty())
+            this->ExtractSortKeys(*this->batches.back());
+
+        const size_t numberOfRows = this->batches.empty()
+                                    ? 0
+                                    : (this->batches.size() - 1) * BATCH_SIZE + this->batches.back()->GetSize();
+
+        this->sortedRows.resize(numberOfRows);
+
+        for (size_t i = 0; i < numberOfRows; i++)
+            this->sortedRows[i] = static_cast<uint32_t>(i);
+
+        if (!this->sortConditions.empty())
+            sort(this->sortedRows.begin(), this->sortedRows.end(), [this](const uint32_t &firstRow, const uint32_t &secondRow) { return this->CompareRows(firstRow, secondRow); });
+
+        if (!this->batches.empty())
+            this->outputBatch = make_unique<RowBatch>(this->batches.front()->GetTable(), this->batches.front()->GetColumnIndices());
+
+        this->isSorted = true;
+    }
+
+    void BatchSortOperator::ExtractSortKeys(const RowBatch &batch)
+    {
+        if (this->sortKeys.empty())
+            for (const auto &condition : this->sortConditions)
+            {
+                const int columnPosition = batch.FindColumn(condition.GetColumnIndex());
+
+                if (columnPosition < 0)
+                    throw invalid_argument("BatchSortOperator::ExtractSortKeys: Sort column is not in the batch");
+
+                SortKeys keys;
+                keys.isString = batch.GetColumn(columnPosition).GetVectorType() == VectorType::STRING;
+                keys.isDescending = condition.GetSortType() == SortType::DESCENDING;
+
+                this->sortKeys.push_back(keys);
+            }
+
+        const size_t size = batch.GetSize();
+
+        for (size_t i = 0; i < this->sortConditions.size(); i++)
+        {
+            const ColumnVector &column = batch.GetColumn(batch.FindColumn(this->sortConditions[i].GetColumnIndex()));
+            SortKeys &keys = this->sortKeys[i];
+
+            const uint8_t *nulls = column.GetNulls();
+            keys.nullKeys.insert(keys.nullKeys.end(), nulls, nulls + size);
+
+            if (keys.isString)
+            {
+                // the views point into the retained batch, which outlives the sort
+                const string_view *values = column.GetStringValues();
+                keys.stringKeys.insert(keys.stringKeys.end(), values, values + size);
+                continue;
+            }
+
+            const size_t keyOffset = keys.integerKeys.size();
+            keys.integerKeys.resize(keyOffset + size);
+            int64_t *integerKeys = keys.integerKeys.data() + keyOffset;
+
+            switch (column.GetVectorType())
+            {
+                case VectorType::INT32:
+                {
+                    const int32_t *values = column.GetInt32Values();
+                    for (size_t j = 0; j < size; j++)
+                        integerKeys[j] = values[j];
+                    break;
+                }
+                case VectorType::INT64:
+                {
+                    const int64_t *values = column.GetInt64Values();
+                    for (size_t j = 0; j < size; j++)
+                        integerKeys[j] = values[j];
+                    break;
+                }
+                case VectorType::DATE_TIME:
+                {
+                    const time_t *values = column.GetDateTimeValues();
+                    for (size_t j = 0; j < size; j++)
+                        integerKeys[j] = values[j];
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    bool BatchSortOperator::CompareRows(const uint32_t &firstRow, const uint32_t &secondRow) const
+    {
+        for (const auto &keys : this->sortKeys)
+        {
+            int result;
+
+            // nulls come before every value
+            if (keys.nullKeys[firstRow] || keys.nullKeys[secondRow])
+                result = static_cast<int>(keys.nullKeys[secondRow]) - static_cast<int>(keys.nullKeys[firstRow]);
+            else if (keys.isString)
+            {
+                // same order as SortingFunctions::CompareBlockByDataType, shorter strings first, then byte by byte
+                const string_view &firstKey = keys.stringKeys[firstRow];
+                const string_view &secondKey = keys.stringKeys[secondRow];
+
+                result = (firstKey.size() != secondKey.size())
+                            ? (firstKey.size() < secondKey.size() ? -1 : 1)
+                            : firstKey.compare(secondKey);
+            }
+            else
+            {
+                const int64_t &firstKey = keys.integerKeys[firstRow];
+                const int64_t &secondKey = keys.integerKeys[secondRow];
+
+                result = (firstKey < secondKey) ? -1 : (firstKey > secondKey ? 1 : 0);
+            }
+
+            if (result == 0)
+                continue;
+
+            return keys.isDescending ? result > 0 : result < 0;
+        }
+
+        return false;
+    }
+
+    bool BatchSortOperator::Next(RowBatch *&batch)
+    {
+        if (!this->isSorted)
+            this->SortChildBatches();
+
+        if (this->rowPosition >= this->sortedRows.size())
+            return false;
+
+        this->outputBatch->Clear();
+
+        while (!this->outputBatch->IsFull() && this->rowPosition < this->sortedRows.size())
+        {
+            const uint32_t &row = this->sortedRows[this->rowPosition];
+
+            this->outputBatch->AppendRow(*this->batches[row / BATCH_SIZE], row % BATCH_SIZE);
+            this->rowPosition++;
+        }
+
+        batch = this->outputBatch.get();
+
+        return true;
+    }
+
+    void BatchSortOperator::Close()
+    {
+        this->batches = vector<unique_ptr<RowBatch>>();
+        this->sortKeys = vector<SortKeys>();
+        this->sortedRows = vector<uint32_t>();
+        this->outputBatch.reset();
+
+        BatchOperator::Close();
+    }
+}
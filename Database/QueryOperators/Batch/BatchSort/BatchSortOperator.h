@@ -0,0 +1,47 @@
+#pragma once
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "../BatchOperator.h"
+#include "../RowBatch.h"
+#include "../../../../AdditionalLibraries/AdditionalDataTypes/SortCondition/SortCondition.h"
+
+namespace QueryOperators {
+    using namespace std;
+
+    // blocking: the first Next copies the selected rows of every child batch, pulls the sort keys out into one contiguous array per condition
+    // and sorts the row numbers by them, the rows are then gathered into batches in order, the column index of a condition is the table's
+    class BatchSortOperator final : public BatchOperator {
+        typedef struct SortKeys
+        {
+            // INT32, INT64 and DATE_TIME values widened to one type, STRING values in stringKeys
+            vector<int64_t> integerKeys;
+            vector<string_view> stringKeys;
+            vector<uint8_t> nullKeys;
+            bool isString;
+            bool isDescending;
+        } SortKeys;
+
+        vector<SortCondition> sortConditions;
+        vector<unique_ptr<RowBatch>> batches;
+        vector<SortKeys> sortKeys;
+        // row number of the sorted rows, a row number is its batch times BATCH_SIZE plus its position in it
+        vector<uint32_t> sortedRows;
+        unique_ptr<RowBatch> outputBatch;
+        size_t rowPosition;
+        bool isSorted;
+
+    protected:
+        void SortChildBatches();
+        void ExtractSortKeys(const RowBatch &batch);
+        [[nodiscard]] bool CompareRows(const uint32_t &firstRow, const uint32_t &secondRow) const;
+
+    public:
+        BatchSortOperator(BatchOperator *child, const vector<SortCondition> &sortConditions);
+        ~BatchSortOperator() override;
+
+        void Open() override;
+        [[nodiscard]] bool Next(RowBatch *&batch) override;
+        void Close() override;
+    };
+}
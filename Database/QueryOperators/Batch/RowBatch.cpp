@@ -0,0 +1,379 @@
+#include "RowBatch.h"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "../../Block/Block.h"
+#include "../../Column/Column.h"
+#include "../../Row/Row.h"
+#include "../../RowView/RowView.h"
+#include "../../Table/Table.h"
+#include "../../Pages/LargeObject/LargeDataPage.h"
+
+using namespace DatabaseEngine::StorageTypes;
+
+namespace QueryOperators {
+    ColumnVector::ColumnVector(const Column *column)
+    {
+        this->column = column;
+        this->vectorType = ColumnVector::GetVectorType(column->GetColumnType());
+
+        this->nulls.reserve(BATCH_SIZE);
+
+        switch (this->vectorType)
+        {
+            case VectorType::INT32:
+                this->int32Values.reserve(BATCH_SIZE);
+                break;
+            case VectorType::INT64:
+                this->int64Values.reserve(BATCH_SIZE);
+                break;
+            case VectorType::DATE_TIME:
+                this->dateTimeValues.reserve(BATCH_SIZE);
+                break;
+            case VectorType::STRING:
+                this->stringValues.reserve(BATCH_SIZE);
+                break;
+        }
+    }
+
+    VectorType ColumnVector::GetVectorType(const ColumnType &columnType)
+    {
+        switch (columnType)
+        {
+            case ColumnType::TinyInt:
+            case ColumnType::SmallInt:
+            case ColumnType::Int:
+            case ColumnType::Bool:
+                return VectorType::INT32;
+            case ColumnType::BigInt:
+                return VectorType::INT64;
+            case ColumnType::DateTime:
+                return VectorType::DATE_TIME;
+            case ColumnType::Decimal:
+            case ColumnType::String:
+            case ColumnType::UnicodeString:
+                return VectorType::STRING;
+            default:
+                throw invalid_argument("ColumnVector::GetVectorType: Unsupported column type");
+        }
+    }
+
+    void ColumnVector::Append(const object_t *value, const uint32_t &size, Arenas::MonotonicArena &stringArena)
+    {
+        this->nulls.push_back(value == nullptr);
+
+        switch (this->column->GetColumnType())
+        {
+            // values in a page image are not aligned, they are copied out instead of being read in place
+            case ColumnType::TinyInt:
+            {
+                int8_t tinyInt = 0;
+                if (value != nullptr)
+                    memcpy(&tinyInt, value, sizeof(int8_t));
+
+                this->int32Values.push_back(tinyInt);
+                break;
+            }
+            case ColumnType::SmallInt:
+            {
+                int16_t smallInt = 0;
+                if (value != nullptr)
+                    memcpy(&smallInt, value, sizeof(int16_t));
+
+                this->int32Values.push_back(smallInt);
+                break;
+            }
+            case ColumnType::Int:
+            {
+                int32_t intValue = 0;
+                if (value != nullptr)
+                    memcpy(&intValue, value, sizeof(int32_t));
+
+                this->int32Values.push_back(intValue);
+                break;
+            }
+            case ColumnType::Bool:
+            {
+                bool boolValue = false;
+                if (value != nullptr)
+                    memcpy(&boolValue, value, sizeof(bool));
+
+                this->int32Values.push_back(boolValue);
+                break;
+            }
+            case ColumnType::BigInt:
+            {
+                int64_t bigInt = 0;
+                if (value != nullptr)
+                    memcpy(&bigInt, value, sizeof(int64_t));
+
+                this->int64Values.push_back(bigInt);
+                break;
+            }
+            case ColumnType::DateTime:
+            {
+                time_t dateTime = 0;
+                if (value != nullptr)
+                    memcpy(&dateTime, value, sizeof(time_t));
+
+                this->dateTimeValues.push_back(dateTime);
+                break;
+            }
+            default:
+            {
+                if (value == nullptr || size == 0)
+                {
+                    this->stringValues.emplace_back();
+                    break;
+                }
+
+                auto *bytes = static_cast<char *>(stringArena.allocate(size, alignof(char)));
+                memcpy(bytes, value, size);
+
+                this->stringValues.emplace_back(bytes, size);
+                break;
+            }
+        }
+    }
+
+    void ColumnVector::Append(const ColumnVector &source, const size_t &position, Arenas::MonotonicArena &stringArena)
+    {
+        this->nulls.push_back(source.nulls[position]);
+
+        switch (this->vectorType)
+        {
+            case VectorType::INT32:
+                this->int32Values.push_back(source.int32Values[position]);
+                break;
+            case VectorType::INT64:
+                this->int64Values.push_back(source.int64Values[position]);
+                break;
+            case VectorType::DATE_TIME:
+                this->dateTimeValues.push_back(source.dateTimeValues[position]);
+                break;
+            case VectorType::STRING:
+            {
+                const string_view &value = source.stringValues[position];
+
+                if (value.empty())
+                {
+                    this->stringValues.emplace_back();
+                    break;
+                }
+
+                auto *bytes = static_cast<char *>(stringArena.allocate(value.size(), alignof(char)));
+                memcpy(bytes, value.data(), value.size());
+
+                this->stringValues.emplace_back(bytes, value.size());
+                break;
+            }
+        }
+    }
+
+    void ColumnVector::Clear()
+    {
+        this->int32Values.clear();
+        this->int64Values.clear();
+        this->dateTimeValues.clear();
+        this->stringValues.clear();
+        this->nulls.clear();
+    }
+
+    void ColumnVector::AppendKeyBytes(string &key, const size_t &position) const
+    {
+        if (this->nulls[position])
+            return;
+
+        // the width the value has in its Block, so keys match the ones SortingFunctions::GroupBy builds
+        switch (this->column->GetColumnType())
+        {
+            case ColumnType::TinyInt:
+            {
+                const auto tinyInt = static_cast<int8_t>(this->int32Values[position]);
+                key.append(reinterpret_cast<const char *>(&tinyInt), sizeof(int8_t));
+                break;
+            }
+            case ColumnType::SmallInt:
+            {
+                const auto smallInt = static_cast<int16_t>(this->int32Values[position]);
+                key.append(reinterpret_cast<const char *>(&smallInt), sizeof(int16_t));
+                break;
+            }
+            case ColumnType::Int:
+                key.append(reinterpret_cast<const char *>(&this->int32Values[position]), sizeof(int32_t));
+                break;
+            case ColumnType::Bool:
+            {
+                const bool boolValue = this->int32Values[position] != 0;
+                key.append(reinterpret_cast<const char *>(&boolValue), sizeof(bool));
+                break;
+            }
+            case ColumnType::BigInt:
+                key.append(reinterpret_cast<const char *>(&this->int64Values[position]), sizeof(int64_t));
+                break;
+            case ColumnType::DateTime:
+                key.append(reinterpret_cast<const char *>(&this->dateTimeValues[position]), sizeof(time_t));
+                break;
+            default:
+                key.append(this->stringValues[position]);
+                break;
+        }
+    }
+
+    const Column *ColumnVector::GetColumn() const { return this->column; }
+
+    const VectorType &ColumnVector::GetVectorType() const { return this->vectorType; }
+
+    const int32_t *ColumnVector::GetInt32Values() const { return this->int32Values.data(); }
+
+    const int64_t *ColumnVector::GetInt64Values() const { return this->int64Values.data(); }
+
+    const time_t *ColumnVector::GetDateTimeValues() const { return this->dateTimeValues.data(); }
+
+    const string_view *ColumnVector::GetStringValues() const { return this->stringValues.data(); }
+
+    const uint8_t *ColumnVector::GetNulls() const { return this->nulls.data(); }
+
+    size_t ColumnVector::GetSize() const { return this->nulls.size(); }
+
+    RowBatch::RowBatch(const Table &table, const vector<column_index_t> &columnIndices)
+        : stringArena(ROW_ARENA_CHUNK_SIZE)
+    {
+        this->table = &table;
+        this->columnIndices = columnIndices;
+
+        const auto &tableColumns = table.GetColumns();
+
+        if (this->columnIndices.empty())
+            for (const auto &column : tableColumns)
+                this->columnIndices.push_back(column->GetColumnIndex());
+
+        this->columns.reserve(this->columnIndices.size());
+
+        for (const auto &columnIndex : this->columnIndices)
+            this->columns.emplace_back(tableColumns[columnIndex]);
+
+        this->selection.reserve(BATCH_SIZE);
+    }
+
+    void RowBatch::AppendRow(const RowView &rowView)
+    {
+        // one pass over the row up to the last selected column, as Page::CopyRowView does
+        size_t lastColumnIndex = 0;
+        for (const auto &columnIndex : this->columnIndices)
+            lastColumnIndex = max<size_t>(lastColumnIndex, columnIndex);
+
+        const object_t *columnData[numeric_limits<column_index_t>::max() + 1];
+        block_size_t columnSizes[numeric_limits<column_index_t>::max() + 1];
+
+        const char *column = rowView.GetFirstColumn();
+
+        for (size_t j = 0; j <= lastColumnIndex; j++)
+        {
+            columnData[j] = nullptr;
+            columnSizes[j] = 0;
+
+            if (j >= rowView.GetNumberOfColumns() || rowView.IsNull(j))
+                continue;
+
+            columnData[j] = rowView.ReadColumn(column, columnSizes[j]);
+        }
+
+        for (size_t i = 0; i < this->columnIndices.size(); i++)
+        {
+            const column_index_t columnIndex = this->columnIndices[i];
+
+            if (columnData[columnIndex] != nullptr && rowView.IsLargeObject(columnIndex))
+            {
+                Pages::DataObjectPointer objectPointer;
+                memcpy(&objectPointer, columnData[columnIndex], sizeof(Pages::DataObjectPointer));
+
+                uint32_t objectSize;
+                unsigned char *largeValue = Row::GetLargeObjectValue(*this->table, objectPointer, &objectSize);
+
+                this->columns[i].Append(largeValue, objectSize, this->stringArena);
+
+                delete[] largeValue;
+                continue;
+            }
+
+            this->columns[i].Append(columnData[columnIndex], columnSizes[columnIndex], this->stringArena);
+        }
+
+        this->selection.push_back(static_cast<uint16_t>(this->selection.size()));
+    }
+
+    void RowBatch::AppendRow(const Row *row)
+    {
+        const RowHeader *rowHeader = row->GetHeader();
+
+        for (size_t i = 0; i < this->columnIndices.size(); i++)
+        {
+            const Block *block = row->GetData()[this->columnIndices[i]];
+
+            if (block->GetBlockData() != nullptr && rowHeader->largeObjectBitMap.Get(this->columnIndices[i]))
+            {
+                Pages::DataObjectPointer objectPointer;
+                memcpy(&objectPointer, block->GetBlockData(), sizeof(Pages::DataObjectPointer));
+
+                uint32_t objectSize;
+                unsigned char *largeValue = row->GetLargeObjectValue(objectPointer, &objectSize);
+
+                this->columns[i].Append(largeValue, objectSize, this->stringArena);
+
+                delete[] largeValue;
+                continue;
+            }
+
+            this->columns[i].Append(block->GetBlockData(), block->GetBlockSize(), this->stringArena);
+        }
+
+        this->selection.push_back(static_cast<uint16_t>(this->selection.size()));
+    }
+
+    void RowBatch::AppendRow(const RowBatch &source, const size_t &position)
+    {
+        for (size_t i = 0; i < this->columns.size(); i++)
+            this->columns[i].Append(source.columns[i], position, this->stringArena);
+
+        this->selection.push_back(static_cast<uint16_t>(this->columns.front().GetSize() - 1));
+    }
+
+    void RowBatch::AppendSelectedRows(const RowBatch &source)
+    {
+        for (const auto &position : source.selection)
+            this->AppendRow(source, position);
+    }
+
+    void RowBatch::Clear()
+    {
+        for (auto &column : this->columns)
+            column.Clear();
+
+        this->selection.clear();
+        this->stringArena.Reset();
+    }
+
+    bool RowBatch::IsFull() const { return this->GetSize() >= BATCH_SIZE; }
+
+    size_t RowBatch::GetSize() const { return this->columns.empty() ? 0 : this->columns.front().GetSize(); }
+
+    const Table &RowBatch::GetTable() const { return *this->table; }
+
+    const vector<column_index_t> &RowBatch::GetColumnIndices() const { return this->columnIndices; }
+
+    const ColumnVector &RowBatch::GetColumn(const size_t &position) const { return this->columns[position]; }
+
+    int RowBatch::FindColumn(const column_index_t &columnIndex) const
+    {
+        for (size_t i = 0; i < this->columnIndices.size(); i++)
+            if (this->columnIndices[i] == columnIndex)
+                return static_cast<int>(i);
+
+        return -1;
+    }
+
+    vector<uint16_t> &RowBatch::GetSelection() { return this->selection; }
+
+    const vector<uint16_t> &RowBatch::GetSelection() const { return this->selection; }
+}
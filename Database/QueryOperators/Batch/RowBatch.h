@@ -0,0 +1,95 @@
+#pragma once
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../../Constants.h"
+#include "../../../AdditionalLibraries/MonotonicArena/MonotonicArena.h"
+
+using namespace Constants;
+
+namespace DatabaseEngine::StorageTypes {
+    class Column;
+    class Row;
+    class RowView;
+    class Table;
+    enum class ColumnType : uint8_t;
+}
+
+namespace QueryOperators {
+    using namespace std;
+
+    // how a ColumnVector lays out its values, the small integer types and Bool are widened to INT32, Decimal and both string types are kept as bytes
+    enum class VectorType : uint8_t
+    {
+        INT32 = 0,
+        INT64 = 1,
+        DATE_TIME = 2,
+        STRING = 3
+    };
+
+    // the values of one column for the rows of a batch, contiguous in the array of their type, null values are stored as 0 or empty
+    class ColumnVector {
+        const DatabaseEngine::StorageTypes::Column *column;
+        VectorType vectorType;
+        vector<int32_t> int32Values;
+        vector<int64_t> int64Values;
+        vector<time_t> dateTimeValues;
+        vector<string_view> stringValues;
+        vector<uint8_t> nulls;
+
+    public:
+        explicit ColumnVector(const DatabaseEngine::StorageTypes::Column *column);
+
+        // a nullptr value appends a null, string bytes are copied to the arena
+        void Append(const object_t *value, const uint32_t &size, Arenas::MonotonicArena &stringArena);
+        void Append(const ColumnVector &source, const size_t &position, Arenas::MonotonicArena &stringArena);
+        void Clear();
+
+        // the value at position as the bytes GroupBy keys are made of, nothing for a null
+        void AppendKeyBytes(string &key, const size_t &position) const;
+
+        [[nodiscard]] const DatabaseEngine::StorageTypes::Column *GetColumn() const;
+        [[nodiscard]] const VectorType &GetVectorType() const;
+        [[nodiscard]] const int32_t *GetInt32Values() const;
+        [[nodiscard]] const int64_t *GetInt64Values() const;
+        [[nodiscard]] const time_t *GetDateTimeValues() const;
+        [[nodiscard]] const string_view *GetStringValues() const;
+        [[nodiscard]] const uint8_t *GetNulls() const;
+        [[nodiscard]] size_t GetSize() const;
+
+        [[nodiscard]] static VectorType GetVectorType(const DatabaseEngine::StorageTypes::ColumnType &columnType);
+    };
+
+    // up to BATCH_SIZE rows of the selected columns laid out column by column
+    // operators narrow a batch down by rewriting its selection, the positions of the rows still in it, instead of moving values around
+    class RowBatch {
+        const DatabaseEngine::StorageTypes::Table *table;
+        vector<column_index_t> columnIndices;
+        vector<ColumnVector> columns;
+        vector<uint16_t> selection;
+        // the bytes of string values, given back all at once when the batch is cleared
+        Arenas::MonotonicArena stringArena;
+
+    public:
+        RowBatch(const DatabaseEngine::StorageTypes::Table &table, const vector<column_index_t> &columnIndices);
+        RowBatch(const RowBatch &other) = delete;
+
+        void AppendRow(const DatabaseEngine::StorageTypes::RowView &rowView);
+        void AppendRow(const DatabaseEngine::StorageTypes::Row *row);
+        void AppendRow(const RowBatch &source, const size_t &position);
+        // copies the rows source still selects
+        void AppendSelectedRows(const RowBatch &source);
+        void Clear();
+
+        [[nodiscard]] bool IsFull() const;
+        [[nodiscard]] size_t GetSize() const;
+        [[nodiscard]] const DatabaseEngine::StorageTypes::Table &GetTable() const;
+        [[nodiscard]] const vector<column_index_t> &GetColumnIndices() const;
+        [[nodiscard]] const ColumnVector &GetColumn(const size_t &position) const;
+        // position of the table column in the batch, -1 if it was not selected
+        [[nodiscard]] int FindColumn(const column_index_t &columnIndex) const;
+        [[nodiscard]] vector<uint16_t> &GetSelection();
+        [[nodiscard]] const vector<uint16_t> &GetSelection() const;
+    };
+}
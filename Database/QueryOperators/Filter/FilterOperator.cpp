@@ -0,0 +1,52 @@
+#include "FilterOperator.h"
+#include "../../../AdditionalLibraries/AdditionalDataTypes/Field/Field.h"
+#include "../../RowPredicate/RowPredicate.h"
+#include "../../Row/Row.h"
+#include "../../Table/Table.h"
+
+using namespace DatabaseEngine::StorageTypes;
+
+namespace QueryOperators {
+    FilterOperator::FilterOperator(QueryOperator *child, const Table *table, const vector<Field> &conditions)
+        : QueryOperator(child)
+    {
+        this->table = table;
+        this->conditions = conditions;
+        this->predicate = nullptr;
+    }
+
+    FilterOperator::~FilterOperator() { this->DeletePredicate(); }
+
+    void FilterOperator::Open()
+    {
+        this->DeletePredicate();
+
+        // every condition is converted to its column type once instead of once per row
+        this->predicate = new RowPredicate(*this->table, this->conditions);
+
+        QueryOperator::Open();
+    }
+
+    bool FilterOperator::Next(const Row *&row)
+    {
+        while (this->child->Next(row))
+            if (this->predicate->Matches(row))
+                return true;
+
+        return false;
+    }
+
+    void FilterOperator::Close()
+    {
+        this->DeletePredicate();
+
+        QueryOperator::Close();
+    }
+
+    void FilterOperator::DeletePredicate()
+    {
+        delete this->predicate;
+
+        this->predicate = nullptr;
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <vector>
+#include "../QueryOperator.h"
+
+class Field;
+
+namespace DatabaseEngine::StorageTypes {
+    class RowPredicate;
+    class Table;
+}
+
+namespace QueryOperators {
+    using namespace std;
+
+    // passes on the rows of its child that satisfy the conditions, the column index of a condition is the column's position in the child's rows
+    // conditions are compiled into a RowPredicate of the table on Open, so grouped conditions and null checks behave as in table selects
+    class FilterOperator final : public QueryOperator {
+        const DatabaseEngine::StorageTypes::Table *table;
+        vector<Field> conditions;
+        const DatabaseEngine::StorageTypes::RowPredicate *predicate;
+
+    protected:
+        void DeletePredicate();
+
+    public:
+        FilterOperator(QueryOperator *child, const DatabaseEngine::StorageTypes::Table *table, const vector<Field> &conditions);
+        ~FilterOperator() override;
+
+        void Open() override;
+        [[nodiscard]] bool Next(const DatabaseEngine::StorageTypes::Row *&row) override;
+        void Close() override;
+    };
+}
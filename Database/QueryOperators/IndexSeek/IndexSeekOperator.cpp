@@ -0,0 +1,75 @@
+#include "IndexSeekOperator.h"
+#include "../../Database.h"
+#include "../../Table/Table.h"
+#include "../../Row/Row.h"
+#include "../../Column/Column.h"
+#include "../../Pages/Page.h"
+#include "../../Storage/StorageManager/StorageManager.h"
+
+using namespace DatabaseEngine;
+using namespace DatabaseEngine::StorageTypes;
+using namespace Indexing;
+using namespace Pages;
+using namespace Storage;
+
+namespace QueryOperators {
+    IndexSeekOperator::IndexSeekOperator(Table *table, const vector<column_index_t> &selectedColumnIndices, const Key &minimumValue, const Key &maximumValue, const bool &isIndexSeek)
+        : minimumValue(minimumValue), maximumValue(maximumValue)
+    {
+        this->table = table;
+        this->selectedColumnIndices = selectedColumnIndices;
+        this->isIndexSeek = isIndexSeek;
+        this->resultPosition = 0;
+
+        if (!this->selectedColumnIndices.empty())
+            return;
+
+        for (const auto &column : table->GetColumns())
+            this->selectedColumnIndices.push_back(column->GetColumnIndex());
+    }
+
+    IndexSeekOperator::~IndexSeekOperator() = default;
+
+    void IndexSeekOperator::Open()
+    {
+        this->results.clear();
+        this->resultPosition = 0;
+
+        const BPlusTree *tree = this->table->GetClusteredIndexedTree();
+
+        if (this->isIndexSeek)
+            tree->RangeQuery(this->minimumValue, this->maximumValue, this->results);
+        else
+            tree->IndexScan(this->minimumValue, this->maximumValue, this->results);
+    }
+
+    bool IndexSeekOperator::Next(const Row *&row)
+    {
+        this->currentRow.clear();
+
+        if (this->resultPosition >= this->results.size())
+            return false;
+
+        const QueryData &result = this->results[this->resultPosition];
+        this->resultPosition++;
+
+        // consecutive rows of the same page keep it pinned
+        if (this->page == nullptr || this->page->GetPageId() != result.pageId)
+            this->page = StorageManager::Get().GetPage(result.pageId, Database::CalculateExtentIdByPageId(result.pageId), this->table);
+
+        vector<Row> *rows = &this->currentRow;
+
+        this->page->GetRowByIndex(rows, *this->table, result.indexPosition, this->selectedColumnIndices);
+
+        row = &this->currentRow.back();
+
+        return true;
+    }
+
+    void IndexSeekOperator::Close()
+    {
+        this->currentRow.clear();
+        this->page.Release();
+        this->results = vector<QueryData>();
+    }
+}
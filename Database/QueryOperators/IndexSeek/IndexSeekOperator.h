@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include "../QueryOperator.h"
+#include "../../B+Tree/BPlusTree.h"
+#include "../../Storage/PageGuard/PageGuard.h"
+
+namespace Pages {
+    class Page;
+}
+
+namespace DatabaseEngine::StorageTypes {
+    class Table;
+}
+
+namespace QueryOperators {
+    using namespace std;
+
+    // rows of the clustered index between two keys, the tree hands out row positions and each row is read from its page when pulled
+    // a seek walks the range of the leading key column, a scan compares the key column the keys point at
+    class IndexSeekOperator final : public QueryOperator {
+        DatabaseEngine::StorageTypes::Table *table;
+        vector<column_index_t> selectedColumnIndices;
+        Indexing::Key minimumValue;
+        Indexing::Key maximumValue;
+        bool isIndexSeek;
+        vector<Indexing::QueryData> results;
+        size_t resultPosition;
+        Storage::PageGuard<Pages::Page> page;
+        vector<DatabaseEngine::StorageTypes::Row> currentRow;
+
+    public:
+        IndexSeekOperator(DatabaseEngine::StorageTypes::Table *table, const vector<column_index_t> &selectedColumnIndices, const Indexing::Key &minimumValue, const Indexing::Key &maximumValue, const bool &isIndexSeek);
+        ~IndexSeekOperator() override;
+
+        void Open() override;
+        [[nodiscard]] bool Next(const DatabaseEngine::StorageTypes::Row *&row) override;
+        void Close() override;
+    };
+}
@@ -0,0 +1,34 @@
+#include "LimitOperator.h"
+
+using namespace DatabaseEngine::StorageTypes;
+
+namespace QueryOperators {
+    LimitOperator::LimitOperator(QueryOperator *child, const size_t &limit)
+        : QueryOperator(child)
+    {
+        this->limit = limit;
+        this->rowsReturned = 0;
+    }
+
+    LimitOperator::~LimitOperator() = default;
+
+    void LimitOperator::Open()
+    {
+        this->rowsReturned = 0;
+
+        QueryOperator::Open();
+    }
+
+    bool LimitOperator::Next(const Row *&row)
+    {
+        if (this->rowsReturned >= this->limit)
+            return false;
+
+        if (!this->child->Next(row))
+            return false;
+
+        this->rowsReturned++;
+
+        return true;
+    }
+}
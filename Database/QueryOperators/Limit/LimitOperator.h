@@ -0,0 +1,17 @@
+#pragma once
+#include "../QueryOperator.h"
+
+namespace QueryOperators {
+    // hands out at most limit rows of its child and stops pulling from it after that
+    class LimitOperator final : public QueryOperator {
+        size_t limit;
+        size_t rowsReturned;
+
+    public:
+        LimitOperator(QueryOperator *child, const size_t &limit);
+        ~LimitOperator() override;
+
+        void Open() override;
+        [[nodiscard]] bool Next(const DatabaseEngine::StorageTypes::Row *&row) override;
+    };
+}
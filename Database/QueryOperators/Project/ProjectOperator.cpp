@@ -0,0 +1,52 @@
+#include "ProjectOperator.h"
+#include "../../../AdditionalLibraries/InlineBitSet/InlineBitSet.h"
+#include "../../Row/Row.h"
+#include "../../Table/Table.h"
+
+using namespace DatabaseEngine::StorageTypes;
+
+namespace QueryOperators {
+    ProjectOperator::ProjectOperator(QueryOperator *child, const Table *table, const vector<column_index_t> &columnIndices)
+        : QueryOperator(child)
+    {
+        this->table = table;
+        this->columnIndices = columnIndices;
+    }
+
+    ProjectOperator::~ProjectOperator() = default;
+
+    bool ProjectOperator::Next(const Row *&row)
+    {
+        this->currentRow.clear();
+
+        const Row *childRow;
+
+        if (!this->child->Next(childRow))
+            return false;
+
+        vector<Block *> projectedBlocks;
+        projectedBlocks.reserve(this->columnIndices.size());
+
+        ByteMaps::InlineBitSet nullBitMap(this->columnIndices.size());
+
+        for (size_t i = 0; i < this->columnIndices.size(); i++)
+        {
+            projectedBlocks.push_back(childRow->GetData()[this->columnIndices[i]]);
+            nullBitMap.Set(i, childRow->GetNullBitMapValue(this->columnIndices[i]));
+        }
+
+        // the row copies the blocks, the child's row is only borrowed until its next call
+        this->currentRow.emplace_back(*this->table, projectedBlocks, &nullBitMap, nullptr);
+
+        row = &this->currentRow.back();
+
+        return true;
+    }
+
+    void ProjectOperator::Close()
+    {
+        this->currentRow.clear();
+
+        QueryOperator::Close();
+    }
+}
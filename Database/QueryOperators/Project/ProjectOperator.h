@@ -0,0 +1,25 @@
+#pragma once
+#include <vector>
+#include "../QueryOperator.h"
+
+namespace DatabaseEngine::StorageTypes {
+    class Table;
+}
+
+namespace QueryOperators {
+    using namespace std;
+
+    // narrows the rows of its child down to the given column positions, in the order they are given
+    class ProjectOperator final : public QueryOperator {
+        const DatabaseEngine::StorageTypes::Table *table;
+        vector<column_index_t> columnIndices;
+        vector<DatabaseEngine::StorageTypes::Row> currentRow;
+
+    public:
+        ProjectOperator(QueryOperator *child, const DatabaseEngine::StorageTypes::Table *table, const vector<column_index_t> &columnIndices);
+        ~ProjectOperator() override;
+
+        [[nodiscard]] bool Next(const DatabaseEngine::StorageTypes::Row *&row) override;
+        void Close() override;
+    };
+}
@@ -0,0 +1,19 @@
+#include "QueryOperator.h"
+
+namespace QueryOperators {
+    QueryOperator::QueryOperator(QueryOperator *child) { this->child = child; }
+
+    QueryOperator::~QueryOperator() { delete this->child; }
+
+    void QueryOperator::Open()
+    {
+        if (this->child != nullptr)
+            this->child->Open();
+    }
+
+    void QueryOperator::Close()
+    {
+        if (this->child != nullptr)
+            this->child->Close();
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "../Constants.h"
+
+using namespace Constants;
+
+namespace DatabaseEngine::StorageTypes {
+    class Row;
+}
+
+namespace QueryOperators {
+    // node of a pull based query plan: Open prepares it, every Next hands out one row until it returns false, Close lets go of what it holds
+    // a row handed out stays valid until the next Next or Close on the same operator, operators that need to keep rows copy them
+    class QueryOperator {
+    protected:
+        // the operator rows are pulled from, owned and deleted by this one
+        QueryOperator *child;
+
+    public:
+        explicit QueryOperator(QueryOperator *child = nullptr);
+        QueryOperator(const QueryOperator &other) = delete;
+        virtual ~QueryOperator();
+
+        virtual void Open();
+        [[nodiscard]] virtual bool Next(const DatabaseEngine::StorageTypes::Row *&row) = 0;
+        virtual void Close();
+    };
+}
@@ -0,0 +1,152 @@
+#include "ScanOperator.h"
+#include "../../../AdditionalLibraries/AdditionalDataTypes/Field/Field.h"
+#include "../../Database.h"
+#include "../../Table/Table.h"
+#include "../../Row/Row.h"
+#include "../../RowPredicate/RowPredicate.h"
+#include "../../Column/Column.h"
+#include "../../Pages/Page.h"
+#include "../../Pages/IndexMapAllocation/IndexAllocationMapPage.h"
+#include "../../Pages/PageFreeSpace/PageFreeSpacePage.h"
+#include "../../Storage/StorageManager/StorageManager.h"
+
+using namespace DatabaseEngine;
+using namespace DatabaseEngine::StorageTypes;
+using namespace Pages;
+using namespace Storage;
+
+namespace QueryOperators {
+    ScanOperator::ScanOperator(const Table *table, const vector<column_index_t> &selectedColumnIndices, const vector<Field> &conditions)
+    {
+        this->table = table;
+        this->selectedColumnIndices = selectedColumnIndices;
+        this->conditions = conditions;
+        this->predicate = nullptr;
+        this->tableMapPage = nullptr;
+        this->pageFreeSpacePage = nullptr;
+        this->extentPosition = 0;
+        this->extentId = 0;
+        this->nextPageId = 0;
+        this->extentEndPageId = 0;
+        this->rowIndex = 0;
+
+        if (!this->selectedColumnIndices.empty())
+            return;
+
+        for (const auto &column : table->GetColumns())
+            this->selectedColumnIndices.push_back(column->GetColumnIndex());
+    }
+
+    ScanOperator::~ScanOperator() { this->DeletePredicate(); }
+
+    void ScanOperator::Open()
+    {
+        this->extentIds.clear();
+        this->extentPosition = 0;
+        this->nextPageId = 0;
+        this->extentEndPageId = 0;
+        this->page.Release();
+
+        this->DeletePredicate();
+
+        if (!this->conditions.empty())
+            this->predicate = new RowPredicate(*this->table, this->conditions);
+
+        const page_id_t indexAllocationMapPageId = this->table->GetTableHeader().indexAllocationMapPageId;
+
+        if (indexAllocationMapPageId == 0)
+            return;
+
+        this->tableMapPage = StorageManager::Get().GetIndexAllocationMapPage(indexAllocationMapPageId);
+        this->tableMapPage->GetAllocatedExtents(&this->extentIds);
+    }
+
+    bool ScanOperator::NextPage()
+    {
+        this->page.Release();
+
+        while (true)
+        {
+            if (this->nextPageId >= this->extentEndPageId)
+            {
+                if (this->extentPosition >= this->extentIds.size())
+                    return false;
+
+                this->extentId = this->extentIds[this->extentPosition];
+                this->extentPosition++;
+
+                const page_id_t extentFirstPageId = Database::CalculateSystemPageOffset(this->extentId * EXTENT_SIZE);
+
+                this->pageFreeSpacePage = StorageManager::Get().GetPageFreeSpacePage(Database::GetPfsAssociatedPage(extentFirstPageId));
+
+                // the first page of the first extent can be the table's allocation map
+                this->nextPageId = (this->tableMapPage->GetPageId() != extentFirstPageId)
+                                    ? extentFirstPageId
+                                    : extentFirstPageId + 1;
+
+                this->extentEndPageId = extentFirstPageId + EXTENT_SIZE;
+
+                continue;
+            }
+
+            // data pages of an extent come first, the rest of it is not read
+            if (this->pageFreeSpacePage->GetPageType(this->nextPageId) != PageType::DATA)
+            {
+                this->nextPageId = this->extentEndPageId;
+                continue;
+            }
+
+            this->page = StorageManager::Get().GetPage(this->nextPageId, this->extentId, this->table);
+            this->nextPageId++;
+            this->rowIndex = 0;
+
+            if (this->page->GetPageSize() == 0)
+                continue;
+
+            return true;
+        }
+    }
+
+    bool ScanOperator::Next(const Row *&row)
+    {
+        this->currentRow.clear();
+
+        while (true)
+        {
+            while (this->page == nullptr || this->rowIndex >= this->page->GetPageSize())
+                if (!this->NextPage())
+                    return false;
+
+            // rows that fail the conditions are checked through their views and never copied
+            if (this->predicate == nullptr || this->page->IsRowMatch(this->rowIndex, *this->predicate))
+                break;
+
+            this->rowIndex++;
+        }
+
+        vector<Row> *rows = &this->currentRow;
+
+        this->page->GetRowByIndex(rows, *this->table, this->rowIndex, this->selectedColumnIndices);
+        this->rowIndex++;
+
+        row = &this->currentRow.back();
+
+        return true;
+    }
+
+    void ScanOperator::Close()
+    {
+        this->currentRow.clear();
+        this->page.Release();
+        this->extentIds.clear();
+
+        this->DeletePredicate();
+    }
+
+    void ScanOperator::DeletePredicate()
+    {
+        delete this->predicate;
+
+        this->predicate = nullptr;
+    }
+}
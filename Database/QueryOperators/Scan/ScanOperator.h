@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include "../QueryOperator.h"
+#include "../../Storage/PageGuard/PageGuard.h"
+
+class Field;
+
+namespace Pages {
+    class Page;
+    class IndexAllocationMapPage;
+    class PageFreeSpacePage;
+}
+
+namespace DatabaseEngine::StorageTypes {
+    class RowPredicate;
+    class Table;
+}
+
+namespace QueryOperators {
+    using namespace std;
+
+    // walks the data pages of the table extent by extent, a page is only pinned while its rows are being handed out
+    // rows carry the selected columns in the order they were selected, every column when none are given
+    // conditions index the columns of the table, rows are checked on the page and only matching ones are copied out
+    class ScanOperator final : public QueryOperator {
+        const DatabaseEngine::StorageTypes::Table *table;
+        vector<column_index_t> selectedColumnIndices;
+        vector<Field> conditions;
+        const DatabaseEngine::StorageTypes::RowPredicate *predicate;
+        const Pages::IndexAllocationMapPage *tableMapPage;
+        const Pages::PageFreeSpacePage *pageFreeSpacePage;
+        vector<extent_id_t> extentIds;
+        size_t extentPosition;
+        extent_id_t extentId;
+        page_id_t nextPageId;
+        page_id_t extentEndPageId;
+        Storage::PageGuard<Pages::Page> page;
+        page_size_t rowIndex;
+        vector<DatabaseEngine::StorageTypes::Row> currentRow;
+
+    protected:
+        bool NextPage();
+        void DeletePredicate();
+
+    public:
+        ScanOperator(const DatabaseEngine::StorageTypes::Table *table, const vector<column_index_t> &selectedColumnIndices, const vector<Field> &conditions = {});
+        ~ScanOperator() override;
+
+        void Open() override;
+        [[nodiscard]] bool Next(const DatabaseEngine::StorageTypes::Row *&row) override;
+        void Close() override;
+    };
+}
@@ -0,0 +1,68 @@
+#include "SortOperator.h"
+#include "../../AdditionalFunctions/SortingFunctions.h"
+#include "../../Row/Row.h"
+
+using namespace DatabaseEngine::StorageTypes;
+
+namespace QueryOperators {
+    SortOperator::SortOperator(QueryOperator *child, const vector<SortCondition> &sortConditions)
+        : QueryOperator(child)
+    {
+        this->sortConditions = sortConditions;
+        this->rowPosition = 0;
+        this->isSorted = false;
+    }
+
+    SortOperator::~SortOperator() = default;
+
+    void SortOperator::Open()
+    {
+        this->rows.clear();
+        this->sortedRows.clear();
+        this->rowPosition = 0;
+        this->isSorted = false;
+
+        QueryOperator::Open();
+    }
+
+    void SortOperator::SortChildRows()
+    {
+        const Row *row;
+
+        while (this->child->Next(row))
+            this->rows.emplace_back(*row);
+
+        // pointers are taken once rows stops growing
+        this->sortedRows.reserve(this->rows.size());
+
+        for (auto &sortRow : this->rows)
+            this->sortedRows.push_back(&sortRow);
+
+        if (!this->sortConditions.empty())
+            SortingFunctions::OrderBy(this->sortedRows, this->sortConditions);
+
+        this->isSorted = true;
+    }
+
+    bool SortOperator::Next(const Row *&row)
+    {
+        if (!this->isSorted)
+            this->SortChildRows();
+
+        if (this->rowPosition >= this->sortedRows.size())
+            return false;
+
+        row = this->sortedRows[this->rowPosition];
+        this->rowPosition++;
+
+        return true;
+    }
+
+    void SortOperator::Close()
+    {
+        this->rows = vector<Row>();
+        this->sortedRows = vector<Row *>();
+
+        QueryOperator::Close();
+    }
+}
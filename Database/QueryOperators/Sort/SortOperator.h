@@ -0,0 +1,28 @@
+#pragma once
+#include <vector>
+#include "../QueryOperator.h"
+#include "../../../AdditionalLibraries/AdditionalDataTypes/SortCondition/SortCondition.h"
+
+namespace QueryOperators {
+    using namespace std;
+
+    // blocking: the first Next pulls every row of its child and keeps a copy of each, they are then handed out in order
+    class SortOperator final : public QueryOperator {
+        vector<SortCondition> sortConditions;
+        vector<DatabaseEngine::StorageTypes::Row> rows;
+        vector<DatabaseEngine::StorageTypes::Row *> sortedRows;
+        size_t rowPosition;
+        bool isSorted;
+
+    protected:
+        void SortChildRows();
+
+    public:
+        SortOperator(QueryOperator *child, const vector<SortCondition> &sortConditions);
+        ~SortOperator() override;
+
+        void Open() override;
+        [[nodiscard]] bool Next(const DatabaseEngine::StorageTypes::Row *&row) override;
+        void Close() override;
+    };
+}
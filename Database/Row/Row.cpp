@@ -2,6 +2,7 @@
 #include "../../AdditionalLibraries/BitMap/BitMap.h"
 #include "../Table/Table.h"
 #include "../Block/Block.h"
+#include "../RowView/RowView.h"
 #include "../../AdditionalLibraries/AdditionalDataTypes/DateTime/DateTime.h"
 #include "../../AdditionalLibraries/AdditionalDataTypes/Decimal/Decimal.h"
 #include "../Column/Column.h"
@@ -19,28 +20,9 @@ namespace DatabaseEngine::StorageTypes {
     {
         this->rowSize = 0;
         this->maxRowSize = 0;
-        this->nullBitMap = nullptr;
-        this->largeObjectBitMap = nullptr;
     }
 
-    RowHeader::~RowHeader()
-    {
-        delete this->nullBitMap;
-        delete this->largeObjectBitMap;
-    }
-
-    RowHeader & RowHeader::operator=(const RowHeader &otherHeader)
-    {
-        if (this == &otherHeader)
-            return *this;
-
-        this->rowSize = otherHeader.rowSize;
-        this->maxRowSize = otherHeader.maxRowSize;
-        this->nullBitMap = new BitMap(*otherHeader.nullBitMap);
-        // this->largeObjectBitMap = new BitMap(*otherHeader.largeObjectBitMap);
-
-        return *this;
-    }
+    RowHeader::~RowHeader() = default;
 
     Row::Row(const Table& table)
     {
@@ -50,18 +32,22 @@ namespace DatabaseEngine::StorageTypes {
         
         this->data.resize(numberOfColumns);
 
-        this->header.nullBitMap = new BitMap(numberOfColumns);
-        this->header.largeObjectBitMap = new BitMap(numberOfColumns);
+        this->header.nullBitMap = InlineBitSet(numberOfColumns);
+        this->header.largeObjectBitMap = InlineBitSet(numberOfColumns);
     }
 
-    Row::Row(const Table& table, const vector<Block*>& data, const BitMap* nullBitMap)
+    Row::Row(const Table& table, const vector<Block*>& data, const InlineBitSet* nullBitMap, Arenas::MonotonicArena* arena)
     {
         this->table = &table;
 
-        this->header.nullBitMap = new BitMap(*nullBitMap);
+        // large objects are resolved into the copied blocks
+        this->header.nullBitMap = *nullBitMap;
+        this->header.largeObjectBitMap = InlineBitSet(nullBitMap->GetSize());
         
+        this->data.reserve(data.size());
+
         for (const auto& block : data)
-            this->data.push_back(new Block(block));
+            this->data.push_back(new (arena) Block(block, arena));
         
         this->UpdateRowSize();
         this->header.maxRowSize = 0;
@@ -76,6 +62,18 @@ namespace DatabaseEngine::StorageTypes {
             this->data.push_back(new Block(block));
     }
 
+    Row::Row(Row &&moveRow) noexcept
+    {
+        this->table = moveRow.table;
+        this->header.rowSize = moveRow.header.rowSize;
+        this->header.maxRowSize = moveRow.header.maxRowSize;
+        this->header.nullBitMap = std::move(moveRow.header.nullBitMap);
+        this->header.largeObjectBitMap = std::move(moveRow.header.largeObjectBitMap);
+        this->data = std::move(moveRow.data);
+
+        moveRow.data.clear();
+    }
+
     Row & Row::operator=(const Row &copyRow)
     {
         if (this == &copyRow)
@@ -113,7 +111,7 @@ namespace DatabaseEngine::StorageTypes {
 
     void Row::InsertNewColumn(Block *block)
     {
-        this->header.nullBitMap->Set(this->data.size(), block->GetBlockData() == nullptr);
+        this->header.nullBitMap.Set(this->data.size(), block->GetBlockData() == nullptr);
 
         this->data.push_back(block);
 
@@ -234,7 +232,12 @@ namespace DatabaseEngine::StorageTypes {
 
     unsigned char* Row::GetLargeObjectValue(const DataObjectPointer &objectPointer, uint32_t* objectSize) const
     {
-        LargeDataPage* page = this->table->GetLargeDataPage(objectPointer.pageId);
+        return Row::GetLargeObjectValue(*this->table, objectPointer, objectSize);
+    }
+
+    unsigned char* Row::GetLargeObjectValue(const Table &table, const DataObjectPointer &objectPointer, uint32_t* objectSize)
+    {
+        Storage::PageGuard<LargeDataPage> page = table.GetLargeDataPage(objectPointer.pageId);
 
         DataObject* object = page->GetObject(objectPointer.objectIndex);
 
@@ -249,7 +252,7 @@ namespace DatabaseEngine::StorageTypes {
             const page_id_t nextPageId = object->nextPageId;
             const large_page_index_t nextObjectIndex = object->nextObjectIndex;
             
-            page = this->table->GetLargeDataPage(nextPageId);
+            page = table.GetLargeDataPage(nextPageId);
             object = page->GetObject(nextObjectIndex);
 
             const page_size_t nextObjectSize = object->objectSize;
@@ -271,30 +274,48 @@ namespace DatabaseEngine::StorageTypes {
         return buffer;
     }
 
-    void Row::SetNullBitMapValue(const bit_map_pos_t &position, const bool &value) { this->header.nullBitMap->Set(position, value); }
+    void Row::SetNullBitMapValue(const bit_map_pos_t &position, const bool &value) { this->header.nullBitMap.Set(position, value); }
 
-    bool Row::GetNullBitMapValue(const bit_map_pos_t &position) const { return this->header.nullBitMap->Get(position); }
+    bool Row::GetNullBitMapValue(const bit_map_pos_t &position) const { return this->header.nullBitMap.Get(position); }
 
     RowHeader* Row::GetHeader() { return &this->header; }
 
+    const RowHeader* Row::GetHeader() const { return &this->header; }
+
     row_size_t Row::GetTotalRowSize() const
     {
         row_size_t currentRowSize = this->GetRowHeaderSize();
-        currentRowSize += this->table->GetNumberOfColumns() * sizeof(block_size_t); //decrease by the null blocks here
+        currentRowSize += sizeof(page_offset_t); // its entry in the slot directory of the page
 
+        column_index_t columnIndex = 0;
+
+        // null columns are not written
         for(const auto& block: this->data)
-            currentRowSize += block->GetBlockSize();
-        //currentRowSize += this->header.rowSize;
-        
+        {
+            if (!this->header.nullBitMap.Get(columnIndex))
+                currentRowSize += RowView::GetVarIntSize(block->GetBlockSize()) + block->GetBlockSize();
+
+            columnIndex++;
+        }
+
         return currentRowSize;
     }
 
+    // size of the compact header the row is written with, see RowView
     row_header_size_t Row::GetRowHeaderSize() const
     {
-        row_header_size_t rowHeaderSize = sizeof(row_size_t);
-        rowHeaderSize += sizeof(size_t);
-        rowHeaderSize += this->header.nullBitMap->GetSizeInBytes();
-        rowHeaderSize += this->header.largeObjectBitMap->GetSizeInBytes();
+        const bit_map_size_t numberOfColumns = this->data.size();
+        const bit_map_size_t bitMapBytes = (numberOfColumns + 7) / 8;
+
+        row_header_size_t rowHeaderSize = RowView::GetVarIntSize(this->header.rowSize);
+        rowHeaderSize += RowView::GetVarIntSize(numberOfColumns);
+        rowHeaderSize += sizeof(Constants::byte);
+
+        if (this->header.nullBitMap.HasAnySet())
+            rowHeaderSize += bitMapBytes;
+
+        if (this->header.largeObjectBitMap.HasAnySet())
+            rowHeaderSize += bitMapBytes;
 
         return rowHeaderSize;
     }
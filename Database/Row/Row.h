@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include <vector>
 #include "../Constants.h"
+#include "../../AdditionalLibraries/MonotonicArena/MonotonicArena.h"
+#include "../../AdditionalLibraries/InlineBitSet/InlineBitSet.h"
 
 namespace DatabaseEngine
 {
@@ -12,11 +14,6 @@ namespace Pages
     struct DataObjectPointer;
 }
 
-namespace ByteMaps
-{
-    class BitMap;
-}
-
 using namespace std;
 using namespace Constants;
 
@@ -27,17 +24,17 @@ namespace DatabaseEngine::StorageTypes
 
     typedef struct RowHeader
     {
-        ByteMaps::BitMap *nullBitMap;
-        ByteMaps::BitMap *largeObjectBitMap;
+        ByteMaps::InlineBitSet nullBitMap;
+        ByteMaps::InlineBitSet largeObjectBitMap;
         row_size_t rowSize;
         size_t maxRowSize;
 
         RowHeader();
         ~RowHeader();
-        RowHeader& operator= (const RowHeader& otherHeader);
     } RowHeader;
 
-    class Row
+    // rows decoded by a page live in the page's arena, rows handed back by a query in the query's arena when it has one
+    class Row : public Arenas::ArenaObject
     {
         RowHeader header;
         vector<Block *> data;
@@ -46,10 +43,12 @@ namespace DatabaseEngine::StorageTypes
     public:
         explicit Row(const Table &table);
 
-        explicit Row(const Table &table, const vector<Block *> &data, const ByteMaps::BitMap* nullBitMap);
+        explicit Row(const Table &table, const vector<Block *> &data, const ByteMaps::InlineBitSet* nullBitMap, Arenas::MonotonicArena *arena = nullptr);
 
         Row(const Row &copyRow);
 
+        Row(Row &&moveRow) noexcept;
+
         Row& operator=(const Row &copyRow);
 
         ~Row();
@@ -73,12 +72,16 @@ namespace DatabaseEngine::StorageTypes
 
         unsigned char *GetLargeObjectValue(const Pages::DataObjectPointer &objectPointer, uint32_t *objectSize) const;
 
+        static unsigned char *GetLargeObjectValue(const Table &table, const Pages::DataObjectPointer &objectPointer, uint32_t *objectSize);
+
         void SetNullBitMapValue(const bit_map_pos_t &position, const bool &value);
 
         [[nodiscard]] bool GetNullBitMapValue(const bit_map_pos_t &position) const;
 
         RowHeader *GetHeader();
 
+        [[nodiscard]] const RowHeader *GetHeader() const;
+
         [[nodiscard]] row_size_t GetTotalRowSize() const;
 
         [[nodiscard]] row_header_size_t GetRowHeaderSize() const;
@@ -0,0 +1,325 @@
+#include "RowPredicate.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include "../../AdditionalLibraries/AdditionalDataTypes/Field/Field.h"
+#include "../Block/Block.h"
+#include "../Column/Column.h"
+#include "../Row/Row.h"
+#include "../RowView/RowView.h"
+#include "../Table/Table.h"
+#include "../Pages/LargeObject/LargeDataPage.h"
+
+namespace DatabaseEngine::StorageTypes
+{
+    RowPredicate::RowPredicate(const Table &table, const vector<Field> &conditions)
+    {
+        this->table = &table;
+
+        this->Compile(conditions, this->comparisons);
+
+        sort(this->columnIndices.begin(), this->columnIndices.end());
+        this->columnIndices.erase(unique(this->columnIndices.begin(), this->columnIndices.end()), this->columnIndices.end());
+    }
+
+    RowPredicate::~RowPredicate() = default;
+
+    void RowPredicate::Compile(const vector<Field> &conditions, vector<Comparison> &compiledConditions)
+    {
+        for (const auto &condition : conditions)
+        {
+            if (!condition.GetChildren().empty())
+            {
+                Comparison group;
+                group.columnIndex = 0;
+                group.conditionType = condition.GetConditionType();
+
+                this->Compile(condition.GetChildren(), group.children);
+
+                compiledConditions.push_back(group);
+                continue;
+            }
+
+            compiledConditions.push_back(this->CompileCondition(condition));
+            this->columnIndices.push_back(condition.GetColumnIndex());
+        }
+    }
+
+    RowPredicate::Comparison RowPredicate::CompileCondition(const Field &condition) const
+    {
+        const column_index_t &columnIndex = condition.GetColumnIndex();
+
+        if (columnIndex >= this->table->GetColumns().size())
+            throw invalid_argument("RowPredicate::CompileCondition: Column index out of range");
+
+        Comparison comparison;
+        comparison.columnIndex = columnIndex;
+        comparison.conditionType = condition.GetConditionType();
+
+        const Operator operatorType = condition.GetOperatorType();
+
+        if (condition.GetIsNull())
+        {
+            switch (operatorType)
+            {
+                case OperatorNone:
+                case Equal:
+                    comparison.isMet = [](const object_t *value, const block_size_t &) { return value == nullptr; };
+                    break;
+                case NotEqual:
+                    comparison.isMet = [](const object_t *value, const block_size_t &) { return value != nullptr; };
+                    break;
+                default:
+                    throw invalid_argument("RowPredicate::CompileCondition: Null can only be compared for equality");
+            }
+
+            return comparison;
+        }
+
+        // the constant is converted to the column type once, here, instead of once per row
+        const unique_ptr<const Block> conditionBlock(this->table->CreateConditionBlock(condition));
+        const object_t *constant = conditionBlock->GetBlockData();
+
+        switch (this->table->GetColumns()[columnIndex]->GetColumnType())
+        {
+            case ColumnType::TinyInt:
+            {
+                int8_t value;
+                memcpy(&value, constant, sizeof(int8_t));
+                comparison.isMet = RowPredicate::BindComparison(value, operatorType);
+                break;
+            }
+            case ColumnType::SmallInt:
+            {
+                int16_t value;
+                memcpy(&value, constant, sizeof(int16_t));
+                comparison.isMet = RowPredicate::BindComparison(value, operatorType);
+                break;
+            }
+            case ColumnType::Int:
+            {
+                int32_t value;
+                memcpy(&value, constant, sizeof(int32_t));
+                comparison.isMet = RowPredicate::BindComparison(value, operatorType);
+                break;
+            }
+            case ColumnType::BigInt:
+            {
+                int64_t value;
+                memcpy(&value, constant, sizeof(int64_t));
+                comparison.isMet = RowPredicate::BindComparison(value, operatorType);
+                break;
+            }
+            case ColumnType::Bool:
+            {
+                bool value;
+                memcpy(&value, constant, sizeof(bool));
+                comparison.isMet = RowPredicate::BindComparison(value, operatorType);
+                break;
+            }
+            case ColumnType::DateTime:
+            {
+                time_t value;
+                memcpy(&value, constant, sizeof(time_t));
+                comparison.isMet = RowPredicate::BindComparison(value, operatorType);
+                break;
+            }
+            case ColumnType::String:
+            case ColumnType::UnicodeString:
+                comparison.isMet = RowPredicate::BindBytesComparison(string(reinterpret_cast<const char *>(constant), conditionBlock->GetBlockSize()), operatorType, true);
+                break;
+            case ColumnType::Decimal:
+                // decimals have no ordering yet, see SortingFunctions::CompareBlockByDataType
+                comparison.isMet = RowPredicate::BindBytesComparison(string(reinterpret_cast<const char *>(constant), conditionBlock->GetBlockSize()), operatorType, false);
+                break;
+            default:
+                throw invalid_argument("RowPredicate::CompileCondition: Unsupported column type");
+        }
+
+        return comparison;
+    }
+
+    template<typename T>
+    function<bool(const object_t *, const block_size_t &)> RowPredicate::BindComparison(const T &constant, const Operator &operatorType)
+    {
+        // values in a page image are not aligned, they are copied out instead of being read in place
+        switch (operatorType)
+        {
+            case OperatorNone:
+            case Equal:
+                return [constant](const object_t *value, const block_size_t &) { T columnValue; return value != nullptr && (memcpy(&columnValue, value, sizeof(T)), columnValue == constant); };
+            case NotEqual:
+                return [constant](const object_t *value, const block_size_t &) { T columnValue; return value != nullptr && (memcpy(&columnValue, value, sizeof(T)), columnValue != constant); };
+            case GreaterThan:
+                return [constant](const object_t *value, const block_size_t &) { T columnValue; return value != nullptr && (memcpy(&columnValue, value, sizeof(T)), columnValue > constant); };
+            case LessThan:
+                return [constant](const object_t *value, const block_size_t &) { T columnValue; return value != nullptr && (memcpy(&columnValue, value, sizeof(T)), columnValue < constant); };
+            case GreaterOrEqual:
+                return [constant](const object_t *value, const block_size_t &) { T columnValue; return value != nullptr && (memcpy(&columnValue, value, sizeof(T)), columnValue >= constant); };
+            case LessOrEqual:
+                return [constant](const object_t *value, const block_size_t &) { T columnValue; return value != nullptr && (memcpy(&columnValue, value, sizeof(T)), columnValue <= constant); };
+            default:
+                throw invalid_argument("RowPredicate::BindComparison: Unsupported operator");
+        }
+    }
+
+    function<bool(const object_t *, const block_size_t &)> RowPredicate::BindBytesComparison(const string &constant, const Operator &operatorType, const bool &isOrdered)
+    {
+        switch (operatorType)
+        {
+            case OperatorNone:
+            case Equal:
+                return [constant](const object_t *value, const block_size_t &size) { return value != nullptr && RowPredicate::CompareBytes(value, size, constant) == 0; };
+            case NotEqual:
+                return [constant](const object_t *value, const block_size_t &size) { return value != nullptr && RowPredicate::CompareBytes(value, size, constant) != 0; };
+            default:
+                break;
+        }
+
+        if (!isOrdered)
+            throw invalid_argument("RowPredicate::BindBytesComparison: Column type can only be compared for equality");
+
+        switch (operatorType)
+        {
+            case GreaterThan:
+                return [constant](const object_t *value, const block_size_t &size) { return value != nullptr && RowPredicate::CompareBytes(value, size, constant) > 0; };
+            case LessThan:
+                return [constant](const object_t *value, const block_size_t &size) { return value != nullptr && RowPredicate::CompareBytes(value, size, constant) < 0; };
+            case GreaterOrEqual:
+                return [constant](const object_t *value, const block_size_t &size) { return value != nullptr && RowPredicate::CompareBytes(value, size, constant) >= 0; };
+            case LessOrEqual:
+                return [constant](const object_t *value, const block_size_t &size) { return value != nullptr && RowPredicate::CompareBytes(value, size, constant) <= 0; };
+            default:
+                throw invalid_argument("RowPredicate::BindBytesComparison: Unsupported operator");
+        }
+    }
+
+    int RowPredicate::CompareBytes(const object_t *value, const block_size_t &size, const string &constant)
+    {
+        if (size < constant.size()) return -1;
+        if (size > constant.size()) return 1;
+
+        const int result = memcmp(value, constant.data(), size);
+
+        if (result < 0) return -1;
+        if (result > 0) return 1;
+        return 0;
+    }
+
+    bool RowPredicate::Evaluate(const vector<Comparison> &compiledConditions, const object_t *const *columnData, const block_size_t *columnSizes) const
+    {
+        bool isMatch = true;
+
+        for (size_t i = 0; i < compiledConditions.size(); i++)
+        {
+            const Comparison &comparison = compiledConditions[i];
+            const bool isOr = comparison.conditionType == ConditionType::Or;
+
+            // the rest of the comparison cannot change the result
+            if (i > 0 && (isOr ? isMatch : !isMatch))
+                continue;
+
+            const bool isConditionMet = comparison.children.empty()
+                                        ? comparison.isMet(columnData[comparison.columnIndex], columnSizes[comparison.columnIndex])
+                                        : this->Evaluate(comparison.children, columnData, columnSizes);
+
+            if (i == 0)
+            {
+                isMatch = isConditionMet;
+                continue;
+            }
+
+            isMatch = isOr
+                        ? isMatch || isConditionMet
+                        : isMatch && isConditionMet;
+        }
+
+        return isMatch;
+    }
+
+    bool RowPredicate::Matches(const Row *row) const
+    {
+        if (this->comparisons.empty())
+            return true;
+
+        const object_t *columnData[numeric_limits<column_index_t>::max() + 1];
+        block_size_t columnSizes[numeric_limits<column_index_t>::max() + 1];
+
+        const auto &rowData = row->GetData();
+        const RowHeader *rowHeader = row->GetHeader();
+
+        vector<unique_ptr<unsigned char[]>> largeValues;
+
+        for (const auto &columnIndex : this->columnIndices)
+        {
+            columnData[columnIndex] = nullptr;
+            columnSizes[columnIndex] = 0;
+
+            if (columnIndex >= rowData.size() || rowData[columnIndex]->GetBlockData() == nullptr)
+                continue;
+
+            const Block *block = rowData[columnIndex];
+
+            if (rowHeader->largeObjectBitMap.Get(columnIndex))
+            {
+                Pages::DataObjectPointer objectPointer;
+                memcpy(&objectPointer, block->GetBlockData(), sizeof(Pages::DataObjectPointer));
+
+                uint32_t objectSize;
+                largeValues.emplace_back(row->GetLargeObjectValue(objectPointer, &objectSize));
+
+                columnData[columnIndex] = largeValues.back().get();
+                columnSizes[columnIndex] = objectSize;
+                continue;
+            }
+
+            columnData[columnIndex] = block->GetBlockData();
+            columnSizes[columnIndex] = block->GetBlockSize();
+        }
+
+        return this->Evaluate(this->comparisons, columnData, columnSizes);
+    }
+
+    bool RowPredicate::Matches(const RowView &rowView) const
+    {
+        if (this->comparisons.empty())
+            return true;
+
+        const object_t *columnData[numeric_limits<column_index_t>::max() + 1];
+        block_size_t columnSizes[numeric_limits<column_index_t>::max() + 1];
+
+        vector<unique_ptr<unsigned char[]>> largeValues;
+
+        // one pass over the row up to the last column a comparison reads
+        const char *column = rowView.GetFirstColumn();
+        const size_t lastColumnIndex = this->columnIndices.back();
+
+        for (size_t i = 0; i <= lastColumnIndex; i++)
+        {
+            columnData[i] = nullptr;
+            columnSizes[i] = 0;
+
+            if (i >= rowView.GetNumberOfColumns() || rowView.IsNull(i))
+                continue;
+
+            columnData[i] = rowView.ReadColumn(column, columnSizes[i]);
+
+            // large objects are only fetched for the columns that are compared
+            if (!rowView.IsLargeObject(i) || !binary_search(this->columnIndices.begin(), this->columnIndices.end(), i))
+                continue;
+
+            Pages::DataObjectPointer objectPointer;
+            memcpy(&objectPointer, columnData[i], sizeof(Pages::DataObjectPointer));
+
+            uint32_t objectSize;
+            largeValues.emplace_back(Row::GetLargeObjectValue(*this->table, objectPointer, &objectSize));
+
+            columnData[i] = largeValues.back().get();
+            columnSizes[i] = objectSize;
+        }
+
+        return this->Evaluate(this->comparisons, columnData, columnSizes);
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include "../Constants.h"
+
+using namespace std;
+using namespace Constants;
+
+class Field;
+
+namespace DatabaseEngine::StorageTypes
+{
+    class Row;
+    class RowView;
+    class Table;
+
+    // WHERE conditions compiled once per query against the column types of the table
+    // every condition is bound to a typed comparison of its constant, a row only has the columns the conditions name read from it
+    // each condition after the first is combined with the ones before it by its ConditionType, And when it has none, children are evaluated as one group
+    // null values fail every comparison, a null condition with Equal or NotEqual matches IS NULL or IS NOT NULL
+    class RowPredicate
+    {
+        typedef struct Comparison
+        {
+            column_index_t columnIndex;
+            ConditionType conditionType;
+            // nullptr value for null columns
+            function<bool(const object_t *value, const block_size_t &size)> isMet;
+            vector<Comparison> children;
+        } Comparison;
+
+        const Table *table;
+        vector<Comparison> comparisons;
+        // every column some comparison reads, in ascending order
+        vector<column_index_t> columnIndices;
+
+    protected:
+        void Compile(const vector<Field> &conditions, vector<Comparison> &compiledConditions);
+        [[nodiscard]] Comparison CompileCondition(const Field &condition) const;
+        [[nodiscard]] bool Evaluate(const vector<Comparison> &compiledConditions, const object_t *const *columnData, const block_size_t *columnSizes) const;
+
+        template<typename T>
+        [[nodiscard]] static function<bool(const object_t *, const block_size_t &)> BindComparison(const T &constant, const Operator &operatorType);
+        [[nodiscard]] static function<bool(const object_t *, const block_size_t &)> BindBytesComparison(const string &constant, const Operator &operatorType, const bool &isOrdered);
+        // same order as SortingFunctions::CompareBlockByDataType, shorter values first, then byte by byte
+        [[nodiscard]] static int CompareBytes(const object_t *value, const block_size_t &size, const string &constant);
+
+    public:
+        RowPredicate(const Table &table, const vector<Field> &conditions);
+        ~RowPredicate();
+
+        [[nodiscard]] bool Matches(const Row *row) const;
+        [[nodiscard]] bool Matches(const RowView &rowView) const;
+    };
+}
@@ -0,0 +1,191 @@
+#include "RowView.h"
+#include <cstring>
+
+namespace DatabaseEngine::StorageTypes
+{
+    RowView::RowView(const char *data, const RowFormat &format)
+    {
+        this->data = data;
+        this->format = format;
+
+        if (format == RowFormat::COMPACT)
+        {
+            const char *position = data;
+
+            this->rowSize = RowView::ReadVarInt(position);
+            this->numberOfColumns = static_cast<bit_map_size_t>(RowView::ReadVarInt(position));
+
+            const Constants::byte flags = *position;
+            position++;
+
+            const bit_map_size_t bitBytes = (this->numberOfColumns + 7) / 8;
+
+            this->nullBits = nullptr;
+            this->largeObjectBits = nullptr;
+
+            if (flags & COMPACT_ROW_HAS_NULLS)
+            {
+                this->nullBits = position;
+                position += bitBytes;
+            }
+
+            if (flags & COMPACT_ROW_HAS_LARGE_OBJECTS)
+            {
+                this->largeObjectBits = position;
+                position += bitBytes;
+            }
+
+            this->columnData = position;
+
+            return;
+        }
+
+        memcpy(&this->rowSize, data, sizeof(row_size_t));
+
+        const char *nullBitMap = data + sizeof(row_size_t) + sizeof(size_t);
+        memcpy(&this->numberOfColumns, nullBitMap, sizeof(bit_map_size_t));
+        this->nullBits = nullBitMap + sizeof(bit_map_size_t);
+
+        const char *largeObjectBitMap = this->nullBits + (this->numberOfColumns + 7) / 8;
+
+        bit_map_size_t largeObjectBitMapSize;
+        memcpy(&largeObjectBitMapSize, largeObjectBitMap, sizeof(bit_map_size_t));
+        this->largeObjectBits = largeObjectBitMap + sizeof(bit_map_size_t);
+
+        this->columnData = this->largeObjectBits + (largeObjectBitMapSize + 7) / 8;
+    }
+
+    RowView::~RowView() = default;
+
+    bool RowView::GetBit(const char *bits, const bit_map_pos_t &position)
+    {
+        // elided bits are all unset
+        if (bits == nullptr)
+            return false;
+
+        return static_cast<unsigned char>(bits[position / 8]) & (1 << (position % 8));
+    }
+
+    row_size_t RowView::GetRowSize() const { return this->rowSize; }
+
+    bit_map_size_t RowView::GetNumberOfColumns() const { return this->numberOfColumns; }
+
+    bool RowView::IsNull(const column_index_t &columnIndex) const
+    {
+        if (columnIndex >= this->numberOfColumns)
+            return false;
+
+        return RowView::GetBit(this->nullBits, columnIndex);
+    }
+
+    bool RowView::IsLargeObject(const column_index_t &columnIndex) const
+    {
+        if (columnIndex >= this->numberOfColumns)
+            return false;
+
+        return RowView::GetBit(this->largeObjectBits, columnIndex);
+    }
+
+    const char *RowView::GetFirstColumn() const { return this->columnData; }
+
+    const object_t *RowView::ReadColumn(const char *&column, block_size_t &size) const
+    {
+        if (this->format == RowFormat::COMPACT)
+            size = static_cast<block_size_t>(RowView::ReadVarInt(column));
+        else
+        {
+            memcpy(&size, column, sizeof(block_size_t));
+            column += sizeof(block_size_t);
+        }
+
+        const auto *columnBytes = reinterpret_cast<const object_t *>(column);
+        column += size;
+
+        return columnBytes;
+    }
+
+    const object_t *RowView::GetColumnData(const column_index_t &columnIndex, block_size_t &size) const
+    {
+        size = 0;
+
+        if (this->IsNull(columnIndex))
+            return nullptr;
+
+        // columns are variable sized, the ones before have to be skipped
+        const char *column = this->columnData;
+
+        for (column_index_t i = 0; i < columnIndex; i++)
+        {
+            if (this->IsNull(i))
+                continue;
+
+            block_size_t columnSize;
+            (void)this->ReadColumn(column, columnSize);
+        }
+
+        return this->ReadColumn(column, size);
+    }
+
+    page_offset_t RowView::GetSerializedSize() const
+    {
+        const char *column = this->columnData;
+
+        for (bit_map_pos_t i = 0; i < this->numberOfColumns; i++)
+        {
+            if (this->IsNull(i))
+                continue;
+
+            block_size_t columnSize;
+            (void)this->ReadColumn(column, columnSize);
+        }
+
+        return static_cast<page_offset_t>(column - this->data);
+    }
+
+    uint32_t RowView::ReadVarInt(const char *&position)
+    {
+        uint32_t value = 0;
+        uint8_t shift = 0;
+
+        // seven bits a byte, low bits first, the high bit marks that another byte follows
+        while (true)
+        {
+            const auto currentByte = static_cast<Constants::byte>(*position);
+            position++;
+
+            value |= static_cast<uint32_t>(currentByte & 0x7F) << shift;
+
+            if ((currentByte & 0x80) == 0)
+                return value;
+
+            shift += 7;
+        }
+    }
+
+    void RowView::WriteVarInt(ostream *filePtr, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            const auto currentByte = static_cast<char>((value & 0x7F) | 0x80);
+            filePtr->write(&currentByte, sizeof(char));
+
+            value >>= 7;
+        }
+
+        const auto lastByte = static_cast<char>(value);
+        filePtr->write(&lastByte, sizeof(char));
+    }
+
+    page_offset_t RowView::GetVarIntSize(uint32_t value)
+    {
+        page_offset_t size = 1;
+
+        while (value >= 0x80)
+        {
+            value >>= 7;
+            size++;
+        }
+
+        return size;
+    }
+}
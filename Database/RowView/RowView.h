@@ -0,0 +1,49 @@
+#pragma once
+#include <ostream>
+#include "../Constants.h"
+
+using namespace std;
+using namespace Constants;
+
+namespace DatabaseEngine::StorageTypes
+{
+    // read only view of a row serialized in a page image, nothing is copied or allocated
+    // FIXED_HEADER: rowSize | maxRowSize | null bitmap | large object bitmap | block_size_t size and bytes of every non null column
+    // COMPACT: varint rowSize | varint number of columns | flags | null bits if any is set | large object bits if any is set | varint size and bytes of every non null column
+    class RowView
+    {
+        const char *data;
+        const char *nullBits;
+        const char *largeObjectBits;
+        const char *columnData;
+        RowFormat format;
+        row_size_t rowSize;
+        bit_map_size_t numberOfColumns;
+
+    protected:
+        static bool GetBit(const char *bits, const bit_map_pos_t &position);
+
+    public:
+        RowView(const char *data, const RowFormat &format);
+        ~RowView();
+
+        [[nodiscard]] row_size_t GetRowSize() const;
+        [[nodiscard]] bit_map_size_t GetNumberOfColumns() const;
+        [[nodiscard]] bool IsNull(const column_index_t &columnIndex) const;
+        [[nodiscard]] bool IsLargeObject(const column_index_t &columnIndex) const;
+
+        // null columns return nullptr with a size of 0, large objects return their DataObjectPointer
+        [[nodiscard]] const object_t *GetColumnData(const column_index_t &columnIndex, block_size_t &size) const;
+
+        // start of the first non null column, ReadColumn walks them in order from there
+        [[nodiscard]] const char *GetFirstColumn() const;
+        const object_t *ReadColumn(const char *&column, block_size_t &size) const;
+
+        // bytes the row takes up in the page
+        [[nodiscard]] page_offset_t GetSerializedSize() const;
+
+        static uint32_t ReadVarInt(const char *&position);
+        static void WriteVarInt(ostream *filePtr, uint32_t value);
+        [[nodiscard]] static page_offset_t GetVarIntSize(uint32_t value);
+    };
+}
@@ -0,0 +1,588 @@
+#include "BufferPool.h"
+#include <algorithm>
+#include "../../Pages/Page.h"
+#include "../ReplacementPolicies/ReplacementPolicy.h"
+
+using namespace Pages;
+using namespace Constants;
+
+namespace Storage {
+    Frame::Frame(Page *page)
+    {
+        this->page = page;
+        this->pinCount = 0;
+        this->isReferenced = false;
+        this->isPrefetched = false;
+        this->isLoadAccessPending = false;
+        this->clockPosition = 0;
+        this->queueId = 0;
+        this->dirtySince = 0;
+    }
+
+    Frame::~Frame() = default;
+
+    DirtyPageEntry::DirtyPageEntry(const page_id_t &pageId, const uint64_t &dirtySince)
+    {
+        this->pageId = pageId;
+        this->dirtySince = dirtySince;
+    }
+
+    DirtyPageEntry::~DirtyPageEntry() = default;
+
+    BufferPoolShard::BufferPoolShard(const size_t &capacity, const ReplacementPolicyType &policyType)
+    {
+        this->capacity = capacity;
+        this->replacementPolicy = ReplacementPolicy::Create(policyType, capacity);
+    }
+
+    BufferPoolShard::~BufferPoolShard()
+    {
+        for (const auto &[pageId, frame] : this->frames)
+        {
+            delete frame->page;
+            delete frame;
+        }
+
+        delete this->replacementPolicy;
+    }
+
+    BufferPool::BufferPool(const size_t &capacity, const size_t &numberOfShards, const EvictionHandler &evictionHandler, const ReplacementPolicyType &policyType)
+    {
+        const size_t shardCount = (numberOfShards == 0) ? 1 : numberOfShards;
+        const size_t shardCapacity = BufferPool::GetShardCapacity(capacity, shardCount);
+
+        for (size_t i = 0; i < shardCount; i++)
+            this->shards.push_back(new BufferPoolShard(shardCapacity, policyType));
+
+        this->evictionHandler = evictionHandler;
+        this->policyType = policyType;
+        this->capacity = capacity;
+        this->prefetchHits = 0;
+        this->prefetchWaste = 0;
+    }
+
+    BufferPool::~BufferPool()
+    {
+        for (const auto &shard : this->shards)
+            delete shard;
+    }
+
+    bool BufferPool::RecordPrefetchHit(Frame *frame, atomic<uint64_t> &prefetchHits)
+    {
+        // only the first access of a prefetched page counts
+        if (!frame->isPrefetched.load(memory_order_relaxed) || !frame->isPrefetched.exchange(false, memory_order_relaxed))
+            return false;
+
+        prefetchHits.fetch_add(1, memory_order_relaxed);
+
+        return true;
+    }
+
+    bool BufferPool::IsReReference(Frame *frame, atomic<uint64_t> &prefetchHits)
+    {
+        if (BufferPool::RecordPrefetchHit(frame, prefetchHits))
+            return false;
+
+        // an extent is loaded for one of its pages, the first access of every page of it stands in for the load
+        return !frame->isLoadAccessPending.load(memory_order_relaxed) || !frame->isLoadAccessPending.exchange(false, memory_order_relaxed);
+    }
+
+    size_t BufferPool::GetShardCapacity(const size_t &capacity, const size_t &numberOfShards)
+    {
+        const size_t shardCapacity = (capacity + numberOfShards - 1) / numberOfShards;
+
+        return shardCapacity == 0 ? 1 : shardCapacity;
+    }
+
+    BufferPoolShard *BufferPool::GetShard(const page_id_t &pageId) const
+    {
+        // fibonacci hashing, spreads the consecutive page ids of an extent over different shards
+        const uint64_t hash = static_cast<uint64_t>(pageId) * 11400714819323198485ull;
+
+        return this->shards[(hash >> 32) % this->shards.size()];
+    }
+
+    Page *BufferPool::GetPage(const page_id_t &pageId)
+    {
+        BufferPoolShard *shard = this->GetShard(pageId);
+
+        {
+            // policies like CLOCK only flag the frame on a hit, so readers can share the latch
+            shared_lock lock(shard->shardMutex);
+
+            if (shard->replacementPolicy->IsAccessLockFree())
+            {
+                const auto &frameIterator = shard->frames.find(pageId);
+
+                if (frameIterator == shard->frames.end())
+                    return nullptr;
+
+                // the first access of a prefetched or freshly loaded page stands in for the load
+                if (BufferPool::IsReReference(frameIterator->second, this->prefetchHits))
+                    shard->replacementPolicy->RecordAccess(frameIterator->second);
+
+                return frameIterator->second->page;
+            }
+        }
+
+        lock_guard lock(shard->shardMutex);
+
+        const auto &frameIterator = shard->frames.find(pageId);
+
+        if (frameIterator == shard->frames.end())
+            return nullptr;
+
+        if (BufferPool::IsReReference(frameIterator->second, this->prefetchHits))
+            shard->replacementPolicy->RecordAccess(frameIterator->second);
+
+        return frameIterator->second->page;
+    }
+
+    Page *BufferPool::FindPage(const page_id_t &pageId)
+    {
+        // plain lookup that is not reported to the replacement policy
+        BufferPoolShard *shard = this->GetShard(pageId);
+
+        shared_lock lock(shard->shardMutex);
+
+        const auto &frameIterator = shard->frames.find(pageId);
+
+        return (frameIterator == shard->frames.end()) ? nullptr : frameIterator->second->page;
+    }
+
+    Frame *BufferPool::PinPage(const page_id_t &pageId, const bool &isAccess)
+    {
+        BufferPoolShard *shard = this->GetShard(pageId);
+
+        {
+            // eviction needs the exclusive latch, so a frame pinned under the shared one cannot be evicted meanwhile
+            shared_lock lock(shard->shardMutex);
+
+            if (!isAccess || shard->replacementPolicy->IsAccessLockFree())
+            {
+                const auto &frameIterator = shard->frames.find(pageId);
+
+                if (frameIterator == shard->frames.end())
+                    return nullptr;
+
+                if (isAccess && BufferPool::IsReReference(frameIterator->second, this->prefetchHits))
+                    shard->replacementPolicy->RecordAccess(frameIterator->second);
+
+                frameIterator->second->pinCount.fetch_add(1, memory_order_acquire);
+
+                return frameIterator->second;
+            }
+        }
+
+        lock_guard lock(shard->shardMutex);
+
+        const auto &frameIterator = shard->frames.find(pageId);
+
+        if (frameIterator == shard->frames.end())
+            return nullptr;
+
+        if (BufferPool::IsReReference(frameIterator->second, this->prefetchHits))
+            shard->replacementPolicy->RecordAccess(frameIterator->second);
+
+        frameIterator->second->pinCount.fetch_add(1, memory_order_acquire);
+
+        return frameIterator->second;
+    }
+
+    bool BufferPool::ContainsPage(const page_id_t &pageId) { return this->FindPage(pageId) != nullptr; }
+
+    Page *BufferPool::InsertPage(Page *page, const bool &isPrefetched)
+    {
+        BufferPoolShard *shard = this->GetShard(page->GetPageId());
+
+        lock_guard lock(shard->shardMutex);
+
+        return this->InsertFrame(shard, page, isPrefetched)->page;
+    }
+
+    vector<uint64_t> BufferPool::BeginPageLoads(const page_id_t &firstPageId, const size_t &pageCount)
+    {
+        vector<uint64_t> loadTickets;
+        loadTickets.reserve(pageCount);
+
+        for (page_id_t pageId = firstPageId; pageId < firstPageId + pageCount; pageId++)
+        {
+            BufferPoolShard *shard = this->GetShard(pageId);
+
+            lock_guard lock(shard->shardMutex);
+
+            PageLoad &pageLoad = shard->pageLoads[pageId];
+            pageLoad.loaders++;
+
+            loadTickets.push_back(pageLoad.evictions);
+        }
+
+        return loadTickets;
+    }
+
+    Page *BufferPool::InsertLoadedPage(Page *page, const uint64_t &loadTicket, const bool &isPrefetched)
+    {
+        const page_id_t pageId = page->GetPageId();
+
+        BufferPoolShard *shard = this->GetShard(pageId);
+
+        lock_guard lock(shard->shardMutex);
+
+        const auto &loadIterator = shard->pageLoads.find(pageId);
+
+        // a resident copy is kept by InsertFrame anyway, otherwise the read may predate the write back of an eviction
+        if (!shard->frames.contains(pageId) && loadIterator != shard->pageLoads.end() && loadIterator->second.evictions != loadTicket)
+        {
+            delete page;
+
+            return nullptr;
+        }
+
+        return this->InsertFrame(shard, page, isPrefetched)->page;
+    }
+
+    void BufferPool::EndPageLoads(const page_id_t &firstPageId, const size_t &pageCount)
+    {
+        for (page_id_t pageId = firstPageId; pageId < firstPageId + pageCount; pageId++)
+        {
+            BufferPoolShard *shard = this->GetShard(pageId);
+
+            lock_guard lock(shard->shardMutex);
+
+            const auto &loadIterator = shard->pageLoads.find(pageId);
+
+            if (loadIterator != shard->pageLoads.end() && --loadIterator->second.loaders == 0)
+                shard->pageLoads.erase(loadIterator);
+        }
+    }
+
+    Frame *BufferPool::InsertPinnedPage(Page *page)
+    {
+        BufferPoolShard *shard = this->GetShard(page->GetPageId());
+
+        lock_guard lock(shard->shardMutex);
+
+        Frame *frame = this->InsertFrame(shard, page, false);
+
+        frame->pinCount.fetch_add(1, memory_order_acquire);
+
+        return frame;
+    }
+
+    Frame *BufferPool::InsertFrame(BufferPoolShard *shard, Page *page, const bool &isPrefetched)
+    {
+        const page_id_t pageId = page->GetPageId();
+
+        const auto &frameIterator = shard->frames.find(pageId);
+
+        if (frameIterator != shard->frames.end())
+        {
+            // another thread loaded the same extent first, keep the resident copy
+            if (frameIterator->second->page != page)
+                delete page;
+
+            return frameIterator->second;
+        }
+
+        try
+        {
+            while (shard->frames.size() >= shard->capacity)
+            {
+                if (!this->EvictPage(shard))
+                    break;
+            }
+        }
+        catch (...)
+        {
+            // the pool owns the page from the call on, a victim that could not be written leaves no room for it
+            delete page;
+
+            throw;
+        }
+
+        Frame *frame = new Frame(page);
+        frame->isPrefetched = isPrefetched;
+        frame->isLoadAccessPending = !isPrefetched;
+
+        shard->frames[pageId] = frame;
+        shard->replacementPolicy->RecordInsertion(frame);
+
+        return frame;
+    }
+
+    bool BufferPool::EvictPage(BufferPoolShard *shard)
+    {
+        Frame *frame = shard->replacementPolicy->SelectVictim();
+
+        if (frame == nullptr)
+            return false;
+
+        Page *page = frame->page;
+        const page_id_t pageId = page->GetPageId();
+
+        vector<BufferPoolShard *> lockedShards;
+        vector<Frame *> writeBehindFrames;
+        vector<Page *> writeBehindPages;
+
+        // a bulk insert dirties whole extents, the pages around the victim are written with it instead of one by one later
+        if (page->GetPageDirtyStatus())
+            this->CollectWriteBehindFrames(page->GetPageId(), shard, lockedShards, writeBehindFrames);
+
+        for (const auto &writeBehindFrame : writeBehindFrames)
+            writeBehindPages.push_back(writeBehindFrame->page);
+
+        try
+        {
+            // runs under the shard latch, a load of the page that begins meanwhile waits for it and reads the written page
+            this->evictionHandler(page, writeBehindPages);
+        }
+        catch (...)
+        {
+            // the page was not written, it stays in the pool with its changes instead of being lost
+            shard->replacementPolicy->RestoreVictim(frame);
+
+            for (const auto &lockedShard : lockedShards)
+                lockedShard->shardMutex.unlock();
+
+            throw;
+        }
+
+        for (const auto &writeBehindFrame : writeBehindFrames)
+        {
+            writeBehindFrame->page->SetPageDirtyStatus(false);
+            writeBehindFrame->dirtySince = 0;
+        }
+
+        for (const auto &lockedShard : lockedShards)
+            lockedShard->shardMutex.unlock();
+
+        // read ahead of a scan but evicted before the scan got to it
+        if (frame->isPrefetched.load(memory_order_relaxed))
+            this->prefetchWaste.fetch_add(1, memory_order_relaxed);
+
+        // loads that began before the write back may have read the old page from disk, they drop what they read
+        const auto &loadIterator = shard->pageLoads.find(pageId);
+
+        if (loadIterator != shard->pageLoads.end())
+            loadIterator->second.evictions++;
+
+        // the handler has written and released the page, only now the frame leaves the shard
+        shard->frames.erase(pageId);
+
+        delete frame;
+
+        return true;
+    }
+
+    Frame *BufferPool::GetWriteBehindFrame(const page_id_t &pageId, const BufferPoolShard *victimShard, vector<BufferPoolShard *> &lockedShards)
+    {
+        BufferPoolShard *shard = this->GetShard(pageId);
+
+        // the evicting thread already holds its own latch, waiting for another one could deadlock with a thread evicting from there
+        if (shard != victimShard && find(lockedShards.begin(), lockedShards.end(), shard) == lockedShards.end())
+        {
+            if (!shard->shardMutex.try_lock())
+                return nullptr;
+
+            lockedShards.push_back(shard);
+        }
+
+        const auto &frameIterator = shard->frames.find(pageId);
+
+        if (frameIterator == shard->frames.end())
+            return nullptr;
+
+        Frame *frame = frameIterator->second;
+
+        // pinned pages may be in the middle of a change
+        if (frame->pinCount.load(memory_order_acquire) > 0 || !frame->page->GetPageDirtyStatus())
+            return nullptr;
+
+        return frame;
+    }
+
+    void BufferPool::CollectWriteBehindFrames(const page_id_t &pageId, const BufferPoolShard *victimShard, vector<BufferPoolShard *> &lockedShards, vector<Frame *> &frames)
+    {
+        // grows a run of consecutive dirty pages down and then up from the victim, page 0 is the header and never part of it
+        for (page_id_t neighbourId = pageId - 1; neighbourId > 0 && frames.size() + 1 < WRITE_COALESCE_PAGES; neighbourId--)
+        {
+            Frame *frame = this->GetWriteBehindFrame(neighbourId, victimShard, lockedShards);
+
+            if (frame == nullptr)
+                break;
+
+            frames.push_back(frame);
+        }
+
+        for (page_id_t neighbourId = pageId + 1; neighbourId > pageId && frames.size() + 1 < WRITE_COALESCE_PAGES; neighbourId++)
+        {
+            Frame *frame = this->GetWriteBehindFrame(neighbourId, victimShard, lockedShards);
+
+            if (frame == nullptr)
+                break;
+
+            frames.push_back(frame);
+        }
+    }
+
+    void BufferPool::Clear()
+    {
+        for (const auto &shard : this->shards)
+        {
+            lock_guard lock(shard->shardMutex);
+
+            while (!shard->frames.empty())
+            {
+                if (!this->EvictPage(shard))
+                    break;
+            }
+        }
+    }
+
+    void BufferPool::SetReplacementPolicy(const ReplacementPolicyType &policyType)
+    {
+        if (this->policyType == policyType)
+            return;
+
+        for (const auto &shard : this->shards)
+        {
+            lock_guard lock(shard->shardMutex);
+
+            delete shard->replacementPolicy;
+
+            shard->replacementPolicy = ReplacementPolicy::Create(policyType, shard->capacity);
+
+            // resident pages keep their place in the cache but start over in the new policy
+            for (const auto &[pageId, frame] : shard->frames)
+            {
+                frame->isReferenced = false;
+                shard->replacementPolicy->RecordInsertion(frame);
+            }
+        }
+
+        this->policyType = policyType;
+    }
+
+    void BufferPool::Resize(const size_t &capacity)
+    {
+        const size_t shardCapacity = BufferPool::GetShardCapacity(capacity, this->shards.size());
+
+        for (const auto &shard : this->shards)
+        {
+            lock_guard lock(shard->shardMutex);
+
+            shard->capacity = shardCapacity;
+            shard->replacementPolicy->SetCapacity(shardCapacity);
+
+            while (shard->frames.size() > shard->capacity)
+            {
+                if (!this->EvictPage(shard))
+                    break;
+            }
+        }
+
+        this->capacity = capacity;
+    }
+
+    void BufferPool::CollectDirtyPages(vector<DirtyPageEntry> &dirtyPages, const uint64_t &epoch)
+    {
+        for (const auto &shard : this->shards)
+        {
+            shared_lock lock(shard->shardMutex);
+
+            for (const auto &[pageId, frame] : shard->frames)
+            {
+                const PageType &pageType = frame->page->GetPageType();
+
+                // the header page is modified without a pin, it is only written on eviction
+                if (pageType != PageType::DATA && pageType != PageType::LOB && pageType != PageType::INDEX)
+                    continue;
+
+                if (!frame->page->GetPageDirtyStatus())
+                    continue;
+
+                // pages are not timestamped when modified, the first pass that sees a page dirty stamps it
+                if (frame->dirtySince == 0)
+                    frame->dirtySince = epoch;
+
+                dirtyPages.emplace_back(pageId, frame->dirtySince);
+            }
+        }
+    }
+
+    size_t BufferPool::FlushPages(const vector<page_id_t> &pageIds, const function<void(const vector<Page *> &)> &pagesWriter)
+    {
+        vector<BufferPoolShard *> shards;
+
+        for (const auto &pageId : pageIds)
+            shards.push_back(this->GetShard(pageId));
+
+        // latches are taken in address order, evicting threads only try the latches of other shards so nothing waits in a cycle
+        sort(shards.begin(), shards.end());
+        shards.erase(unique(shards.begin(), shards.end()), shards.end());
+
+        vector<unique_lock<shared_mutex>> locks;
+
+        // the exclusive latches keep new pins away while the pages are serialized
+        for (const auto &shard : shards)
+            locks.emplace_back(shard->shardMutex);
+
+        vector<Frame *> frames;
+        vector<Page *> pages;
+
+        for (const auto &pageId : pageIds)
+        {
+            BufferPoolShard *shard = this->GetShard(pageId);
+
+            const auto &frameIterator = shard->frames.find(pageId);
+
+            if (frameIterator == shard->frames.end())
+                continue;
+
+            Frame *frame = frameIterator->second;
+
+            if (frame->pinCount.load(memory_order_acquire) > 0 || !frame->page->GetPageDirtyStatus())
+                continue;
+
+            frames.push_back(frame);
+            pages.push_back(frame->page);
+        }
+
+        if (pages.empty())
+            return 0;
+
+        pagesWriter(pages);
+
+        for (const auto &frame : frames)
+        {
+            frame->page->SetPageDirtyStatus(false);
+            frame->dirtySince = 0;
+        }
+
+        return pages.size();
+    }
+
+    size_t BufferPool::GetSize() const
+    {
+        size_t size = 0;
+
+        for (const auto &shard : this->shards)
+        {
+            shared_lock lock(shard->shardMutex);
+
+            size += shard->frames.size();
+        }
+
+        return size;
+    }
+
+    size_t BufferPool::GetCapacity() const { return this->capacity; }
+
+    uint64_t BufferPool::GetPrefetchHits() const { return this->prefetchHits; }
+
+    uint64_t BufferPool::GetPrefetchWaste() const { return this->prefetchWaste; }
+
+    size_t BufferPool::GetNumberOfShards() const { return this->shards.size(); }
+
+    ReplacementPolicyType BufferPool::GetReplacementPolicy() const { return this->policyType; }
+}
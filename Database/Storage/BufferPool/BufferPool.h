@@ -0,0 +1,122 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+#include "../../Constants.h"
+
+namespace Pages {
+    class Page;
+}
+
+namespace Storage {
+    using namespace std;
+
+    class ReplacementPolicy;
+
+    // takes ownership of the evicted page, the neighbours are dirty unpinned pages next to it that stay cached but are written in the same call
+    typedef function<void(Pages::Page *, const vector<Pages::Page *> &)> EvictionHandler;
+
+    // a cached page together with the bookkeeping of the shard's replacement policy
+    typedef struct Frame {
+        Pages::Page *page;
+        atomic<uint32_t> pinCount;
+        atomic<bool> isReferenced;
+        atomic<bool> isPrefetched;
+        // set until the access the page was loaded or created for, which is not a re-reference
+        atomic<bool> isLoadAccessPending;
+        list<Frame *>::iterator queuePosition;
+        size_t clockPosition;
+        uint8_t queueId;
+        uint64_t dirtySince;
+
+        explicit Frame(Pages::Page *page);
+        ~Frame();
+    } Frame;
+
+    typedef struct DirtyPageEntry {
+        Constants::page_id_t pageId;
+        uint64_t dirtySince;
+
+        DirtyPageEntry(const Constants::page_id_t &pageId, const uint64_t &dirtySince);
+        ~DirtyPageEntry();
+    } DirtyPageEntry;
+
+    // pages being read from disk, evictions of them that overlap the read are counted so that a stale copy is not inserted
+    typedef struct PageLoad {
+        uint32_t loaders;
+        uint64_t evictions;
+    } PageLoad;
+
+    typedef struct BufferPoolShard {
+        unordered_map<Constants::page_id_t, Frame *> frames;
+        unordered_map<Constants::page_id_t, PageLoad> pageLoads;
+        ReplacementPolicy *replacementPolicy;
+        shared_mutex shardMutex;
+        size_t capacity;
+
+        BufferPoolShard(const size_t &capacity, const Constants::ReplacementPolicyType &policyType);
+        ~BufferPoolShard();
+    } BufferPoolShard;
+
+    // page ids are hashed to independent shards, each one with its own page table, replacement policy and latch
+    // so that cache hits coming from different threads do not contend on a single mutex
+    // frames with a non zero pin count are never evicted, a shard whose frames are all pinned grows past its capacity
+    class BufferPool final {
+        vector<BufferPoolShard *> shards;
+        EvictionHandler evictionHandler;
+        atomic<Constants::ReplacementPolicyType> policyType;
+        atomic<size_t> capacity;
+        atomic<uint64_t> prefetchHits;
+        atomic<uint64_t> prefetchWaste;
+
+    protected:
+        [[nodiscard]] BufferPoolShard *GetShard(const Constants::page_id_t &pageId) const;
+        [[nodiscard]] static size_t GetShardCapacity(const size_t &capacity, const size_t &numberOfShards);
+        bool EvictPage(BufferPoolShard *shard);
+        Frame *InsertFrame(BufferPoolShard *shard, Pages::Page *page, const bool &isPrefetched);
+        Frame *GetWriteBehindFrame(const Constants::page_id_t &pageId, const BufferPoolShard *victimShard, vector<BufferPoolShard *> &lockedShards);
+        void CollectWriteBehindFrames(const Constants::page_id_t &pageId, const BufferPoolShard *victimShard, vector<BufferPoolShard *> &lockedShards, vector<Frame *> &frames);
+        static bool RecordPrefetchHit(Frame *frame, atomic<uint64_t> &prefetchHits);
+        // false for the first access of a page brought in by a prefetch, an extent load or a creation
+        static bool IsReReference(Frame *frame, atomic<uint64_t> &prefetchHits);
+
+    public:
+        BufferPool(const size_t &capacity, const size_t &numberOfShards, const EvictionHandler &evictionHandler, const Constants::ReplacementPolicyType &policyType = Constants::ReplacementPolicyType::LRU);
+        BufferPool(const BufferPool &other) = delete;
+        ~BufferPool();
+
+        Pages::Page *GetPage(const Constants::page_id_t &pageId);
+        Pages::Page *FindPage(const Constants::page_id_t &pageId);
+        Frame *PinPage(const Constants::page_id_t &pageId, const bool &isAccess = true);
+        bool ContainsPage(const Constants::page_id_t &pageId);
+        Pages::Page *InsertPage(Pages::Page *page, const bool &isPrefetched = false);
+        // inserts and pins the page under the same latch, it cannot be evicted before the caller guards the frame
+        Frame *InsertPinnedPage(Pages::Page *page);
+
+        // pages read from disk are announced before the read and ended after it, every begun load has to be ended
+        // a loaded page whose id was evicted in between may have been read before its write back, it is deleted and nullptr returned
+        [[nodiscard]] vector<uint64_t> BeginPageLoads(const Constants::page_id_t &firstPageId, const size_t &pageCount);
+        Pages::Page *InsertLoadedPage(Pages::Page *page, const uint64_t &loadTicket, const bool &isPrefetched = false);
+        void EndPageLoads(const Constants::page_id_t &firstPageId, const size_t &pageCount);
+        void Clear();
+        void SetReplacementPolicy(const Constants::ReplacementPolicyType &policyType);
+
+        // a shrinking pool evicts down to the new capacity right away, pinned frames stay until a later insertion evicts them
+        void Resize(const size_t &capacity);
+        void CollectDirtyPages(vector<DirtyPageEntry> &dirtyPages, const uint64_t &epoch);
+
+        // writes the given pages that are still cached, dirty and unpinned with one call and returns how many of them were written
+        size_t FlushPages(const vector<Constants::page_id_t> &pageIds, const function<void(const vector<Pages::Page *> &)> &pagesWriter);
+
+        [[nodiscard]] size_t GetSize() const;
+        [[nodiscard]] size_t GetCapacity() const;
+        [[nodiscard]] uint64_t GetPrefetchHits() const;
+        [[nodiscard]] uint64_t GetPrefetchWaste() const;
+        [[nodiscard]] size_t GetNumberOfShards() const;
+        [[nodiscard]] Constants::ReplacementPolicyType GetReplacementPolicy() const;
+    };
+}
@@ -0,0 +1,199 @@
+#include "BufferPoolStatistics.h"
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+
+namespace Storage {
+    LatencyHistogram::LatencyHistogram()
+    {
+        this->Reset();
+    }
+
+    LatencyHistogram::~LatencyHistogram() = default;
+
+    void LatencyHistogram::Record(const uint64_t &microseconds)
+    {
+        // number of bits needed for the value, so 0 lands in bucket 0, 1 in bucket 1, 2-3 in bucket 2 and so on
+        const size_t bucket = min(static_cast<size_t>(bit_width(microseconds)), LATENCY_HISTOGRAM_BUCKETS - 1);
+
+        this->buckets[bucket].fetch_add(1, memory_order_relaxed);
+        this->count.fetch_add(1, memory_order_relaxed);
+        this->totalMicroseconds.fetch_add(microseconds, memory_order_relaxed);
+    }
+
+    void LatencyHistogram::Reset()
+    {
+        for (auto &bucket : this->buckets)
+            bucket = 0;
+
+        this->count = 0;
+        this->totalMicroseconds = 0;
+    }
+
+    uint64_t LatencyHistogram::GetPercentile(const double &percentile) const
+    {
+        const uint64_t count = this->count.load(memory_order_relaxed);
+
+        if (count == 0)
+            return 0;
+
+        const auto rank = static_cast<uint64_t>(static_cast<double>(count) * percentile);
+        uint64_t seen = 0;
+
+        for (size_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++)
+        {
+            seen += this->buckets[i].load(memory_order_relaxed);
+
+            if (seen > rank)
+                return uint64_t(1) << i;
+        }
+
+        return uint64_t(1) << (LATENCY_HISTOGRAM_BUCKETS - 1);
+    }
+
+    double LatencyHistogram::GetAverage() const
+    {
+        const uint64_t count = this->count.load(memory_order_relaxed);
+
+        return count == 0 ? 0 : static_cast<double>(this->totalMicroseconds.load(memory_order_relaxed)) / static_cast<double>(count);
+    }
+
+    PageTypeStatistics::PageTypeStatistics()
+    {
+        this->Reset();
+    }
+
+    PageTypeStatistics::~PageTypeStatistics() = default;
+
+    void PageTypeStatistics::Reset()
+    {
+        this->hits = 0;
+        this->misses = 0;
+        this->evictions = 0;
+        this->dirtyEvictions = 0;
+        this->bytesRead = 0;
+        this->bytesWritten = 0;
+        this->missLatency.Reset();
+        this->writeLatency.Reset();
+    }
+
+    double PageTypeStatistics::GetHitRatio() const
+    {
+        const uint64_t hits = this->hits.load(memory_order_relaxed);
+        const uint64_t accesses = hits + this->misses.load(memory_order_relaxed);
+
+        return accesses == 0 ? 0 : static_cast<double>(hits) / static_cast<double>(accesses);
+    }
+
+    BufferPoolStatistics::BufferPoolStatistics() = default;
+
+    BufferPoolStatistics::~BufferPoolStatistics() = default;
+
+    void BufferPoolStatistics::RecordHit(const PageType &pageType)
+    {
+        this->pageTypes[static_cast<size_t>(pageType)].hits.fetch_add(1, memory_order_relaxed);
+    }
+
+    void BufferPoolStatistics::RecordMiss(const PageType &pageType, const uint64_t &microseconds)
+    {
+        PageTypeStatistics &statistics = this->pageTypes[static_cast<size_t>(pageType)];
+
+        statistics.misses.fetch_add(1, memory_order_relaxed);
+        statistics.missLatency.Record(microseconds);
+    }
+
+    void BufferPoolStatistics::RecordEviction(const PageType &pageType, const bool &isDirty)
+    {
+        PageTypeStatistics &statistics = this->pageTypes[static_cast<size_t>(pageType)];
+
+        statistics.evictions.fetch_add(1, memory_order_relaxed);
+
+        if (isDirty)
+            statistics.dirtyEvictions.fetch_add(1, memory_order_relaxed);
+    }
+
+    void BufferPoolStatistics::RecordRead(const PageType &pageType, const uint64_t &bytes)
+    {
+        this->pageTypes[static_cast<size_t>(pageType)].bytesRead.fetch_add(bytes, memory_order_relaxed);
+    }
+
+    void BufferPoolStatistics::RecordWrite(const PageType &pageType, const uint64_t &bytes, const uint64_t &microseconds)
+    {
+        PageTypeStatistics &statistics = this->pageTypes[static_cast<size_t>(pageType)];
+
+        statistics.bytesWritten.fetch_add(bytes, memory_order_relaxed);
+        statistics.writeLatency.Record(microseconds);
+    }
+
+    void BufferPoolStatistics::Reset()
+    {
+        for (auto &statistics : this->pageTypes)
+            statistics.Reset();
+    }
+
+    const PageTypeStatistics &BufferPoolStatistics::GetPageTypeStatistics(const PageType &pageType) const { return this->pageTypes[static_cast<size_t>(pageType)]; }
+
+    void BufferPoolStatistics::Print(ostream &stream) const
+    {
+        constexpr double bytesPerMegabyte = 1024.0 * 1024.0;
+        const ios_base::fmtflags flags = stream.flags();
+        const streamsize precision = stream.precision();
+
+        stream << left << setw(10) << "Type"
+               << right << setw(12) << "Hits"
+               << setw(10) << "Misses"
+               << setw(8) << "Hit %"
+               << setw(11) << "Evictions"
+               << setw(8) << "Dirty"
+               << setw(10) << "Read MB"
+               << setw(10) << "Write MB"
+               << setw(12) << "Miss p50us"
+               << setw(12) << "Miss p99us"
+               << setw(13) << "Write p50us"
+               << setw(13) << "Write p99us" << endl;
+
+        for (size_t i = 0; i < PAGE_TYPE_COUNT; i++)
+        {
+            const PageTypeStatistics &statistics = this->pageTypes[i];
+
+            stream << left << setw(10) << BufferPoolStatistics::GetPageTypeName(static_cast<PageType>(i))
+                   << right << setw(12) << statistics.hits.load(memory_order_relaxed)
+                   << setw(10) << statistics.misses.load(memory_order_relaxed)
+                   << setw(8) << fixed << setprecision(1) << statistics.GetHitRatio() * 100
+                   << setw(11) << statistics.evictions.load(memory_order_relaxed)
+                   << setw(8) << statistics.dirtyEvictions.load(memory_order_relaxed)
+                   << setw(10) << setprecision(2) << static_cast<double>(statistics.bytesRead.load(memory_order_relaxed)) / bytesPerMegabyte
+                   << setw(10) << static_cast<double>(statistics.bytesWritten.load(memory_order_relaxed)) / bytesPerMegabyte
+                   << setw(12) << statistics.missLatency.GetPercentile(0.5)
+                   << setw(12) << statistics.missLatency.GetPercentile(0.99)
+                   << setw(13) << statistics.writeLatency.GetPercentile(0.5)
+                   << setw(13) << statistics.writeLatency.GetPercentile(0.99) << endl;
+        }
+
+        stream.flags(flags);
+        stream.precision(precision);
+    }
+
+    const char *BufferPoolStatistics::GetPageTypeName(const PageType &pageType)
+    {
+        switch (pageType)
+        {
+            case PageType::DATA:
+                return "DATA";
+            case PageType::IAM:
+                return "IAM";
+            case PageType::LOB:
+                return "LOB";
+            case PageType::INDEX:
+                return "INDEX";
+            case PageType::METADATA:
+                return "METADATA";
+            case PageType::GAM:
+                return "GAM";
+            case PageType::FREESPACE:
+                return "PFS";
+            default:
+                return "UNKNOWN";
+        }
+    }
+}
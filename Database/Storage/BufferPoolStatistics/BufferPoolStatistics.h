@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <ostream>
+#include "../../Constants.h"
+
+using namespace Constants;
+
+namespace Storage {
+    using namespace std;
+
+    constexpr size_t PAGE_TYPE_COUNT = static_cast<size_t>(PageType::FREESPACE) + 1;
+
+    // bucket i counts the operations that took less than 2^i microseconds, the last bucket also counts everything slower
+    typedef struct LatencyHistogram {
+        array<atomic<uint64_t>, LATENCY_HISTOGRAM_BUCKETS> buckets;
+        atomic<uint64_t> count;
+        atomic<uint64_t> totalMicroseconds;
+
+        LatencyHistogram();
+        ~LatencyHistogram();
+
+        void Record(const uint64_t &microseconds);
+        void Reset();
+
+        // upper bound of the bucket holding the percentile, 0 if nothing was recorded
+        [[nodiscard]] uint64_t GetPercentile(const double &percentile) const;
+        [[nodiscard]] double GetAverage() const;
+    } LatencyHistogram;
+
+    typedef struct PageTypeStatistics {
+        atomic<uint64_t> hits;
+        atomic<uint64_t> misses;
+        atomic<uint64_t> evictions;
+        // evictions that had to write the page back first
+        atomic<uint64_t> dirtyEvictions;
+        atomic<uint64_t> bytesRead;
+        atomic<uint64_t> bytesWritten;
+        // time from a miss until the page is in the pool, and time to write a page back
+        LatencyHistogram missLatency;
+        LatencyHistogram writeLatency;
+
+        PageTypeStatistics();
+        ~PageTypeStatistics();
+
+        void Reset();
+
+        [[nodiscard]] double GetHitRatio() const;
+    } PageTypeStatistics;
+
+    // counters of both pools kept per page type, recorded with relaxed atomics so they cost nothing on the hit path
+    class BufferPoolStatistics final {
+        array<PageTypeStatistics, PAGE_TYPE_COUNT> pageTypes;
+
+    public:
+        BufferPoolStatistics();
+        BufferPoolStatistics(const BufferPoolStatistics &other) = delete;
+        ~BufferPoolStatistics();
+
+        void RecordHit(const PageType &pageType);
+        void RecordMiss(const PageType &pageType, const uint64_t &microseconds);
+        void RecordEviction(const PageType &pageType, const bool &isDirty);
+        void RecordRead(const PageType &pageType, const uint64_t &bytes);
+        void RecordWrite(const PageType &pageType, const uint64_t &bytes, const uint64_t &microseconds);
+        void Reset();
+
+        [[nodiscard]] const PageTypeStatistics &GetPageTypeStatistics(const PageType &pageType) const;
+
+        void Print(ostream &stream) const;
+
+        static const char *GetPageTypeName(const PageType &pageType);
+    };
+}
@@ -0,0 +1,186 @@
+#include "ExtentPrefetcher.h"
+#include <exception>
+
+using namespace Constants;
+
+namespace Storage {
+    PrefetchRequest::PrefetchRequest()
+    {
+        this->type = PrefetchType::DATA_EXTENT;
+        this->extentId = 0;
+        this->leafPageId = 0;
+        this->leafIndexPosition = 0;
+        this->depth = 0;
+        this->table = nullptr;
+    }
+
+    PrefetchRequest::PrefetchRequest(const extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table *table)
+        : PrefetchRequest()
+    {
+        this->extentId = extentId;
+        this->table = table;
+    }
+
+    PrefetchRequest::PrefetchRequest(const page_id_t &leafPageId, const page_offset_t &leafIndexPosition, const size_t &depth, const DatabaseEngine::StorageTypes::Table *table)
+        : PrefetchRequest()
+    {
+        this->type = PrefetchType::INDEX_LEAF_CHAIN;
+        this->leafPageId = leafPageId;
+        this->leafIndexPosition = leafIndexPosition;
+        this->depth = depth;
+        this->table = table;
+    }
+
+    PrefetchRequest::~PrefetchRequest() = default;
+
+    uint64_t PrefetchRequest::GetKey() const
+    {
+        const uint64_t typeBits = static_cast<uint64_t>(this->type) << 48;
+
+        if (this->type == PrefetchType::DATA_EXTENT)
+            return typeBits | this->extentId;
+
+        return typeBits | (static_cast<uint64_t>(this->leafPageId) << 16) | this->leafIndexPosition;
+    }
+
+    PrefetchStatistics::PrefetchStatistics()
+    {
+        this->requestsQueued = 0;
+        this->requestsDropped = 0;
+        this->extentsRead = 0;
+        this->hits = 0;
+        this->waste = 0;
+    }
+
+    PrefetchStatistics::~PrefetchStatistics() = default;
+
+    ExtentPrefetcher::ExtentPrefetcher(const function<size_t(const PrefetchRequest &)> &requestHandler)
+    {
+        this->requestHandler = requestHandler;
+        this->isRunning = false;
+        this->prefetchDepth = 0;
+        this->requestsQueued = 0;
+        this->requestsDropped = 0;
+        this->extentsRead = 0;
+    }
+
+    ExtentPrefetcher::~ExtentPrefetcher()
+    {
+        this->Stop();
+    }
+
+    void ExtentPrefetcher::Start(const StorageSettings &settings)
+    {
+        this->Stop();
+
+        this->prefetchDepth = settings.prefetchDepth;
+
+        if (settings.prefetchDepth == 0)
+            return;
+
+        {
+            lock_guard lock(this->prefetcherMutex);
+
+            this->isRunning = true;
+        }
+
+        this->prefetcherThread = thread([this] { this->Run(); });
+    }
+
+    void ExtentPrefetcher::Stop()
+    {
+        {
+            lock_guard lock(this->prefetcherMutex);
+
+            this->isRunning = false;
+            this->requests.clear();
+            this->pendingRequests.clear();
+        }
+
+        this->prefetcherCondition.notify_all();
+
+        if (this->prefetcherThread.joinable())
+            this->prefetcherThread.join();
+    }
+
+    bool ExtentPrefetcher::Enqueue(const PrefetchRequest &request)
+    {
+        {
+            lock_guard lock(this->prefetcherMutex);
+
+            if (!this->isRunning)
+                return false;
+
+            // already waiting in the queue, the scan asked for it on a previous step
+            if (this->pendingRequests.contains(request.GetKey()))
+                return false;
+
+            if (this->requests.size() >= PREFETCH_QUEUE_SIZE)
+            {
+                this->requestsDropped.fetch_add(1, memory_order_relaxed);
+                return false;
+            }
+
+            this->requests.push_back(request);
+            this->pendingRequests.insert(request.GetKey());
+        }
+
+        this->requestsQueued.fetch_add(1, memory_order_relaxed);
+
+        this->prefetcherCondition.notify_one();
+
+        return true;
+    }
+
+    void ExtentPrefetcher::Run()
+    {
+        unique_lock lock(this->prefetcherMutex);
+
+        while (true)
+        {
+            this->prefetcherCondition.wait(lock, [this] { return !this->isRunning || !this->requests.empty(); });
+
+            if (!this->isRunning)
+                return;
+
+            const PrefetchRequest request = this->requests.front();
+            this->requests.pop_front();
+
+            lock.unlock();
+
+            size_t extentsRead = 0;
+
+            try
+            {
+                extentsRead = this->requestHandler(request);
+            }
+            catch (const exception &)
+            {
+                // the consumer reads the extent itself and reports the error if the read really fails
+            }
+
+            this->extentsRead.fetch_add(extentsRead, memory_order_relaxed);
+
+            lock.lock();
+
+            // removed only once loaded so a scan asking again meanwhile does not queue a second read
+            this->pendingRequests.erase(request.GetKey());
+        }
+    }
+
+    bool ExtentPrefetcher::IsRunning()
+    {
+        lock_guard lock(this->prefetcherMutex);
+
+        return this->isRunning;
+    }
+
+    size_t ExtentPrefetcher::GetPrefetchDepth() const { return this->prefetchDepth; }
+
+    void ExtentPrefetcher::GetStatistics(PrefetchStatistics &statistics) const
+    {
+        statistics.requestsQueued = this->requestsQueued;
+        statistics.requestsDropped = this->requestsDropped;
+        statistics.extentsRead = this->extentsRead;
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include "../../Constants.h"
+#include "../StorageSettings/StorageSettings.h"
+
+namespace DatabaseEngine::StorageTypes {
+    class Table;
+}
+
+namespace Storage {
+    using namespace std;
+
+    enum class PrefetchType : uint8_t
+    {
+        DATA_EXTENT = 0,
+        INDEX_LEAF_CHAIN = 1
+    };
+
+    typedef struct PrefetchRequest {
+        PrefetchType type;
+        extent_id_t extentId;
+        // first leaf of the chain and how many leaves to read ahead, only used by leaf chain requests
+        page_id_t leafPageId;
+        page_offset_t leafIndexPosition;
+        size_t depth;
+        const DatabaseEngine::StorageTypes::Table *table;
+
+        PrefetchRequest();
+        PrefetchRequest(const extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table *table);
+        PrefetchRequest(const page_id_t &leafPageId, const page_offset_t &leafIndexPosition, const size_t &depth, const DatabaseEngine::StorageTypes::Table *table);
+        ~PrefetchRequest();
+
+        [[nodiscard]] uint64_t GetKey() const;
+    } PrefetchRequest;
+
+    typedef struct PrefetchStatistics {
+        uint64_t requestsQueued;
+        uint64_t requestsDropped;
+        uint64_t extentsRead;
+        // prefetched pages that were accessed, and prefetched pages evicted before their first access
+        uint64_t hits;
+        uint64_t waste;
+
+        PrefetchStatistics();
+        ~PrefetchStatistics();
+    } PrefetchStatistics;
+
+    // read ahead worker, scans queue the extents they are about to visit and the worker loads them into the pools
+    // requests are only hints, they are dropped when the queue is full and a failed read is left to the consumer
+    class ExtentPrefetcher final {
+        function<size_t(const PrefetchRequest &)> requestHandler;
+        deque<PrefetchRequest> requests;
+        unordered_set<uint64_t> pendingRequests;
+        thread prefetcherThread;
+        mutex prefetcherMutex;
+        condition_variable prefetcherCondition;
+        bool isRunning;
+        atomic<size_t> prefetchDepth;
+        atomic<uint64_t> requestsQueued;
+        atomic<uint64_t> requestsDropped;
+        atomic<uint64_t> extentsRead;
+
+    protected:
+        void Run();
+
+    public:
+        explicit ExtentPrefetcher(const function<size_t(const PrefetchRequest &)> &requestHandler);
+        ExtentPrefetcher(const ExtentPrefetcher &other) = delete;
+        ~ExtentPrefetcher();
+
+        void Start(const StorageSettings &settings);
+        void Stop();
+        bool Enqueue(const PrefetchRequest &request);
+
+        [[nodiscard]] bool IsRunning();
+        [[nodiscard]] size_t GetPrefetchDepth() const;
+        void GetStatistics(PrefetchStatistics &statistics) const;
+    };
+}
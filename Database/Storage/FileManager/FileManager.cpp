@@ -74,6 +74,12 @@ namespace Storage{
         delete *fileIteratorKeyPair->second;
     }
 
+    void FileManager::FlushFiles()
+    {
+        for(const auto& file : this->filesList)
+            file->filePtr->flush();
+    }
+
     void FileManager::OpenFile(const string& fileName)
     {
         if(this->filesList.size() == MAX_OPEN_FILES)
@@ -33,5 +33,6 @@ namespace Storage{
             void CreateFile(const string& fileName, const string& extension);
             fstream* GetFile(const string& fileName);
             void CloseFile(const string& fileName);
+            void FlushFiles();
     };
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "FrameArena.h"
+#include <new>
+
+using namespace Constants;
+
+namespace Storage {
+    FrameArena::FrameArena(const size_t &frameCount)
+    {
+        this->frameCount = frameCount;
+        this->frames = static_cast<char *>(operator new[](frameCount * PAGE_SIZE, align_val_t(DIRECT_IO_ALIGNMENT)));
+
+        this->freeFrames.reserve(frameCount);
+
+        // handed out from the back, so the first frames are used first
+        for (size_t i = frameCount; i > 0; i--)
+            this->freeFrames.push_back(this->frames + (i - 1) * PAGE_SIZE);
+    }
+
+    FrameArena::~FrameArena()
+    {
+        operator delete[](this->frames, align_val_t(DIRECT_IO_ALIGNMENT));
+    }
+
+    bool FrameArena::IsArenaFrame(const char *frame) const
+    {
+        return frame >= this->frames && frame < this->frames + this->frameCount * PAGE_SIZE;
+    }
+
+    char *FrameArena::AcquireFrame()
+    {
+        {
+            lock_guard lock(this->arenaMutex);
+
+            if (!this->freeFrames.empty())
+            {
+                char *frame = this->freeFrames.back();
+                this->freeFrames.pop_back();
+
+                return frame;
+            }
+        }
+
+        return static_cast<char *>(operator new[](PAGE_SIZE, align_val_t(DIRECT_IO_ALIGNMENT)));
+    }
+
+    void FrameArena::ReleaseFrame(char *frame)
+    {
+        if (!this->IsArenaFrame(frame))
+        {
+            operator delete[](frame, align_val_t(DIRECT_IO_ALIGNMENT));
+            return;
+        }
+
+        lock_guard lock(this->arenaMutex);
+
+        this->freeFrames.push_back(frame);
+    }
+
+    size_t FrameArena::GetFrameCount() const { return this->frameCount; }
+}
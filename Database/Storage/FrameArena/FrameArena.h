@@ -0,0 +1,30 @@
+#pragma once
+#include <mutex>
+#include <vector>
+#include "../../Constants.h"
+
+namespace Storage {
+    using namespace std;
+
+    // PAGE_SIZE frames allocated once and aligned for direct I/O, handed out to and taken back from any thread
+    // when every frame is in use a frame is allocated just for that read instead of waiting, so a reader never blocks an eviction
+    class FrameArena final {
+        char *frames;
+        size_t frameCount;
+        vector<char *> freeFrames;
+        mutex arenaMutex;
+
+    protected:
+        [[nodiscard]] bool IsArenaFrame(const char *frame) const;
+
+    public:
+        explicit FrameArena(const size_t &frameCount);
+        FrameArena(const FrameArena &other) = delete;
+        ~FrameArena();
+
+        char *AcquireFrame();
+        void ReleaseFrame(char *frame);
+
+        [[nodiscard]] size_t GetFrameCount() const;
+    };
+}
@@ -0,0 +1,186 @@
+#include "DirectIoBackend.h"
+#include <algorithm>
+#include <cstring>
+#include "../../PositionalFile/PositionalFile.h"
+#include "../../../Pages/Page.h"
+
+namespace Storage {
+    DirectIoBackend::DirectIoBackend() : frameArena(DIRECT_IO_FRAMES) { }
+
+    DirectIoBackend::~DirectIoBackend()
+    {
+        for (const auto &[filename, file] : this->files)
+            delete file;
+    }
+
+    PositionalFile *DirectIoBackend::GetFile(const string &filename)
+    {
+        {
+            shared_lock lock(this->filesMutex);
+
+            const auto &fileIterator = this->files.find(filename);
+
+            if (fileIterator != this->files.end())
+                return fileIterator->second;
+        }
+
+        lock_guard lock(this->filesMutex);
+
+        const auto &fileIterator = this->files.find(filename);
+
+        if (fileIterator != this->files.end())
+            return fileIterator->second;
+
+        PositionalFile *file = new PositionalFile(filename, true);
+
+        this->files[filename] = file;
+
+        return file;
+    }
+
+    streamsize DirectIoBackend::ReadFrames(const string &filename, const streamoff &offset, const vector<span<char>> &frames)
+    {
+        const streamsize bytesRead = this->GetFile(filename)->ReadScatteredAt(frames, offset);
+
+        // frames are reused, so the part of a page cut short by the end of the file must not show an older page
+        const size_t framesTouched = (static_cast<size_t>(bytesRead) + PAGE_SIZE - 1) / PAGE_SIZE;
+
+        if (framesTouched > 0 && static_cast<size_t>(bytesRead) < framesTouched * PAGE_SIZE)
+        {
+            const size_t bytesFilled = static_cast<size_t>(bytesRead) - (framesTouched - 1) * PAGE_SIZE;
+
+            memset(frames[framesTouched - 1].data() + bytesFilled, 0, PAGE_SIZE - bytesFilled);
+        }
+
+        return bytesRead;
+    }
+
+    streamsize DirectIoBackend::Read(const string &filename, const streamoff &offset, char *buffer, const size_t &size)
+    {
+        // direct reads have to start and end on frame boundaries, so the range is read a frame at a time and copied out
+        char *frame = this->frameArena.AcquireFrame();
+        size_t bytesCopied = 0;
+
+        try
+        {
+            while (bytesCopied < size)
+            {
+                const streamoff position = offset + static_cast<streamoff>(bytesCopied);
+                const streamoff frameOffset = position - position % PAGE_SIZE;
+                const size_t frameStart = static_cast<size_t>(position - frameOffset);
+
+                const streamsize bytesRead = this->ReadFrames(filename, frameOffset, { span<char>(frame, PAGE_SIZE) });
+
+                if (bytesRead <= static_cast<streamsize>(frameStart))
+                    break;
+
+                const size_t bytesToCopy = min(size - bytesCopied, static_cast<size_t>(bytesRead) - frameStart);
+
+                memcpy(buffer + bytesCopied, frame + frameStart, bytesToCopy);
+                bytesCopied += bytesToCopy;
+
+                if (bytesRead < static_cast<streamsize>(PAGE_SIZE))
+                    break;
+            }
+        }
+        catch (...)
+        {
+            this->frameArena.ReleaseFrame(frame);
+            throw;
+        }
+
+        this->frameArena.ReleaseFrame(frame);
+
+        return static_cast<streamsize>(bytesCopied);
+    }
+
+    streamsize DirectIoBackend::ReadPages(const string &filename, const page_id_t &firstPageId, vector<vector<char>> &pageBuffers)
+    {
+        PageReadBuffer readBuffer;
+
+        this->AcquirePages(filename, firstPageId, pageBuffers.size(), AccessPattern::SEQUENTIAL, readBuffer.pages);
+        readBuffer.owner = this;
+
+        for (size_t i = 0; i < readBuffer.pages.size(); i++)
+            memcpy(pageBuffers[i].data(), readBuffer.pages[i].data(), PAGE_SIZE);
+
+        return static_cast<streamsize>(readBuffer.pages.size() * PAGE_SIZE);
+    }
+
+    bool DirectIoBackend::AcquirePages(const string &filename, const page_id_t &firstPageId, const size_t &pageCount, const AccessPattern &accessPattern, vector<span<const char>> &pages)
+    {
+        // the page cache is bypassed, so there is no read-ahead to hint either way
+        vector<span<char>> frames;
+        frames.reserve(pageCount);
+
+        for (size_t i = 0; i < pageCount; i++)
+            frames.emplace_back(this->frameArena.AcquireFrame(), PAGE_SIZE);
+
+        streamsize bytesRead = 0;
+
+        try
+        {
+            bytesRead = this->ReadFrames(filename, GetPageOffset(firstPageId), frames);
+        }
+        catch (...)
+        {
+            for (const auto &frame : frames)
+                this->frameArena.ReleaseFrame(frame.data());
+
+            throw;
+        }
+
+        for (size_t i = 0; i < pageCount; i++)
+        {
+            if (static_cast<streamsize>(i * PAGE_SIZE) < bytesRead)
+                pages.emplace_back(frames[i].data(), PAGE_SIZE);
+            else
+                this->frameArena.ReleaseFrame(frames[i].data());
+        }
+
+        return true;
+    }
+
+    void DirectIoBackend::ReleasePages(const vector<span<const char>> &pages)
+    {
+        for (const auto &page : pages)
+            this->frameArena.ReleaseFrame(const_cast<char *>(page.data()));
+    }
+
+    void DirectIoBackend::WritePages(const vector<Pages::Page *> &pages)
+    {
+        vector<vector<Pages::Page *>> pageRuns;
+
+        IoBackend::GetPageRuns(pages, pageRuns);
+
+        // whole aligned pages are written, so the write never has to read the rest of a block back first
+        vector<span<const char>> frames;
+
+        try
+        {
+            for (const auto &pageRun : pageRuns)
+            {
+                for (const auto &page : pageRun)
+                {
+                    char *frame = this->frameArena.AcquireFrame();
+
+                    frames.emplace_back(frame, PAGE_SIZE);
+
+                    IoBackend::SerializePage(page, frame);
+                }
+
+                this->GetFile(pageRun[0]->GetFileName())->WriteGatheredAt(frames, GetPageOffset(pageRun[0]->GetPageId()));
+
+                this->ReleasePages(frames);
+                frames.clear();
+            }
+        }
+        catch (...)
+        {
+            this->ReleasePages(frames);
+            throw;
+        }
+    }
+
+    IoBackendType DirectIoBackend::GetType() const { return IoBackendType::DIRECT; }
+}
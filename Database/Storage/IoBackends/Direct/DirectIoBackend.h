@@ -0,0 +1,34 @@
+#pragma once
+#include <shared_mutex>
+#include <unordered_map>
+#include "../IoBackend.h"
+#include "../../FrameArena/FrameArena.h"
+
+namespace Storage {
+    class PositionalFile;
+
+    // pread/pwrite that bypass the page cache, so a page is held in memory once, by the buffer pool, instead of twice
+    // extents are read into aligned frames of a preallocated arena and parsed straight from there
+    class DirectIoBackend final : public IoBackend {
+        FrameArena frameArena;
+        unordered_map<string, PositionalFile *> files;
+        shared_mutex filesMutex;
+
+    protected:
+        PositionalFile *GetFile(const string &filename);
+        streamsize ReadFrames(const string &filename, const streamoff &offset, const vector<span<char>> &frames);
+
+    public:
+        DirectIoBackend();
+        DirectIoBackend(const DirectIoBackend &other) = delete;
+        ~DirectIoBackend() override;
+
+        streamsize Read(const string &filename, const streamoff &offset, char *buffer, const size_t &size) override;
+        streamsize ReadPages(const string &filename, const page_id_t &firstPageId, vector<vector<char>> &pageBuffers) override;
+        bool AcquirePages(const string &filename, const page_id_t &firstPageId, const size_t &pageCount, const AccessPattern &accessPattern, vector<span<const char>> &pages) override;
+        void ReleasePages(const vector<span<const char>> &pages) override;
+        void WritePages(const vector<Pages::Page *> &pages) override;
+
+        [[nodiscard]] IoBackendType GetType() const override;
+    };
+}
@@ -0,0 +1,72 @@
+#include "FstreamIoBackend.h"
+#include "../../FileManager/FileManager.h"
+#include "../../../Pages/Page.h"
+
+namespace Storage {
+    FstreamIoBackend::FstreamIoBackend(FileManager *fileManager, mutex *fileMutex)
+    {
+        this->fileManager = fileManager;
+        this->fileMutex = fileMutex;
+    }
+
+    FstreamIoBackend::~FstreamIoBackend()
+    {
+        // another backend may read the files next, it has to see the writes still buffered in the streams
+        lock_guard lock(*this->fileMutex);
+
+        this->fileManager->FlushFiles();
+    }
+
+    streamsize FstreamIoBackend::Read(const string &filename, const streamoff &offset, char *buffer, const size_t &size)
+    {
+        lock_guard lock(*this->fileMutex);
+
+        fstream *file = this->fileManager->GetFile(filename);
+
+        SetReadFilePointerToOffset(file, offset);
+
+        file->read(buffer, static_cast<streamsize>(size));
+
+        return file->gcount();
+    }
+
+    void FstreamIoBackend::WritePages(const vector<Pages::Page *> &pages)
+    {
+        vector<vector<Pages::Page *>> pageRuns;
+
+        IoBackend::GetPageRuns(pages, pageRuns);
+
+        vector<char> buffer(WRITE_COALESCE_PAGES * PAGE_SIZE);
+
+        lock_guard lock(*this->fileMutex);
+
+        // one seek and one write per run, the pages are padded so the next one starts on its own offset
+        for (const auto &pageRun : pageRuns)
+        {
+            for (size_t i = 0; i < pageRun.size(); i++)
+                IoBackend::SerializePage(pageRun[i], buffer.data() + i * PAGE_SIZE);
+
+            fstream *file = this->fileManager->GetFile(pageRun[0]->GetFileName());
+
+            SetWriteFilePointerToOffset(file, GetPageOffset(pageRun[0]->GetPageId()));
+
+            file->write(buffer.data(), static_cast<streamsize>(pageRun.size() * PAGE_SIZE));
+        }
+    }
+
+    IoBackendType FstreamIoBackend::GetType() const { return IoBackendType::FSTREAM; }
+
+    void FstreamIoBackend::SetReadFilePointerToOffset(fstream *file, const streampos &offSet)
+    {
+        file->clear();
+        file->seekg(0, ios::beg);
+        file->seekg(offSet);
+    }
+
+    void FstreamIoBackend::SetWriteFilePointerToOffset(fstream *file, const streampos &offSet)
+    {
+        file->clear();
+        file->seekp(0, ios::beg);
+        file->seekp(offSet);
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <fstream>
+#include "../IoBackend.h"
+
+namespace Storage {
+    // seeks and reads or writes the shared fstream of the file, every call holds the file lock
+    class FstreamIoBackend final : public IoBackend {
+        FileManager *fileManager;
+        mutex *fileMutex;
+
+    protected:
+        static void SetReadFilePointerToOffset(fstream *file, const streampos &offSet);
+        static void SetWriteFilePointerToOffset(fstream *file, const streampos &offSet);
+
+    public:
+        FstreamIoBackend(FileManager *fileManager, mutex *fileMutex);
+        ~FstreamIoBackend() override;
+
+        streamsize Read(const string &filename, const streamoff &offset, char *buffer, const size_t &size) override;
+        void WritePages(const vector<Pages::Page *> &pages) override;
+
+        [[nodiscard]] IoBackendType GetType() const override;
+    };
+}
@@ -0,0 +1,132 @@
+#include "IoBackend.h"
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include "Fstream/FstreamIoBackend.h"
+#include "Direct/DirectIoBackend.h"
+#include "IoUring/IoUringIoBackend.h"
+#include "MemoryMapped/MemoryMappedIoBackend.h"
+#include "Positional/PositionalIoBackend.h"
+#include "../../Pages/Page.h"
+
+namespace Storage {
+    MemoryStreamBuffer::MemoryStreamBuffer(char *buffer, const size_t &size)
+    {
+        this->setp(buffer, buffer + size);
+    }
+
+    MemoryStreamBuffer::~MemoryStreamBuffer() = default;
+
+    size_t MemoryStreamBuffer::GetSize() const { return this->pptr() - this->pbase(); }
+
+    PageReadBuffer::PageReadBuffer()
+    {
+        this->owner = nullptr;
+    }
+
+    PageReadBuffer::~PageReadBuffer()
+    {
+        if (this->owner != nullptr)
+            this->owner->ReleasePages(this->pages);
+    }
+
+    IoBackend::~IoBackend() = default;
+
+    streamoff IoBackend::GetPageOffset(const page_id_t &pageId) { return static_cast<streamoff>(pageId) * PAGE_SIZE; }
+
+    void IoBackend::SerializePage(Pages::Page *page, char *buffer)
+    {
+        MemoryStreamBuffer streamBuffer(buffer, PAGE_SIZE);
+        ostream stream(&streamBuffer);
+
+        page->WritePageToFile(&stream);
+
+        // a full buffer makes the stream fail instead of growing
+        if (!stream)
+            throw runtime_error("IoBackend::SerializePage: Page " + to_string(page->GetPageId()) + " does not fit in a page");
+
+        memset(buffer + streamBuffer.GetSize(), 0, PAGE_SIZE - streamBuffer.GetSize());
+    }
+
+    void IoBackend::GetPageRuns(const vector<Pages::Page *> &pages, vector<vector<Pages::Page *>> &pageRuns)
+    {
+        vector<Pages::Page *> sortedPages = pages;
+
+        sort(sortedPages.begin(), sortedPages.end(), [](const Pages::Page *first, const Pages::Page *second)
+        {
+            if (first->GetFileName() != second->GetFileName())
+                return first->GetFileName() < second->GetFileName();
+
+            return first->GetPageId() < second->GetPageId();
+        });
+
+        for (const auto &page : sortedPages)
+        {
+            if (!pageRuns.empty())
+            {
+                vector<Pages::Page *> &pageRun = pageRuns.back();
+                const Pages::Page *lastPage = pageRun.back();
+
+                if (pageRun.size() < WRITE_COALESCE_PAGES && lastPage->GetPageId() + 1 == page->GetPageId() && lastPage->GetFileName() == page->GetFileName())
+                {
+                    pageRun.push_back(page);
+                    continue;
+                }
+            }
+
+            pageRuns.push_back({ page });
+        }
+    }
+
+    streamsize IoBackend::ReadPages(const string &filename, const page_id_t &firstPageId, vector<vector<char>> &pageBuffers)
+    {
+        // backends without scatter reads read the whole range at once and split it
+        vector<char> buffer(pageBuffers.size() * PAGE_SIZE);
+
+        const streamsize bytesRead = this->Read(filename, GetPageOffset(firstPageId), buffer.data(), buffer.size());
+
+        for (size_t i = 0; i < pageBuffers.size() && static_cast<streamsize>(i * PAGE_SIZE) < bytesRead; i++)
+            memcpy(pageBuffers[i].data(), buffer.data() + i * PAGE_SIZE, min(PAGE_SIZE, static_cast<size_t>(bytesRead) - i * PAGE_SIZE));
+
+        return bytesRead;
+    }
+
+    bool IoBackend::AcquirePages(const string &filename, const page_id_t &firstPageId, const size_t &pageCount, const AccessPattern &accessPattern, vector<span<const char>> &pages)
+    {
+        return false;
+    }
+
+    void IoBackend::ReleasePages(const vector<span<const char>> &pages) { }
+
+    IoBackend *IoBackend::Create(const IoBackendType &backendType, FileManager *fileManager, mutex *fileMutex)
+    {
+        switch (backendType)
+        {
+            case IoBackendType::FSTREAM:
+                return new FstreamIoBackend(fileManager, fileMutex);
+            case IoBackendType::POSITIONAL:
+                return new PositionalIoBackend();
+            case IoBackendType::MEMORY_MAPPED:
+                return new MemoryMappedIoBackend();
+            case IoBackendType::DIRECT:
+                return new DirectIoBackend();
+            case IoBackendType::IO_URING:
+#ifdef IO_URING_SUPPORTED
+                try
+                {
+                    return new IoUringIoBackend();
+                }
+                catch (const runtime_error &)
+                {
+                    // io_uring disabled by the kernel or the sandbox
+                    return new FstreamIoBackend(fileManager, fileMutex);
+                }
+#else
+                return new FstreamIoBackend(fileManager, fileMutex);
+#endif
+            default:
+                throw invalid_argument("IoBackend::Create: Unknown I/O backend");
+        }
+    }
+}
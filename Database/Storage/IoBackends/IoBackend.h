@@ -0,0 +1,79 @@
+#pragma once
+#include <mutex>
+#include <span>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "../../Constants.h"
+
+using namespace Constants;
+
+namespace Pages {
+    class Page;
+}
+
+namespace Storage {
+    using namespace std;
+
+    class FileManager;
+    class IoBackend;
+
+    // pages of one read as handed to the parsers, either views of memory the backend lends out until the buffer goes out of scope
+    // or views of buffers the pages were copied into
+    typedef struct PageReadBuffer {
+        vector<span<const char>> pages;
+        vector<vector<char>> buffers;
+        IoBackend *owner;
+
+        PageReadBuffer();
+        PageReadBuffer(const PageReadBuffer &other) = delete;
+        PageReadBuffer &operator=(const PageReadBuffer &other) = delete;
+        ~PageReadBuffer();
+    } PageReadBuffer;
+
+    // fixed size output buffer, pages are serialized into it before they are handed to the kernel
+    class MemoryStreamBuffer final : public streambuf {
+    public:
+        MemoryStreamBuffer(char *buffer, const size_t &size);
+        ~MemoryStreamBuffer() override;
+
+        [[nodiscard]] size_t GetSize() const;
+    };
+
+    // reads and writes pages of the database files, every call is safe to make from multiple threads
+    class IoBackend {
+    protected:
+        static streamoff GetPageOffset(const page_id_t &pageId);
+
+        // writes the page into a PAGE_SIZE buffer, the bytes after the page data are zeroed
+        static void SerializePage(Pages::Page *page, char *buffer);
+
+        // orders the pages by file and page id and splits them into runs of at most WRITE_COALESCE_PAGES consecutive pages of one file
+        static void GetPageRuns(const vector<Pages::Page *> &pages, vector<vector<Pages::Page *>> &pageRuns);
+
+    public:
+        virtual ~IoBackend();
+
+        // reads up to size bytes starting at offset, returns the number of bytes read which is short at the end of the file
+        virtual streamsize Read(const string &filename, const streamoff &offset, char *buffer, const size_t &size) = 0;
+
+        // reads consecutive pages into their own PAGE_SIZE buffers, pageBuffers[i] receives page firstPageId + i
+        // returns the number of bytes read over all pages
+        virtual streamsize ReadPages(const string &filename, const page_id_t &firstPageId, vector<vector<char>> &pageBuffers);
+
+        // lends out consecutive pages from memory of the backend, pages[i] views page firstPageId + i and pages past the end of the file are left out
+        // returns false when the backend has no memory to serve them from and they have to be read with ReadPages
+        virtual bool AcquirePages(const string &filename, const page_id_t &firstPageId, const size_t &pageCount, const AccessPattern &accessPattern, vector<span<const char>> &pages);
+
+        // takes back pages lent out by AcquirePages once they have been parsed
+        virtual void ReleasePages(const vector<span<const char>> &pages);
+
+        // writes every page at its own offset in its own file, consecutive pages go out together where the backend can
+        virtual void WritePages(const vector<Pages::Page *> &pages) = 0;
+
+        [[nodiscard]] virtual IoBackendType GetType() const = 0;
+
+        // the fstream backend shares the file handles and their lock with the storage manager
+        static IoBackend *Create(const IoBackendType &backendType, FileManager *fileManager, mutex *fileMutex);
+    };
+}
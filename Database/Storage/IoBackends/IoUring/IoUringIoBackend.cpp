@@ -0,0 +1,479 @@
+#include "IoUringIoBackend.h"
+
+#ifdef IO_URING_SUPPORTED
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "../../PositionalFile/PositionalFile.h"
+#include "../../../Pages/Page.h"
+
+namespace Storage {
+    IoCompletion::IoCompletion()
+    {
+        this->result = 0;
+        this->isDone = false;
+        this->bufferIndex = -1;
+    }
+
+    IoCompletion::~IoCompletion() = default;
+
+    IoUringIoBackend::IoUringIoBackend()
+    {
+        this->ringEntries = 0;
+        this->inFlight = 0;
+        this->pendingSubmissions = 0;
+        this->isReaping = false;
+        this->submissionRing = nullptr;
+        this->submissionRingSize = 0;
+        this->submissionEntries = nullptr;
+        this->submissionEntriesSize = 0;
+        this->completionRing = nullptr;
+        this->completionRingSize = 0;
+        this->writeBuffers = nullptr;
+        this->areWriteBuffersRegistered = false;
+
+        io_uring_params params;
+        memset(&params, 0, sizeof(io_uring_params));
+
+        this->ringFileDescriptor = static_cast<int>(syscall(__NR_io_uring_setup, IO_URING_QUEUE_DEPTH, &params));
+
+        if (this->ringFileDescriptor < 0)
+            throw runtime_error("IoUringIoBackend: io_uring could not be set up: " + string(strerror(errno)));
+
+        this->ringEntries = params.sq_entries;
+        this->submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        this->completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        this->submissionEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+        // newer kernels map both rings with a single mmap
+        const bool isSingleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+        if (isSingleMapping)
+        {
+            this->submissionRingSize = max(this->submissionRingSize, this->completionRingSize);
+            this->completionRingSize = this->submissionRingSize;
+        }
+
+        void *submissionRing = mmap(nullptr, this->submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFileDescriptor, IORING_OFF_SQ_RING);
+        this->submissionRing = (submissionRing == MAP_FAILED) ? nullptr : submissionRing;
+
+        void *completionRing = isSingleMapping
+                                ? this->submissionRing
+                                : mmap(nullptr, this->completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFileDescriptor, IORING_OFF_CQ_RING);
+        this->completionRing = (completionRing == MAP_FAILED) ? nullptr : completionRing;
+
+        void *submissionEntries = mmap(nullptr, this->submissionEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFileDescriptor, IORING_OFF_SQES);
+        this->submissionEntries = (submissionEntries == MAP_FAILED) ? nullptr : static_cast<io_uring_sqe *>(submissionEntries);
+
+        if (this->submissionRing == nullptr || this->completionRing == nullptr || this->submissionEntries == nullptr)
+        {
+            this->ReleaseRing();
+            throw runtime_error("IoUringIoBackend: io_uring rings could not be mapped");
+        }
+
+        char *submissionRingBytes = static_cast<char *>(this->submissionRing);
+        this->submissionTail = reinterpret_cast<uint32_t *>(submissionRingBytes + params.sq_off.tail);
+        this->submissionMask = reinterpret_cast<uint32_t *>(submissionRingBytes + params.sq_off.ring_mask);
+        this->submissionArray = reinterpret_cast<uint32_t *>(submissionRingBytes + params.sq_off.array);
+
+        char *completionRingBytes = static_cast<char *>(this->completionRing);
+        this->completionHead = reinterpret_cast<uint32_t *>(completionRingBytes + params.cq_off.head);
+        this->completionTail = reinterpret_cast<uint32_t *>(completionRingBytes + params.cq_off.tail);
+        this->completionMask = reinterpret_cast<uint32_t *>(completionRingBytes + params.cq_off.ring_mask);
+        this->completionEntries = reinterpret_cast<io_uring_cqe *>(completionRingBytes + params.cq_off.cqes);
+
+        // kernels older than 5.6 cannot probe and do not have the plain read and write opcodes
+        vector<char> probeBuffer(sizeof(io_uring_probe) + IORING_OP_LAST * sizeof(io_uring_probe_op), 0);
+        io_uring_probe *probe = reinterpret_cast<io_uring_probe *>(probeBuffer.data());
+
+        if (syscall(__NR_io_uring_register, this->ringFileDescriptor, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) < 0
+            || probe->last_op < IORING_OP_WRITE
+            || (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) == 0
+            || (probe->ops[IORING_OP_READV].flags & IO_URING_OP_SUPPORTED) == 0
+            || (probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED) == 0)
+        {
+            this->ReleaseRing();
+            throw runtime_error("IoUringIoBackend: io_uring does not support positional reads and writes");
+        }
+
+        // one page sized write buffer per ring entry
+        this->writeBuffers = static_cast<char *>(operator new(this->ringEntries * PAGE_SIZE, align_val_t(PAGE_SIZE)));
+
+        vector<iovec> bufferVectors(this->ringEntries);
+
+        for (uint32_t i = 0; i < this->ringEntries; i++)
+        {
+            bufferVectors[i].iov_base = this->writeBuffers + i * PAGE_SIZE;
+            bufferVectors[i].iov_len = PAGE_SIZE;
+
+            this->freeWriteBuffers.push_back(static_cast<int>(i));
+        }
+
+        // registration can fail on a low locked memory limit, the buffers are then passed as plain addresses
+        this->areWriteBuffersRegistered = syscall(__NR_io_uring_register, this->ringFileDescriptor, IORING_REGISTER_BUFFERS, bufferVectors.data(), this->ringEntries) == 0;
+    }
+
+    IoUringIoBackend::~IoUringIoBackend()
+    {
+        this->ReleaseRing();
+
+        for (const auto &[filename, file] : this->files)
+            delete file;
+    }
+
+    void IoUringIoBackend::ReleaseRing()
+    {
+        if (this->submissionEntries != nullptr)
+            munmap(this->submissionEntries, this->submissionEntriesSize);
+
+        if (this->completionRing != nullptr && this->completionRing != this->submissionRing)
+            munmap(this->completionRing, this->completionRingSize);
+
+        if (this->submissionRing != nullptr)
+            munmap(this->submissionRing, this->submissionRingSize);
+
+        if (this->ringFileDescriptor >= 0)
+            close(this->ringFileDescriptor);
+
+        if (this->writeBuffers != nullptr)
+            operator delete(this->writeBuffers, align_val_t(PAGE_SIZE));
+
+        this->submissionEntries = nullptr;
+        this->completionRing = nullptr;
+        this->submissionRing = nullptr;
+        this->ringFileDescriptor = -1;
+        this->writeBuffers = nullptr;
+    }
+
+    int IoUringIoBackend::GetFileDescriptor(const string &filename)
+    {
+        lock_guard lock(this->filesMutex);
+
+        const auto &fileIterator = this->files.find(filename);
+
+        if (fileIterator != this->files.end())
+            return fileIterator->second->GetFileDescriptor();
+
+        PositionalFile *file = new PositionalFile(filename);
+
+        this->files[filename] = file;
+
+        return file->GetFileDescriptor();
+    }
+
+    io_uring_sqe *IoUringIoBackend::GetSubmissionEntry()
+    {
+        // callers reserve their ring entries through inFlight, so a free submission entry is always there
+        const uint32_t index = (*this->submissionTail + this->pendingSubmissions) & *this->submissionMask;
+
+        io_uring_sqe *entry = &this->submissionEntries[index];
+        memset(entry, 0, sizeof(io_uring_sqe));
+
+        this->submissionArray[index] = index;
+        this->pendingSubmissions++;
+
+        return entry;
+    }
+
+    uint32_t IoUringIoBackend::SubmitEntries(int &submitError)
+    {
+        const uint32_t tail = *this->submissionTail;
+
+        // the tail is only published once the entries are filled in
+        atomic_ref(*this->submissionTail).store(tail + this->pendingSubmissions, memory_order_release);
+
+        uint32_t submittedEntries = 0;
+        submitError = 0;
+
+        while (submittedEntries < this->pendingSubmissions)
+        {
+            const long result = syscall(__NR_io_uring_enter, this->ringFileDescriptor, this->pendingSubmissions - submittedEntries, 0, 0, nullptr, 0);
+
+            if (result < 0 && errno == EINTR)
+                continue;
+
+            if (result <= 0)
+            {
+                submitError = (result < 0) ? errno : EAGAIN;
+                break;
+            }
+
+            submittedEntries += static_cast<uint32_t>(result);
+        }
+
+        // the kernel only consumes entries inside io_uring_enter, which runs under the ring lock, so the ones it did not take can be withdrawn
+        // otherwise the next submission would hand them over with a user_data whose completion is gone
+        if (submittedEntries < this->pendingSubmissions)
+            atomic_ref(*this->submissionTail).store(tail + submittedEntries, memory_order_release);
+
+        this->pendingSubmissions = 0;
+
+        return submittedEntries;
+    }
+
+    void IoUringIoBackend::ReapCompletions()
+    {
+        uint32_t head = *this->completionHead;
+        const uint32_t tail = atomic_ref(*this->completionTail).load(memory_order_acquire);
+
+        for (; head != tail; head++)
+        {
+            const io_uring_cqe &completionEntry = this->completionEntries[head & *this->completionMask];
+
+            IoCompletion *completion = reinterpret_cast<IoCompletion *>(completionEntry.user_data);
+
+            if (completion->bufferIndex >= 0)
+                this->freeWriteBuffers.push_back(completion->bufferIndex);
+
+            completion->result = completionEntry.res;
+            completion->isDone = true;
+
+            this->inFlight--;
+        }
+
+        atomic_ref(*this->completionHead).store(head, memory_order_release);
+    }
+
+    void IoUringIoBackend::WaitForCompletions(const vector<IoCompletion *> &completions)
+    {
+        const auto areCompletionsDone = [&completions] { return ranges::all_of(completions, [](const IoCompletion *completion) { return completion->isDone; }); };
+
+        unique_lock lock(this->ringMutex);
+
+        // a single thread reaps for everyone, otherwise a completion could be taken away from the thread blocked in the kernel for it
+        while (!areCompletionsDone())
+        {
+            if (this->isReaping)
+            {
+                this->ringCondition.wait(lock);
+                continue;
+            }
+
+            this->isReaping = true;
+
+            this->ReapCompletions();
+
+            if (!areCompletionsDone())
+            {
+                lock.unlock();
+
+                syscall(__NR_io_uring_enter, this->ringFileDescriptor, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+                lock.lock();
+
+                this->ReapCompletions();
+            }
+
+            this->isReaping = false;
+
+            this->ringCondition.notify_all();
+        }
+    }
+
+    streamsize IoUringIoBackend::SubmitRead(const int &fileDescriptor, const uint8_t &opcode, const uint64_t &address, const uint32_t &length, const uint64_t &offset)
+    {
+        IoCompletion completion;
+        int submitError = 0;
+
+        {
+            unique_lock lock(this->ringMutex);
+
+            this->ringCondition.wait(lock, [this] { return this->inFlight < this->ringEntries; });
+
+            io_uring_sqe *entry = this->GetSubmissionEntry();
+            entry->opcode = opcode;
+            entry->fd = fileDescriptor;
+            entry->addr = address;
+            entry->len = length;
+            entry->off = offset;
+            entry->user_data = reinterpret_cast<uint64_t>(&completion);
+
+            this->inFlight++;
+
+            if (this->SubmitEntries(submitError) == 0)
+            {
+                this->inFlight--;
+
+                this->ringCondition.notify_all();
+            }
+        }
+
+        // the entry never reached the kernel, nothing refers to the completion anymore
+        if (submitError != 0)
+            throw runtime_error("IoUringIoBackend::SubmitRead: " + string(strerror(submitError)));
+
+        this->WaitForCompletions({ &completion });
+
+        if (completion.result < 0)
+            throw runtime_error("IoUringIoBackend::SubmitRead: " + string(strerror(-completion.result)));
+
+        return completion.result;
+    }
+
+    streamsize IoUringIoBackend::Read(const string &filename, const streamoff &offset, char *buffer, const size_t &size)
+    {
+        const int fileDescriptor = this->GetFileDescriptor(filename);
+
+        size_t bytesRead = 0;
+
+        while (bytesRead < size)
+        {
+            const streamsize chunkBytesRead = this->SubmitRead(fileDescriptor, IORING_OP_READ, reinterpret_cast<uint64_t>(buffer + bytesRead),
+                                                               static_cast<uint32_t>(size - bytesRead), static_cast<uint64_t>(offset) + bytesRead);
+
+            // end of the file
+            if (chunkBytesRead == 0)
+                break;
+
+            bytesRead += static_cast<size_t>(chunkBytesRead);
+        }
+
+        return static_cast<streamsize>(bytesRead);
+    }
+
+    streamsize IoUringIoBackend::ReadPages(const string &filename, const page_id_t &firstPageId, vector<vector<char>> &pageBuffers)
+    {
+        const int fileDescriptor = this->GetFileDescriptor(filename);
+
+        vector<iovec> bufferVectors(pageBuffers.size());
+
+        for (size_t i = 0; i < pageBuffers.size(); i++)
+        {
+            bufferVectors[i].iov_base = pageBuffers[i].data();
+            bufferVectors[i].iov_len = pageBuffers[i].size();
+        }
+
+        // one readv for the whole extent, a short read is finished page by page
+        const streamsize bytesRead = this->SubmitRead(fileDescriptor, IORING_OP_READV, reinterpret_cast<uint64_t>(bufferVectors.data()),
+                                                      static_cast<uint32_t>(bufferVectors.size()), static_cast<uint64_t>(GetPageOffset(firstPageId)));
+
+        if (bytesRead == 0 || bytesRead == static_cast<streamsize>(pageBuffers.size() * PAGE_SIZE))
+            return bytesRead;
+
+        size_t pageIndex = static_cast<size_t>(bytesRead) / PAGE_SIZE;
+        size_t pageBytesRead = static_cast<size_t>(bytesRead) % PAGE_SIZE;
+        streamsize totalBytesRead = bytesRead;
+
+        for (; pageIndex < pageBuffers.size(); pageIndex++, pageBytesRead = 0)
+        {
+            const streamoff pageOffset = GetPageOffset(firstPageId + static_cast<page_id_t>(pageIndex)) + static_cast<streamoff>(pageBytesRead);
+
+            const streamsize chunkBytesRead = this->Read(filename, pageOffset, pageBuffers[pageIndex].data() + pageBytesRead, PAGE_SIZE - pageBytesRead);
+
+            totalBytesRead += chunkBytesRead;
+
+            if (chunkBytesRead < static_cast<streamsize>(PAGE_SIZE - pageBytesRead))
+                break;
+        }
+
+        return totalBytesRead;
+    }
+
+    void IoUringIoBackend::WritePages(const vector<Pages::Page *> &pages)
+    {
+        // at most one write per ring entry is in flight, larger batches go out in chunks
+        for (size_t chunkStart = 0; chunkStart < pages.size(); chunkStart += this->ringEntries)
+        {
+            const size_t chunkSize = min(static_cast<size_t>(this->ringEntries), pages.size() - chunkStart);
+
+            vector<IoCompletion> completions(chunkSize);
+            vector<IoCompletion *> chunkCompletions;
+            vector<int> fileDescriptors;
+
+            {
+                unique_lock lock(this->ringMutex);
+
+                this->ringCondition.wait(lock, [this, chunkSize] { return this->inFlight + chunkSize <= this->ringEntries && this->freeWriteBuffers.size() >= chunkSize; });
+
+                for (auto &completion : completions)
+                {
+                    completion.bufferIndex = this->freeWriteBuffers.back();
+                    this->freeWriteBuffers.pop_back();
+                }
+
+                this->inFlight += static_cast<uint32_t>(chunkSize);
+            }
+
+            try
+            {
+                // pages are serialized without holding the ring lock
+                for (size_t i = 0; i < chunkSize; i++)
+                {
+                    Pages::Page *page = pages[chunkStart + i];
+
+                    IoBackend::SerializePage(page, this->writeBuffers + completions[i].bufferIndex * PAGE_SIZE);
+
+                    fileDescriptors.push_back(this->GetFileDescriptor(page->GetFileName()));
+                }
+            }
+            catch (const exception &)
+            {
+                lock_guard lock(this->ringMutex);
+
+                for (const auto &completion : completions)
+                    this->freeWriteBuffers.push_back(completion.bufferIndex);
+
+                this->inFlight -= static_cast<uint32_t>(chunkSize);
+
+                this->ringCondition.notify_all();
+
+                throw;
+            }
+
+            int submitError = 0;
+
+            {
+                lock_guard lock(this->ringMutex);
+
+                for (size_t i = 0; i < chunkSize; i++)
+                {
+                    io_uring_sqe *entry = this->GetSubmissionEntry();
+                    entry->opcode = this->areWriteBuffersRegistered ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+                    entry->fd = fileDescriptors[i];
+                    entry->addr = reinterpret_cast<uint64_t>(this->writeBuffers + completions[i].bufferIndex * PAGE_SIZE);
+                    entry->len = PAGE_SIZE;
+                    entry->off = static_cast<uint64_t>(GetPageOffset(pages[chunkStart + i]->GetPageId()));
+                    entry->buf_index = static_cast<uint16_t>(completions[i].bufferIndex);
+                    entry->user_data = reinterpret_cast<uint64_t>(&completions[i]);
+
+                    chunkCompletions.push_back(&completions[i]);
+                }
+
+                const uint32_t submittedEntries = this->SubmitEntries(submitError);
+
+                // writes the kernel did not take give back their ring entries and buffers, the ones it took are waited for below
+                for (size_t i = submittedEntries; i < chunkSize; i++)
+                    this->freeWriteBuffers.push_back(completions[i].bufferIndex);
+
+                this->inFlight -= static_cast<uint32_t>(chunkSize - submittedEntries);
+
+                chunkCompletions.resize(submittedEntries);
+
+                if (submittedEntries < chunkSize)
+                    this->ringCondition.notify_all();
+            }
+
+            // the completions live on this stack frame, so it is only left once the kernel is done with every submitted write
+            this->WaitForCompletions(chunkCompletions);
+
+            if (submitError != 0)
+                throw runtime_error("IoUringIoBackend::WritePages: " + string(strerror(submitError)));
+
+            for (size_t i = 0; i < chunkSize; i++)
+            {
+                if (completions[i].result != static_cast<int>(PAGE_SIZE))
+                    throw runtime_error("IoUringIoBackend::WritePages: Page " + to_string(pages[chunkStart + i]->GetPageId()) + " could not be written");
+            }
+        }
+    }
+
+    IoBackendType IoUringIoBackend::GetType() const { return IoBackendType::IO_URING; }
+}
+#endif
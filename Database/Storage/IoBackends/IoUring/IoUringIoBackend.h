@@ -0,0 +1,81 @@
+#pragma once
+#include "../IoBackend.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define IO_URING_SUPPORTED
+#endif
+
+#ifdef IO_URING_SUPPORTED
+#include <condition_variable>
+#include <unordered_map>
+#include <linux/io_uring.h>
+
+namespace Storage {
+    class PositionalFile;
+
+    typedef struct IoCompletion {
+        int result;
+        bool isDone;
+        // registered write buffer returned to the free list once the write completes, -1 for reads
+        int bufferIndex;
+
+        IoCompletion();
+        ~IoCompletion();
+    } IoCompletion;
+
+    // one ring shared by all threads, submitting and reaping happen under the ring lock while the wait for completions does not
+    // page writes are serialized into registered buffers so the kernel does not map the pages on every write
+    class IoUringIoBackend final : public IoBackend {
+        int ringFileDescriptor;
+        uint32_t ringEntries;
+        uint32_t inFlight;
+        uint32_t pendingSubmissions;
+        bool isReaping;
+        mutex ringMutex;
+        condition_variable ringCondition;
+
+        void *submissionRing;
+        size_t submissionRingSize;
+        uint32_t *submissionTail;
+        uint32_t *submissionMask;
+        uint32_t *submissionArray;
+        io_uring_sqe *submissionEntries;
+        size_t submissionEntriesSize;
+
+        void *completionRing;
+        size_t completionRingSize;
+        uint32_t *completionHead;
+        uint32_t *completionTail;
+        uint32_t *completionMask;
+        io_uring_cqe *completionEntries;
+
+        char *writeBuffers;
+        vector<int> freeWriteBuffers;
+        bool areWriteBuffersRegistered;
+
+        unordered_map<string, PositionalFile *> files;
+        mutex filesMutex;
+
+    protected:
+        int GetFileDescriptor(const string &filename);
+        io_uring_sqe *GetSubmissionEntry();
+        // returns how many of the pending entries the kernel took, the rest are withdrawn from the ring and submitError is set
+        [[nodiscard]] uint32_t SubmitEntries(int &submitError);
+        void ReapCompletions();
+        void WaitForCompletions(const vector<IoCompletion *> &completions);
+        void ReleaseRing();
+        streamsize SubmitRead(const int &fileDescriptor, const uint8_t &opcode, const uint64_t &address, const uint32_t &length, const uint64_t &offset);
+
+    public:
+        IoUringIoBackend();
+        IoUringIoBackend(const IoUringIoBackend &other) = delete;
+        ~IoUringIoBackend() override;
+
+        streamsize Read(const string &filename, const streamoff &offset, char *buffer, const size_t &size) override;
+        streamsize ReadPages(const string &filename, const page_id_t &firstPageId, vector<vector<char>> &pageBuffers) override;
+        void WritePages(const vector<Pages::Page *> &pages) override;
+
+        [[nodiscard]] IoBackendType GetType() const override;
+    };
+}
+#endif
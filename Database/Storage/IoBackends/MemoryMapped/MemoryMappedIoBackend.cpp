@@ -0,0 +1,78 @@
+#include "MemoryMappedIoBackend.h"
+#include <cstring>
+#include <stdexcept>
+#include "../../MappedFile/MappedFile.h"
+
+namespace Storage {
+    MemoryMappedIoBackend::MemoryMappedIoBackend() = default;
+
+    MemoryMappedIoBackend::~MemoryMappedIoBackend()
+    {
+        for (const auto &[filename, file] : this->files)
+            delete file;
+    }
+
+    MappedFile *MemoryMappedIoBackend::GetFile(const string &filename)
+    {
+        {
+            shared_lock lock(this->filesMutex);
+
+            const auto &fileIterator = this->files.find(filename);
+
+            if (fileIterator != this->files.end())
+                return fileIterator->second;
+        }
+
+        lock_guard lock(this->filesMutex);
+
+        const auto &fileIterator = this->files.find(filename);
+
+        if (fileIterator != this->files.end())
+            return fileIterator->second;
+
+        MappedFile *file = new MappedFile(filename);
+
+        this->files[filename] = file;
+
+        return file;
+    }
+
+    streamsize MemoryMappedIoBackend::Read(const string &filename, const streamoff &offset, char *buffer, const size_t &size)
+    {
+        const span<const char> range = this->GetFile(filename)->GetRange(offset, size);
+
+        if (!range.empty())
+            memcpy(buffer, range.data(), range.size());
+
+        return static_cast<streamsize>(range.size());
+    }
+
+    bool MemoryMappedIoBackend::AcquirePages(const string &filename, const page_id_t &firstPageId, const size_t &pageCount, const AccessPattern &accessPattern, vector<span<const char>> &pages)
+    {
+        const MappedFile *file = this->GetFile(filename);
+        const streamoff firstPageOffset = GetPageOffset(firstPageId);
+
+        // every page of the range is parsed right away, so it is read ahead as a whole instead of faulting page by page
+        if (accessPattern == AccessPattern::SEQUENTIAL)
+            file->WillNeed(firstPageOffset, pageCount * PAGE_SIZE);
+
+        for (size_t i = 0; i < pageCount; i++)
+        {
+            const span<const char> page = file->GetRange(firstPageOffset + static_cast<streamoff>(i * PAGE_SIZE), PAGE_SIZE);
+
+            if (page.empty())
+                break;
+
+            pages.push_back(page);
+        }
+
+        return true;
+    }
+
+    void MemoryMappedIoBackend::WritePages(const vector<Pages::Page *> &pages)
+    {
+        throw runtime_error("MemoryMappedIoBackend::WritePages: Memory mapped databases are read only");
+    }
+
+    IoBackendType MemoryMappedIoBackend::GetType() const { return IoBackendType::MEMORY_MAPPED; }
+}
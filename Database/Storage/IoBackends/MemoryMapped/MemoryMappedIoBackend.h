@@ -0,0 +1,28 @@
+#pragma once
+#include <shared_mutex>
+#include <unordered_map>
+#include "../IoBackend.h"
+
+namespace Storage {
+    class MappedFile;
+
+    // serves pages of read only databases straight out of a mapping of the file, writing through it is an error
+    class MemoryMappedIoBackend final : public IoBackend {
+        unordered_map<string, MappedFile *> files;
+        shared_mutex filesMutex;
+
+    protected:
+        MappedFile *GetFile(const string &filename);
+
+    public:
+        MemoryMappedIoBackend();
+        MemoryMappedIoBackend(const MemoryMappedIoBackend &other) = delete;
+        ~MemoryMappedIoBackend() override;
+
+        streamsize Read(const string &filename, const streamoff &offset, char *buffer, const size_t &size) override;
+        bool AcquirePages(const string &filename, const page_id_t &firstPageId, const size_t &pageCount, const AccessPattern &accessPattern, vector<span<const char>> &pages) override;
+        void WritePages(const vector<Pages::Page *> &pages) override;
+
+        [[nodiscard]] IoBackendType GetType() const override;
+    };
+}
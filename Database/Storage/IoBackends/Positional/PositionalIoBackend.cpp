@@ -0,0 +1,70 @@
+#include "PositionalIoBackend.h"
+#include "../../PositionalFile/PositionalFile.h"
+#include "../../../Pages/Page.h"
+
+namespace Storage {
+    PositionalIoBackend::PositionalIoBackend() = default;
+
+    PositionalIoBackend::~PositionalIoBackend()
+    {
+        for (const auto &[filename, file] : this->files)
+            delete file;
+    }
+
+    PositionalFile *PositionalIoBackend::GetFile(const string &filename)
+    {
+        {
+            shared_lock lock(this->filesMutex);
+
+            const auto &fileIterator = this->files.find(filename);
+
+            if (fileIterator != this->files.end())
+                return fileIterator->second;
+        }
+
+        lock_guard lock(this->filesMutex);
+
+        const auto &fileIterator = this->files.find(filename);
+
+        if (fileIterator != this->files.end())
+            return fileIterator->second;
+
+        PositionalFile *file = new PositionalFile(filename);
+
+        this->files[filename] = file;
+
+        return file;
+    }
+
+    streamsize PositionalIoBackend::Read(const string &filename, const streamoff &offset, char *buffer, const size_t &size)
+    {
+        return this->GetFile(filename)->ReadAt(buffer, size, offset);
+    }
+
+    streamsize PositionalIoBackend::ReadPages(const string &filename, const page_id_t &firstPageId, vector<vector<char>> &pageBuffers)
+    {
+        const vector<span<char>> buffers(pageBuffers.begin(), pageBuffers.end());
+
+        return this->GetFile(filename)->ReadScatteredAt(buffers, GetPageOffset(firstPageId));
+    }
+
+    void PositionalIoBackend::WritePages(const vector<Pages::Page *> &pages)
+    {
+        vector<vector<Pages::Page *>> pageRuns;
+
+        IoBackend::GetPageRuns(pages, pageRuns);
+
+        vector<char> buffer(WRITE_COALESCE_PAGES * PAGE_SIZE);
+
+        // a run is serialized back to back, so it needs a single pwrite
+        for (const auto &pageRun : pageRuns)
+        {
+            for (size_t i = 0; i < pageRun.size(); i++)
+                IoBackend::SerializePage(pageRun[i], buffer.data() + i * PAGE_SIZE);
+
+            this->GetFile(pageRun[0]->GetFileName())->WriteAt(buffer.data(), pageRun.size() * PAGE_SIZE, GetPageOffset(pageRun[0]->GetPageId()));
+        }
+    }
+
+    IoBackendType PositionalIoBackend::GetType() const { return IoBackendType::POSITIONAL; }
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <shared_mutex>
+#include <unordered_map>
+#include "../IoBackend.h"
+
+namespace Storage {
+    class PositionalFile;
+
+    // pread/pwrite on descriptors opened once per file, calls share no file position so they run in parallel without a lock
+    class PositionalIoBackend final : public IoBackend {
+        unordered_map<string, PositionalFile *> files;
+        shared_mutex filesMutex;
+
+    protected:
+        PositionalFile *GetFile(const string &filename);
+
+    public:
+        PositionalIoBackend();
+        PositionalIoBackend(const PositionalIoBackend &other) = delete;
+        ~PositionalIoBackend() override;
+
+        streamsize Read(const string &filename, const streamoff &offset, char *buffer, const size_t &size) override;
+        streamsize ReadPages(const string &filename, const page_id_t &firstPageId, vector<vector<char>> &pageBuffers) override;
+        void WritePages(const vector<Pages::Page *> &pages) override;
+
+        [[nodiscard]] IoBackendType GetType() const override;
+    };
+}
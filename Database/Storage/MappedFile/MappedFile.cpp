@@ -0,0 +1,162 @@
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Storage {
+#ifdef _WIN32
+    MappedFile::MappedFile(const string &filename)
+    {
+        this->filename = filename;
+        this->mapping = nullptr;
+        this->mappingHandle = nullptr;
+        this->size = 0;
+
+        this->fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (this->fileHandle == INVALID_HANDLE_VALUE)
+            throw runtime_error("File could not be opened");
+
+        LARGE_INTEGER fileSize;
+
+        if (!GetFileSizeEx(this->fileHandle, &fileSize))
+        {
+            CloseHandle(this->fileHandle);
+            throw runtime_error("MappedFile::MappedFile: Could not read the size of " + filename);
+        }
+
+        this->size = static_cast<size_t>(fileSize.QuadPart);
+
+        // empty files cannot be mapped, every range of them is empty
+        if (this->size == 0)
+            return;
+
+        this->mappingHandle = CreateFileMappingA(this->fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (this->mappingHandle != nullptr)
+            this->mapping = static_cast<const char *>(MapViewOfFile(this->mappingHandle, FILE_MAP_READ, 0, 0, 0));
+
+        if (this->mapping == nullptr)
+        {
+            if (this->mappingHandle != nullptr)
+                CloseHandle(this->mappingHandle);
+
+            CloseHandle(this->fileHandle);
+            throw runtime_error("MappedFile::MappedFile: Could not map " + filename);
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (this->mapping != nullptr)
+            UnmapViewOfFile(this->mapping);
+
+        if (this->mappingHandle != nullptr)
+            CloseHandle(this->mappingHandle);
+
+        CloseHandle(this->fileHandle);
+    }
+
+    void MappedFile::WillNeed(const streamoff &offset, const size_t &size) const
+    {
+        const span<const char> range = this->GetRange(offset, size);
+
+        if (range.empty())
+            return;
+
+        WIN32_MEMORY_RANGE_ENTRY rangeEntry;
+        rangeEntry.VirtualAddress = const_cast<char *>(range.data());
+        rangeEntry.NumberOfBytes = range.size();
+
+        // only a hint, older systems without it read the pages on first touch
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &rangeEntry, 0);
+    }
+#else
+    MappedFile::MappedFile(const string &filename)
+    {
+        this->filename = filename;
+        this->mapping = nullptr;
+        this->size = 0;
+
+        const int fileDescriptor = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fileDescriptor < 0)
+            throw runtime_error("File could not be opened");
+
+        struct stat fileStatus;
+
+        if (fstat(fileDescriptor, &fileStatus) < 0)
+        {
+            close(fileDescriptor);
+            throw runtime_error("MappedFile::MappedFile: Could not read the size of " + filename + ": " + strerror(errno));
+        }
+
+        this->size = static_cast<size_t>(fileStatus.st_size);
+
+        // empty files cannot be mapped, every range of them is empty
+        if (this->size == 0)
+        {
+            close(fileDescriptor);
+            return;
+        }
+
+        void *mapping = mmap(nullptr, this->size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+
+        // the mapping keeps its own reference to the file
+        close(fileDescriptor);
+
+        if (mapping == MAP_FAILED)
+            throw runtime_error("MappedFile::MappedFile: Could not map " + filename + ": " + strerror(errno));
+
+        madvise(mapping, this->size, MADV_RANDOM);
+
+        this->mapping = static_cast<const char *>(mapping);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (this->mapping != nullptr)
+            munmap(const_cast<char *>(this->mapping), this->size);
+    }
+
+    void MappedFile::WillNeed(const streamoff &offset, const size_t &size) const
+    {
+        const span<const char> range = this->GetRange(offset, size);
+
+        if (range.empty())
+            return;
+
+        // madvise wants a page aligned start
+        static const uintptr_t systemPageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const uintptr_t rangeStart = reinterpret_cast<uintptr_t>(range.data());
+        const uintptr_t alignedStart = rangeStart & ~(systemPageSize - 1);
+
+        madvise(reinterpret_cast<void *>(alignedStart), range.size() + (rangeStart - alignedStart), MADV_WILLNEED);
+    }
+#endif
+
+    span<const char> MappedFile::GetRange(const streamoff &offset, const size_t &size) const
+    {
+        if (offset < 0 || static_cast<size_t>(offset) >= this->size)
+            return {};
+
+        return { this->mapping + offset, min(size, this->size - static_cast<size_t>(offset)) };
+    }
+
+    size_t MappedFile::GetSize() const { return this->size; }
+
+    const string &MappedFile::GetFileName() const { return this->filename; }
+}
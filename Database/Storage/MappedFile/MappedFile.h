@@ -0,0 +1,35 @@
+#pragma once
+#include <ios>
+#include <span>
+#include <string>
+
+namespace Storage {
+    using namespace std;
+
+    // database file mapped read only into the address space, pages are parsed straight out of the mapping
+    // the whole mapping is advised as random access so index probes do not drag neighbouring pages in
+    class MappedFile final {
+#ifdef _WIN32
+        void *fileHandle;
+        void *mappingHandle;
+#endif
+        const char *mapping;
+        size_t size;
+        string filename;
+
+    public:
+        explicit MappedFile(const string &filename);
+        MappedFile(const MappedFile &other) = delete;
+        ~MappedFile();
+
+        // the range is clamped to the end of the file, so it is shorter or empty past it
+        [[nodiscard]] span<const char> GetRange(const streamoff &offset, const size_t &size) const;
+
+        // asks the kernel to start reading the range in the background, ranges are hinted one by one
+        // instead of advising them as sequential which would split the mapping in the kernel
+        void WillNeed(const streamoff &offset, const size_t &size) const;
+
+        [[nodiscard]] size_t GetSize() const;
+        [[nodiscard]] const string &GetFileName() const;
+    };
+}
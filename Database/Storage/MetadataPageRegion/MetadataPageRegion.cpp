@@ -0,0 +1,153 @@
+#include "MetadataPageRegion.h"
+#include "../../Pages/Page.h"
+
+using namespace Pages;
+
+namespace Storage {
+    MetadataPageTable::MetadataPageTable(const size_t &capacity)
+    {
+        this->capacity = capacity;
+        this->pageIds = make_unique<atomic<page_id_t>[]>(capacity);
+        this->pages = make_unique<atomic<Page *>[]>(capacity);
+    }
+
+    MetadataPageTable::~MetadataPageTable() = default;
+
+    MetadataPageRegion::MetadataPageRegion()
+    {
+        this->table = new MetadataPageTable(METADATA_REGION_SLOTS);
+        this->size = 0;
+    }
+
+    MetadataPageRegion::~MetadataPageRegion()
+    {
+        MetadataPageTable *table = this->table.load();
+
+        for (size_t i = 0; i < table->capacity; i++)
+            delete table->pages[i].load();
+
+        delete table;
+
+        for (const auto &retiredTable : this->retiredTables)
+            delete retiredTable;
+    }
+
+    size_t MetadataPageRegion::GetSlot(const page_id_t &pageId, const size_t &capacity)
+    {
+        // fibonacci hashing like the buffer pool shards, capacities are powers of two
+        const uint64_t hash = static_cast<uint64_t>(pageId) * 11400714819323198485ull;
+
+        return (hash >> 32) & (capacity - 1);
+    }
+
+    Page *MetadataPageRegion::FindPage(const MetadataPageTable *table, const page_id_t &pageId)
+    {
+        // page 0 is the database header and never stored here, so it marks an empty slot
+        for (size_t slot = MetadataPageRegion::GetSlot(pageId, table->capacity); ; slot = (slot + 1) & (table->capacity - 1))
+        {
+            const page_id_t slotPageId = table->pageIds[slot].load(memory_order_acquire);
+
+            if (slotPageId == pageId)
+                return table->pages[slot].load(memory_order_relaxed);
+
+            if (slotPageId == 0)
+                return nullptr;
+        }
+    }
+
+    void MetadataPageRegion::InsertPage(MetadataPageTable *table, Page *page)
+    {
+        size_t slot = MetadataPageRegion::GetSlot(page->GetPageId(), table->capacity);
+
+        while (table->pageIds[slot].load(memory_order_relaxed) != 0)
+            slot = (slot + 1) & (table->capacity - 1);
+
+        table->pages[slot].store(page, memory_order_relaxed);
+        table->pageIds[slot].store(page->GetPageId(), memory_order_release);
+    }
+
+    Page *MetadataPageRegion::FindPage(const page_id_t &pageId) const
+    {
+        return MetadataPageRegion::FindPage(this->table.load(memory_order_acquire), pageId);
+    }
+
+    Page *MetadataPageRegion::InsertPage(Page *page)
+    {
+        lock_guard lock(this->regionMutex);
+
+        MetadataPageTable *table = this->table.load(memory_order_relaxed);
+
+        Page *residentPage = MetadataPageRegion::FindPage(table, page->GetPageId());
+
+        if (residentPage != nullptr)
+        {
+            if (residentPage != page)
+                delete page;
+
+            return residentPage;
+        }
+
+        // kept at most half full so probes stay short and always end on an empty slot
+        if ((this->size + 1) * 2 > table->capacity)
+        {
+            MetadataPageTable *grownTable = new MetadataPageTable(table->capacity * 2);
+
+            for (size_t i = 0; i < table->capacity; i++)
+            {
+                if (table->pageIds[i].load(memory_order_relaxed) != 0)
+                    MetadataPageRegion::InsertPage(grownTable, table->pages[i].load(memory_order_relaxed));
+            }
+
+            this->table.store(grownTable, memory_order_release);
+            this->retiredTables.push_back(table);
+
+            table = grownTable;
+        }
+
+        MetadataPageRegion::InsertPage(table, page);
+        this->size++;
+
+        return page;
+    }
+
+    void MetadataPageRegion::ForEachPage(const function<void(Page *)> &pageVisitor) const
+    {
+        lock_guard lock(this->regionMutex);
+
+        const MetadataPageTable *table = this->table.load(memory_order_relaxed);
+
+        for (size_t i = 0; i < table->capacity; i++)
+        {
+            if (table->pageIds[i].load(memory_order_relaxed) != 0)
+                pageVisitor(table->pages[i].load(memory_order_relaxed));
+        }
+    }
+
+    void MetadataPageRegion::Clear(const function<void(Page *)> &evictionHandler)
+    {
+        lock_guard lock(this->regionMutex);
+
+        MetadataPageTable *table = this->table.load(memory_order_relaxed);
+
+        // only called at shutdown, nothing reads the region anymore
+        for (size_t i = 0; i < table->capacity; i++)
+        {
+            if (table->pageIds[i].load(memory_order_relaxed) == 0)
+                continue;
+
+            evictionHandler(table->pages[i].load(memory_order_relaxed));
+
+            table->pages[i].store(nullptr, memory_order_relaxed);
+            table->pageIds[i].store(0, memory_order_relaxed);
+        }
+
+        this->size = 0;
+    }
+
+    size_t MetadataPageRegion::GetSize() const
+    {
+        lock_guard lock(this->regionMutex);
+
+        return this->size;
+    }
+}
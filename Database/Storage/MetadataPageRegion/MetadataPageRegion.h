@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../../Constants.h"
+
+namespace Pages {
+    class Page;
+}
+
+using namespace Constants;
+
+namespace Storage {
+    using namespace std;
+
+    // open addressing table of page ids, a slot is published by storing its page before its id so readers need no lock
+    typedef struct MetadataPageTable {
+        unique_ptr<atomic<page_id_t>[]> pageIds;
+        unique_ptr<atomic<Pages::Page *>[]> pages;
+        size_t capacity;
+
+        explicit MetadataPageTable(const size_t &capacity);
+        ~MetadataPageTable();
+    } MetadataPageTable;
+
+    // PFS, GAM and IAM pages, loaded once and resident until the storage manager shuts down
+    // pages are only ever added, so lookups are lock free while insertions and growing the table take the region lock
+    class MetadataPageRegion final {
+        atomic<MetadataPageTable *> table;
+        // tables replaced by a larger one stay allocated until the region is destroyed, a reader may still be probing them
+        vector<MetadataPageTable *> retiredTables;
+        size_t size;
+        mutable mutex regionMutex;
+
+    protected:
+        static size_t GetSlot(const page_id_t &pageId, const size_t &capacity);
+        static Pages::Page *FindPage(const MetadataPageTable *table, const page_id_t &pageId);
+        static void InsertPage(MetadataPageTable *table, Pages::Page *page);
+
+    public:
+        MetadataPageRegion();
+        MetadataPageRegion(const MetadataPageRegion &other) = delete;
+        ~MetadataPageRegion();
+
+        [[nodiscard]] Pages::Page *FindPage(const page_id_t &pageId) const;
+
+        // returns the resident page, a page loaded again by another thread meanwhile is deleted
+        Pages::Page *InsertPage(Pages::Page *page);
+
+        // runs under the region lock, pages keep being modified by inserts while they are visited
+        void ForEachPage(const function<void(Pages::Page *)> &pageVisitor) const;
+
+        // hands every page to the handler, which takes ownership of it, and empties the region
+        void Clear(const function<void(Pages::Page *)> &evictionHandler);
+
+        [[nodiscard]] size_t GetSize() const;
+    };
+}
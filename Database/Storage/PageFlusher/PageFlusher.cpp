@@ -0,0 +1,135 @@
+#include "PageFlusher.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include "../BufferPool/BufferPool.h"
+
+using namespace Constants;
+
+namespace Storage {
+    PageFlusher::PageFlusher(const vector<BufferPool *> &pools, const function<void(const vector<Pages::Page *> &)> &pagesWriter)
+    {
+        this->pools = pools;
+        this->pagesWriter = pagesWriter;
+        this->isRunning = false;
+        this->epoch = 0;
+        this->flushIntervalMs = FLUSH_INTERVAL_MS;
+        this->flushDirtyRatio = FLUSH_DIRTY_RATIO;
+        this->maxDirtyRatio = MAX_DIRTY_RATIO;
+    }
+
+    PageFlusher::~PageFlusher()
+    {
+        this->Stop();
+    }
+
+    void PageFlusher::Start(const StorageSettings &settings)
+    {
+        if (settings.flushDirtyRatio < 0 || settings.maxDirtyRatio > 1 || settings.flushDirtyRatio > settings.maxDirtyRatio)
+            throw invalid_argument("PageFlusher::Start: Dirty ratios must satisfy 0 <= flushDirtyRatio <= maxDirtyRatio <= 1");
+
+        this->Stop();
+
+        if (!settings.isBackgroundFlushEnabled)
+            return;
+
+        this->flushIntervalMs = settings.flushIntervalMs;
+        this->flushDirtyRatio = settings.flushDirtyRatio;
+        this->maxDirtyRatio = settings.maxDirtyRatio;
+        this->isRunning = true;
+
+        this->flusherThread = thread([this] { this->Run(); });
+    }
+
+    void PageFlusher::Stop()
+    {
+        {
+            lock_guard lock(this->flusherMutex);
+
+            this->isRunning = false;
+        }
+
+        this->flusherCondition.notify_all();
+
+        if (this->flusherThread.joinable())
+            this->flusherThread.join();
+    }
+
+    bool PageFlusher::IsRunning()
+    {
+        lock_guard lock(this->flusherMutex);
+
+        return this->isRunning;
+    }
+
+    void PageFlusher::Run()
+    {
+        unique_lock lock(this->flusherMutex);
+
+        while (this->isRunning)
+        {
+            lock.unlock();
+
+            bool isBehind = false;
+
+            for (const auto &pool : this->pools)
+                isBehind |= this->FlushPool(pool);
+
+            lock.lock();
+
+            // too many dirty pages left, go for another batch straight away
+            if (isBehind)
+                continue;
+
+            this->flusherCondition.wait_for(lock, chrono::milliseconds(this->flushIntervalMs), [this] { return !this->isRunning; });
+        }
+    }
+
+    bool PageFlusher::FlushPool(BufferPool *pool)
+    {
+        vector<DirtyPageEntry> dirtyPages;
+
+        pool->CollectDirtyPages(dirtyPages, ++this->epoch);
+
+        const size_t capacity = pool->GetCapacity();
+        const auto dirtyPagesThreshold = static_cast<size_t>(static_cast<double>(capacity) * this->flushDirtyRatio);
+
+        if (dirtyPages.size() <= dirtyPagesThreshold)
+            return false;
+
+        const size_t dirtyPagesCount = dirtyPages.size();
+        const size_t pagesToFlush = min(dirtyPagesCount - dirtyPagesThreshold, FLUSH_BATCH_SIZE);
+
+        // oldest dirtied pages first
+        nth_element(dirtyPages.begin(), dirtyPages.begin() + (pagesToFlush - 1), dirtyPages.end(),
+                    [](const DirtyPageEntry &first, const DirtyPageEntry &second) { return first.dirtySince < second.dirtySince; });
+
+        dirtyPages.erase(dirtyPages.begin() + pagesToFlush, dirtyPages.end());
+
+        // write the batch in page order, runs of consecutive pages go out with one call
+        sort(dirtyPages.begin(), dirtyPages.end(),
+             [](const DirtyPageEntry &first, const DirtyPageEntry &second) { return first.pageId < second.pageId; });
+
+        size_t flushedPages = 0;
+        vector<page_id_t> pageRun;
+
+        for (size_t i = 0; i < dirtyPages.size(); i++)
+        {
+            pageRun.push_back(dirtyPages[i].pageId);
+
+            const bool isRunEnd = i + 1 == dirtyPages.size() || dirtyPages[i + 1].pageId != dirtyPages[i].pageId + 1 || pageRun.size() == WRITE_COALESCE_PAGES;
+
+            if (!isRunEnd)
+                continue;
+
+            flushedPages += pool->FlushPages(pageRun, this->pagesWriter);
+            pageRun.clear();
+        }
+
+        // pages that are pinned or already evicted cannot be flushed, do not spin on them
+        if (flushedPages == 0)
+            return false;
+
+        return dirtyPagesCount - flushedPages > static_cast<size_t>(static_cast<double>(capacity) * this->maxDirtyRatio);
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../../Constants.h"
+#include "../StorageSettings/StorageSettings.h"
+
+namespace Pages {
+    class Page;
+}
+
+namespace Storage {
+    using namespace std;
+
+    class BufferPool;
+
+    // background writer, wakes up every flush interval and writes the oldest dirty pages of each pool
+    // so that evictions on the query threads find clean victims and do not pay for the disk write
+    class PageFlusher final {
+        vector<BufferPool *> pools;
+        function<void(const vector<Pages::Page *> &)> pagesWriter;
+        thread flusherThread;
+        mutex flusherMutex;
+        condition_variable flusherCondition;
+        bool isRunning;
+        uint64_t epoch;
+        uint32_t flushIntervalMs;
+        double flushDirtyRatio;
+        double maxDirtyRatio;
+
+    protected:
+        void Run();
+        bool FlushPool(BufferPool *pool);
+
+    public:
+        PageFlusher(const vector<BufferPool *> &pools, const function<void(const vector<Pages::Page *> &)> &pagesWriter);
+        PageFlusher(const PageFlusher &other) = delete;
+        ~PageFlusher();
+
+        void Start(const StorageSettings &settings);
+        void Stop();
+
+        [[nodiscard]] bool IsRunning();
+    };
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include "../BufferPool/BufferPool.h"
+
+namespace Storage {
+    using namespace std;
+
+    // keeps the frame of a cached page pinned while the guard is alive so the buffer pool cannot evict and delete the page
+    // guards are move only, releasing (or destroying) the guard unpins the frame
+    template<typename T>
+    class PageGuard final {
+        T *page;
+        Frame *frame;
+
+    public:
+        PageGuard() : page(nullptr), frame(nullptr) { }
+
+        PageGuard(nullptr_t) : page(nullptr), frame(nullptr) { }
+
+        // takes over a pin already held on the frame
+        PageGuard(T *page, Frame *frame) : page(page), frame(frame) { }
+
+        PageGuard(const PageGuard &other) = delete;
+
+        PageGuard(PageGuard &&other) noexcept : page(other.page), frame(other.frame)
+        {
+            other.page = nullptr;
+            other.frame = nullptr;
+        }
+
+        ~PageGuard() { this->Release(); }
+
+        PageGuard &operator=(const PageGuard &other) = delete;
+
+        PageGuard &operator=(PageGuard &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            this->Release();
+
+            this->page = other.page;
+            this->frame = other.frame;
+
+            other.page = nullptr;
+            other.frame = nullptr;
+
+            return *this;
+        }
+
+        void Release()
+        {
+            if (this->frame != nullptr)
+                this->frame->pinCount.fetch_sub(1, memory_order_release);
+
+            this->page = nullptr;
+            this->frame = nullptr;
+        }
+
+        // moves the pin to a guard of a derived page type, the result is empty if the page is not a U
+        template<typename U>
+        PageGuard<U> Cast()
+        {
+            U *castedPage = dynamic_cast<U *>(this->page);
+
+            if (castedPage == nullptr)
+            {
+                this->Release();
+                return PageGuard<U>();
+            }
+
+            PageGuard<U> guard(castedPage, this->frame);
+
+            this->page = nullptr;
+            this->frame = nullptr;
+
+            return guard;
+        }
+
+        [[nodiscard]] T *Get() const { return this->page; }
+
+        T *operator->() const { return this->page; }
+
+        T &operator*() const { return *this->page; }
+
+        explicit operator bool() const { return this->page != nullptr; }
+
+        bool operator==(nullptr_t) const { return this->page == nullptr; }
+    };
+}
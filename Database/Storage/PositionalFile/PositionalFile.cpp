@@ -0,0 +1,313 @@
+#include "PositionalFile.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace Storage {
+#ifdef _WIN32
+    PositionalFile::PositionalFile(const string &filename, const bool &isDirect)
+    {
+        this->filename = filename;
+        this->isDirect = isDirect;
+
+        const DWORD flags = isDirect ? FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH : FILE_ATTRIBUTE_NORMAL;
+
+        this->fileHandle = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, flags, nullptr);
+
+        if (this->fileHandle == INVALID_HANDLE_VALUE)
+            throw runtime_error("File could not be opened");
+    }
+
+    PositionalFile::~PositionalFile()
+    {
+        CloseHandle(this->fileHandle);
+    }
+
+    streamsize PositionalFile::ReadAt(char *buffer, const size_t &size, const streamoff &offset) const
+    {
+        size_t bytesRead = 0;
+
+        while (bytesRead < size)
+        {
+            // an explicit offset makes the read independent of the handle's file pointer
+            OVERLAPPED overlapped = {};
+            const uint64_t readOffset = static_cast<uint64_t>(offset) + bytesRead;
+            overlapped.Offset = static_cast<DWORD>(readOffset & 0xFFFFFFFF);
+            overlapped.OffsetHigh = static_cast<DWORD>(readOffset >> 32);
+
+            DWORD chunkBytesRead = 0;
+
+            if (!ReadFile(this->fileHandle, buffer + bytesRead, static_cast<DWORD>(size - bytesRead), &chunkBytesRead, &overlapped))
+            {
+                if (GetLastError() == ERROR_HANDLE_EOF)
+                    break;
+
+                throw runtime_error("PositionalFile::ReadAt: Could not read " + this->filename);
+            }
+
+            if (chunkBytesRead == 0)
+                break;
+
+            bytesRead += chunkBytesRead;
+
+            // unbuffered reads come up short only at the end of the file, reading on from there would be unaligned
+            if (this->isDirect && bytesRead < size)
+                break;
+        }
+
+        return static_cast<streamsize>(bytesRead);
+    }
+
+    streamsize PositionalFile::ReadScatteredAt(const vector<span<char>> &buffers, const streamoff &offset) const
+    {
+        // ReadFileScatter needs unbuffered handles, so the buffers are read one by one
+        streamsize bytesRead = 0;
+
+        for (const auto &buffer : buffers)
+        {
+            const streamsize bufferBytesRead = this->ReadAt(buffer.data(), buffer.size(), offset + bytesRead);
+
+            bytesRead += bufferBytesRead;
+
+            if (bufferBytesRead < static_cast<streamsize>(buffer.size()))
+                break;
+        }
+
+        return bytesRead;
+    }
+
+    void PositionalFile::WriteAt(const char *buffer, const size_t &size, const streamoff &offset) const
+    {
+        size_t bytesWritten = 0;
+
+        while (bytesWritten < size)
+        {
+            OVERLAPPED overlapped = {};
+            const uint64_t writeOffset = static_cast<uint64_t>(offset) + bytesWritten;
+            overlapped.Offset = static_cast<DWORD>(writeOffset & 0xFFFFFFFF);
+            overlapped.OffsetHigh = static_cast<DWORD>(writeOffset >> 32);
+
+            DWORD chunkBytesWritten = 0;
+
+            if (!WriteFile(this->fileHandle, buffer + bytesWritten, static_cast<DWORD>(size - bytesWritten), &chunkBytesWritten, &overlapped))
+                throw runtime_error("PositionalFile::WriteAt: Could not write " + this->filename);
+
+            bytesWritten += chunkBytesWritten;
+        }
+    }
+
+    void PositionalFile::WriteGatheredAt(const vector<span<const char>> &buffers, const streamoff &offset) const
+    {
+        // WriteFileGather needs unbuffered handles as well, so the buffers are written one by one
+        streamoff bufferOffset = offset;
+
+        for (const auto &buffer : buffers)
+        {
+            this->WriteAt(buffer.data(), buffer.size(), bufferOffset);
+
+            bufferOffset += static_cast<streamoff>(buffer.size());
+        }
+    }
+#else
+    PositionalFile::PositionalFile(const string &filename, const bool &isDirect)
+    {
+        this->filename = filename;
+        this->isDirect = false;
+        this->fileDescriptor = -1;
+
+#ifdef O_DIRECT
+        if (isDirect)
+        {
+            this->fileDescriptor = open(filename.c_str(), O_RDWR | O_CLOEXEC | O_DIRECT);
+
+            // file systems without direct I/O (tmpfs) refuse the flag, their files go through the page cache
+            this->isDirect = this->fileDescriptor >= 0;
+        }
+#endif
+
+        if (this->fileDescriptor < 0)
+            this->fileDescriptor = open(filename.c_str(), O_RDWR | O_CLOEXEC);
+
+        if (this->fileDescriptor < 0)
+            throw runtime_error("File could not be opened");
+
+#if !defined(O_DIRECT) && defined(F_NOCACHE)
+        // macOS has no O_DIRECT, the file is kept out of the unified buffer cache instead
+        if (isDirect)
+            this->isDirect = fcntl(this->fileDescriptor, F_NOCACHE, 1) == 0;
+#endif
+    }
+
+    PositionalFile::~PositionalFile()
+    {
+        close(this->fileDescriptor);
+    }
+
+    streamsize PositionalFile::ReadAt(char *buffer, const size_t &size, const streamoff &offset) const
+    {
+        size_t bytesRead = 0;
+
+        while (bytesRead < size)
+        {
+            const ssize_t chunkBytesRead = pread(this->fileDescriptor, buffer + bytesRead, size - bytesRead, offset + static_cast<off_t>(bytesRead));
+
+            if (chunkBytesRead < 0 && errno == EINTR)
+                continue;
+
+            if (chunkBytesRead < 0)
+                throw runtime_error("PositionalFile::ReadAt: Could not read " + this->filename + ": " + strerror(errno));
+
+            // end of the file
+            if (chunkBytesRead == 0)
+                break;
+
+            bytesRead += static_cast<size_t>(chunkBytesRead);
+
+            // direct reads come up short only at the end of the file, reading on from there would be unaligned
+            if (this->isDirect && bytesRead < size)
+                break;
+        }
+
+        return static_cast<streamsize>(bytesRead);
+    }
+
+    streamsize PositionalFile::ReadScatteredAt(const vector<span<char>> &buffers, const streamoff &offset) const
+    {
+        vector<iovec> bufferVectors(buffers.size());
+
+        for (size_t i = 0; i < buffers.size(); i++)
+        {
+            bufferVectors[i].iov_base = buffers[i].data();
+            bufferVectors[i].iov_len = buffers[i].size();
+        }
+
+        size_t bytesRead = 0;
+        size_t vectorIndex = 0;
+
+        while (vectorIndex < bufferVectors.size())
+        {
+            const int vectorsCount = static_cast<int>(min(bufferVectors.size() - vectorIndex, static_cast<size_t>(IOV_MAX)));
+
+            const ssize_t chunkBytesRead = preadv(this->fileDescriptor, bufferVectors.data() + vectorIndex, vectorsCount, offset + static_cast<off_t>(bytesRead));
+
+            if (chunkBytesRead < 0 && errno == EINTR)
+                continue;
+
+            if (chunkBytesRead < 0)
+                throw runtime_error("PositionalFile::ReadScatteredAt: Could not read " + this->filename + ": " + strerror(errno));
+
+            if (chunkBytesRead == 0)
+                break;
+
+            bytesRead += static_cast<size_t>(chunkBytesRead);
+
+            size_t bytesRequested = 0;
+
+            for (int i = 0; i < vectorsCount; i++)
+                bytesRequested += bufferVectors[vectorIndex + i].iov_len;
+
+            // a short direct read is the end of the file
+            if (this->isDirect && static_cast<size_t>(chunkBytesRead) < bytesRequested)
+                break;
+
+            // skip the buffers the read filled and continue a partially filled one where it stopped
+            size_t bytesLeft = static_cast<size_t>(chunkBytesRead);
+
+            while (vectorIndex < bufferVectors.size() && bytesLeft >= bufferVectors[vectorIndex].iov_len)
+            {
+                bytesLeft -= bufferVectors[vectorIndex].iov_len;
+                vectorIndex++;
+            }
+
+            if (bytesLeft > 0)
+            {
+                bufferVectors[vectorIndex].iov_base = static_cast<char *>(bufferVectors[vectorIndex].iov_base) + bytesLeft;
+                bufferVectors[vectorIndex].iov_len -= bytesLeft;
+            }
+        }
+
+        return static_cast<streamsize>(bytesRead);
+    }
+
+    void PositionalFile::WriteAt(const char *buffer, const size_t &size, const streamoff &offset) const
+    {
+        size_t bytesWritten = 0;
+
+        while (bytesWritten < size)
+        {
+            const ssize_t chunkBytesWritten = pwrite(this->fileDescriptor, buffer + bytesWritten, size - bytesWritten, offset + static_cast<off_t>(bytesWritten));
+
+            if (chunkBytesWritten < 0 && errno == EINTR)
+                continue;
+
+            if (chunkBytesWritten < 0)
+                throw runtime_error("PositionalFile::WriteAt: Could not write " + this->filename + ": " + strerror(errno));
+
+            bytesWritten += static_cast<size_t>(chunkBytesWritten);
+        }
+    }
+
+    void PositionalFile::WriteGatheredAt(const vector<span<const char>> &buffers, const streamoff &offset) const
+    {
+        vector<iovec> bufferVectors(buffers.size());
+
+        for (size_t i = 0; i < buffers.size(); i++)
+        {
+            bufferVectors[i].iov_base = const_cast<char *>(buffers[i].data());
+            bufferVectors[i].iov_len = buffers[i].size();
+        }
+
+        size_t bytesWritten = 0;
+        size_t vectorIndex = 0;
+
+        while (vectorIndex < bufferVectors.size())
+        {
+            const int vectorsCount = static_cast<int>(min(bufferVectors.size() - vectorIndex, static_cast<size_t>(IOV_MAX)));
+
+            const ssize_t chunkBytesWritten = pwritev(this->fileDescriptor, bufferVectors.data() + vectorIndex, vectorsCount, offset + static_cast<off_t>(bytesWritten));
+
+            if (chunkBytesWritten < 0 && errno == EINTR)
+                continue;
+
+            if (chunkBytesWritten < 0)
+                throw runtime_error("PositionalFile::WriteGatheredAt: Could not write " + this->filename + ": " + strerror(errno));
+
+            bytesWritten += static_cast<size_t>(chunkBytesWritten);
+
+            // skip the buffers the write consumed and continue a partially written one where it stopped
+            size_t bytesLeft = static_cast<size_t>(chunkBytesWritten);
+
+            while (vectorIndex < bufferVectors.size() && bytesLeft >= bufferVectors[vectorIndex].iov_len)
+            {
+                bytesLeft -= bufferVectors[vectorIndex].iov_len;
+                vectorIndex++;
+            }
+
+            if (bytesLeft > 0)
+            {
+                bufferVectors[vectorIndex].iov_base = static_cast<char *>(bufferVectors[vectorIndex].iov_base) + bytesLeft;
+                bufferVectors[vectorIndex].iov_len -= bytesLeft;
+            }
+        }
+    }
+
+    int PositionalFile::GetFileDescriptor() const { return this->fileDescriptor; }
+#endif
+
+    const string &PositionalFile::GetFileName() const { return this->filename; }
+
+    bool PositionalFile::IsDirect() const { return this->isDirect; }
+}
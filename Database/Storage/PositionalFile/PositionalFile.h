@@ -0,0 +1,46 @@
+#pragma once
+#include <ios>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Storage {
+    using namespace std;
+
+    // database file opened for positional access, every read and write carries its own offset
+    // so threads reading different pages never share a seek pointer or a lock
+    class PositionalFile final {
+#ifdef _WIN32
+        void *fileHandle;
+#else
+        int fileDescriptor;
+#endif
+        string filename;
+        bool isDirect;
+
+    public:
+        // direct files bypass the page cache, their reads and writes have to start, end and sit in memory on DIRECT_IO_ALIGNMENT boundaries
+        explicit PositionalFile(const string &filename, const bool &isDirect = false);
+        PositionalFile(const PositionalFile &other) = delete;
+        ~PositionalFile();
+
+        // returns the number of bytes read, which is short only at the end of the file
+        streamsize ReadAt(char *buffer, const size_t &size, const streamoff &offset) const;
+
+        // fills the buffers one after the other from consecutive bytes of the file with a single call where the platform allows
+        streamsize ReadScatteredAt(const vector<span<char>> &buffers, const streamoff &offset) const;
+
+        void WriteAt(const char *buffer, const size_t &size, const streamoff &offset) const;
+
+        // writes the buffers one after the other to consecutive bytes of the file with a single call where the platform allows
+        void WriteGatheredAt(const vector<span<const char>> &buffers, const streamoff &offset) const;
+
+#ifndef _WIN32
+        [[nodiscard]] int GetFileDescriptor() const;
+#endif
+        [[nodiscard]] const string &GetFileName() const;
+
+        // false when direct I/O was asked for but the file system does not support it
+        [[nodiscard]] bool IsDirect() const;
+    };
+}
@@ -0,0 +1,70 @@
+#include "ClockReplacementPolicy.h"
+#include "../../BufferPool/BufferPool.h"
+
+namespace Storage {
+    ClockReplacementPolicy::ClockReplacementPolicy()
+    {
+        this->hand = 0;
+    }
+
+    ClockReplacementPolicy::~ClockReplacementPolicy() = default;
+
+    void ClockReplacementPolicy::RecordInsertion(Frame *frame)
+    {
+        // new frames start unreferenced so a page read once is the first one the hand reclaims
+        frame->isReferenced.store(false, memory_order_relaxed);
+
+        if (!this->freeSlots.empty())
+        {
+            frame->clockPosition = this->freeSlots.back();
+            this->freeSlots.pop_back();
+            this->ring[frame->clockPosition] = frame;
+
+            return;
+        }
+
+        frame->clockPosition = this->ring.size();
+        this->ring.push_back(frame);
+    }
+
+    void ClockReplacementPolicy::RecordAccess(Frame *frame)
+    {
+        frame->isReferenced.store(true, memory_order_relaxed);
+    }
+
+    void ClockReplacementPolicy::RecordRemoval(Frame *frame)
+    {
+        this->ring[frame->clockPosition] = nullptr;
+        this->freeSlots.push_back(frame->clockPosition);
+    }
+
+    Frame *ClockReplacementPolicy::SelectVictim()
+    {
+        if (this->freeSlots.size() == this->ring.size())
+            return nullptr;
+
+        // at most two sweeps, the first one may only clear reference bits
+        for (size_t i = 0; i < 2 * this->ring.size(); i++)
+        {
+            const size_t position = this->hand;
+
+            this->hand = (this->hand + 1) % this->ring.size();
+
+            Frame *frame = this->ring[position];
+
+            if (frame == nullptr || !ReplacementPolicy::IsEvictable(frame))
+                continue;
+
+            if (frame->isReferenced.exchange(false, memory_order_relaxed))
+                continue;
+
+            this->RecordRemoval(frame);
+
+            return frame;
+        }
+
+        return nullptr;
+    }
+
+    bool ClockReplacementPolicy::IsAccessLockFree() const { return true; }
+}
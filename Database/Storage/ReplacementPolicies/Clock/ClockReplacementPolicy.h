@@ -0,0 +1,24 @@
+#pragma once
+#include <vector>
+#include "../ReplacementPolicy.h"
+
+namespace Storage {
+    using namespace std;
+
+    // a hit only sets the frame's reference bit, the hand sweeps the ring clearing bits until it finds an unreferenced frame
+    class ClockReplacementPolicy final : public ReplacementPolicy {
+        vector<Frame *> ring;
+        vector<size_t> freeSlots;
+        size_t hand;
+
+    public:
+        ClockReplacementPolicy();
+        ~ClockReplacementPolicy() override;
+
+        void RecordInsertion(Frame *frame) override;
+        void RecordAccess(Frame *frame) override;
+        void RecordRemoval(Frame *frame) override;
+        [[nodiscard]] Frame *SelectVictim() override;
+        [[nodiscard]] bool IsAccessLockFree() const override;
+    };
+}
@@ -0,0 +1,43 @@
+#include "LruReplacementPolicy.h"
+#include "../../BufferPool/BufferPool.h"
+
+namespace Storage {
+    LruReplacementPolicy::LruReplacementPolicy() = default;
+
+    LruReplacementPolicy::~LruReplacementPolicy() = default;
+
+    void LruReplacementPolicy::RecordInsertion(Frame *frame)
+    {
+        this->frameList.push_front(frame);
+        frame->queuePosition = this->frameList.begin();
+    }
+
+    void LruReplacementPolicy::RecordAccess(Frame *frame)
+    {
+        this->frameList.splice(this->frameList.begin(), this->frameList, frame->queuePosition);
+    }
+
+    void LruReplacementPolicy::RecordRemoval(Frame *frame)
+    {
+        this->frameList.erase(frame->queuePosition);
+    }
+
+    Frame *LruReplacementPolicy::SelectVictim()
+    {
+        for (auto frameIterator = this->frameList.rbegin(); frameIterator != this->frameList.rend(); ++frameIterator)
+        {
+            Frame *frame = *frameIterator;
+
+            if (!ReplacementPolicy::IsEvictable(frame))
+                continue;
+
+            this->frameList.erase(frame->queuePosition);
+
+            return frame;
+        }
+
+        return nullptr;
+    }
+
+    bool LruReplacementPolicy::IsAccessLockFree() const { return false; }
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <list>
+#include "../ReplacementPolicy.h"
+
+namespace Storage {
+    using namespace std;
+
+    // every hit moves the frame to the head of the list, the tail is evicted
+    class LruReplacementPolicy final : public ReplacementPolicy {
+        list<Frame *> frameList;
+
+    public:
+        LruReplacementPolicy();
+        ~LruReplacementPolicy() override;
+
+        void RecordInsertion(Frame *frame) override;
+        void RecordAccess(Frame *frame) override;
+        void RecordRemoval(Frame *frame) override;
+        [[nodiscard]] Frame *SelectVictim() override;
+        [[nodiscard]] bool IsAccessLockFree() const override;
+    };
+}
@@ -0,0 +1,33 @@
+#include "ReplacementPolicy.h"
+#include <stdexcept>
+#include "Clock/ClockReplacementPolicy.h"
+#include "Lru/LruReplacementPolicy.h"
+#include "TwoQueue/TwoQueueReplacementPolicy.h"
+#include "../BufferPool/BufferPool.h"
+
+using namespace std;
+
+namespace Storage {
+    ReplacementPolicy::~ReplacementPolicy() = default;
+
+    bool ReplacementPolicy::IsEvictable(const Frame *frame) { return frame->pinCount.load(memory_order_acquire) == 0; }
+
+    void ReplacementPolicy::RestoreVictim(Frame *frame) { this->RecordInsertion(frame); }
+
+    void ReplacementPolicy::SetCapacity(const size_t &) { }
+
+    ReplacementPolicy *ReplacementPolicy::Create(const ReplacementPolicyType &policyType, const size_t &capacity)
+    {
+        switch (policyType)
+        {
+            case ReplacementPolicyType::LRU:
+                return new LruReplacementPolicy();
+            case ReplacementPolicyType::CLOCK:
+                return new ClockReplacementPolicy();
+            case ReplacementPolicyType::TWO_QUEUE:
+                return new TwoQueueReplacementPolicy(capacity);
+            default:
+                throw invalid_argument("ReplacementPolicy::Create: Unknown replacement policy");
+        }
+    }
+}
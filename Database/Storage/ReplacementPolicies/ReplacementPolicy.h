@@ -0,0 +1,35 @@
+#pragma once
+#include "../../Constants.h"
+
+using namespace Constants;
+
+namespace Storage {
+    struct Frame;
+
+    // replacement state of a single buffer pool shard, every call except RecordAccess happens under the exclusive shard latch
+    class ReplacementPolicy {
+    protected:
+        [[nodiscard]] static bool IsEvictable(const Frame *frame);
+
+    public:
+        virtual ~ReplacementPolicy();
+
+        virtual void RecordInsertion(Frame *frame) = 0;
+        virtual void RecordAccess(Frame *frame) = 0;
+        virtual void RecordRemoval(Frame *frame) = 0;
+
+        // picks the next unpinned frame to evict and stops tracking it, returns nullptr if no frame can be evicted
+        [[nodiscard]] virtual Frame *SelectVictim() = 0;
+
+        // takes back a victim whose eviction failed, by default it is tracked again as a newly inserted frame
+        virtual void RestoreVictim(Frame *frame);
+
+        // true if RecordAccess only touches the frame itself and can run under the shared shard latch
+        [[nodiscard]] virtual bool IsAccessLockFree() const = 0;
+
+        // called when the shard is resized, policies that size their queues by the shard capacity retune them
+        virtual void SetCapacity(const size_t &capacity);
+
+        static ReplacementPolicy *Create(const ReplacementPolicyType &policyType, const size_t &capacity);
+    };
+}
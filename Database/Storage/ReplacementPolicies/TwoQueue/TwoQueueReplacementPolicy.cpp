@@ -0,0 +1,149 @@
+#include "TwoQueueReplacementPolicy.h"
+#include "../../BufferPool/BufferPool.h"
+#include "../../../Pages/Page.h"
+
+namespace Storage {
+    enum TwoQueueId : uint8_t {
+        Probation = 0,
+        Protected = 1
+    };
+
+    TwoQueueReplacementPolicy::TwoQueueReplacementPolicy(const size_t &capacity)
+    {
+        this->SetCapacity(capacity);
+    }
+
+    TwoQueueReplacementPolicy::~TwoQueueReplacementPolicy() = default;
+
+    void TwoQueueReplacementPolicy::RecordInsertion(Frame *frame)
+    {
+        const page_id_t pageId = frame->page->GetPageId();
+
+        const auto &ghostIterator = this->ghostEntries.find(pageId);
+
+        if (ghostIterator != this->ghostEntries.end())
+        {
+            // the page came back after leaving probation, it is part of the working set
+            this->ghostQueue.erase(ghostIterator->second);
+            this->ghostEntries.erase(ghostIterator);
+
+            this->protectedQueue.push_front(frame);
+            frame->queuePosition = this->protectedQueue.begin();
+            frame->queueId = TwoQueueId::Protected;
+
+            return;
+        }
+
+        this->probationQueue.push_front(frame);
+        frame->queuePosition = this->probationQueue.begin();
+        frame->queueId = TwoQueueId::Probation;
+    }
+
+    void TwoQueueReplacementPolicy::RecordAccess(Frame *frame)
+    {
+        // probation is a FIFO, hits on it are most often the rest of the same scan or burst, they do not promote the page
+        // only a page requested again after leaving probation, a ghost hit on insertion, reaches the protected queue
+        if (frame->queueId != TwoQueueId::Protected)
+            return;
+
+        this->protectedQueue.splice(this->protectedQueue.begin(), this->protectedQueue, frame->queuePosition);
+    }
+
+    void TwoQueueReplacementPolicy::RecordRemoval(Frame *frame)
+    {
+        if (frame->queueId == TwoQueueId::Protected)
+            this->protectedQueue.erase(frame->queuePosition);
+        else
+            this->probationQueue.erase(frame->queuePosition);
+    }
+
+    Frame *TwoQueueReplacementPolicy::SelectVictim()
+    {
+        Frame *frame = nullptr;
+
+        if (this->probationQueue.size() >= this->probationCapacity || this->protectedQueue.empty())
+            frame = TwoQueueReplacementPolicy::FindVictim(this->probationQueue);
+
+        if (frame == nullptr)
+            frame = TwoQueueReplacementPolicy::FindVictim(this->protectedQueue);
+
+        // every protected frame is pinned, fall back to probation even below its share
+        if (frame == nullptr)
+            frame = TwoQueueReplacementPolicy::FindVictim(this->probationQueue);
+
+        if (frame == nullptr)
+            return nullptr;
+
+        this->RecordRemoval(frame);
+
+        if (frame->queueId == TwoQueueId::Probation)
+            this->RememberEvictedPage(frame->page->GetPageId());
+
+        return frame;
+    }
+
+    void TwoQueueReplacementPolicy::RestoreVictim(Frame *frame)
+    {
+        // the frame goes back to the queue it was taken from, a probation victim was never gone so it is no ghost either
+        if (frame->queueId == TwoQueueId::Protected)
+        {
+            this->protectedQueue.push_front(frame);
+            frame->queuePosition = this->protectedQueue.begin();
+
+            return;
+        }
+
+        const auto &ghostIterator = this->ghostEntries.find(frame->page->GetPageId());
+
+        if (ghostIterator != this->ghostEntries.end())
+        {
+            this->ghostQueue.erase(ghostIterator->second);
+            this->ghostEntries.erase(ghostIterator);
+        }
+
+        this->probationQueue.push_front(frame);
+        frame->queuePosition = this->probationQueue.begin();
+    }
+
+    Frame *TwoQueueReplacementPolicy::FindVictim(const list<Frame *> &queue)
+    {
+        for (auto frameIterator = queue.rbegin(); frameIterator != queue.rend(); ++frameIterator)
+        {
+            if (ReplacementPolicy::IsEvictable(*frameIterator))
+                return *frameIterator;
+        }
+
+        return nullptr;
+    }
+
+    void TwoQueueReplacementPolicy::RememberEvictedPage(const page_id_t &pageId)
+    {
+        if (this->ghostEntries.contains(pageId))
+            return;
+
+        if (this->ghostQueue.size() >= this->ghostCapacity)
+        {
+            this->ghostEntries.erase(this->ghostQueue.back());
+            this->ghostQueue.pop_back();
+        }
+
+        this->ghostQueue.push_front(pageId);
+        this->ghostEntries[pageId] = this->ghostQueue.begin();
+    }
+
+    bool TwoQueueReplacementPolicy::IsAccessLockFree() const { return false; }
+
+    void TwoQueueReplacementPolicy::SetCapacity(const size_t &capacity)
+    {
+        // the tuning suggested by the paper, a quarter of the frames on probation and ghosts for half of them
+        this->probationCapacity = (capacity / 4 == 0) ? 1 : capacity / 4;
+        this->ghostCapacity = (capacity / 2 == 0) ? 1 : capacity / 2;
+
+        // a shrinking shard forgets its oldest ghosts, frames on probation leave through the evictions of the shard
+        while (this->ghostQueue.size() > this->ghostCapacity)
+        {
+            this->ghostEntries.erase(this->ghostQueue.back());
+            this->ghostQueue.pop_back();
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <list>
+#include <unordered_map>
+#include "../ReplacementPolicy.h"
+
+namespace Storage {
+    using namespace std;
+
+    // 2Q (Johnson & Shasha), pages enter a FIFO probation queue and only reach the protected LRU queue once they are
+    // requested again shortly after leaving it, hits while still on probation do not count, so a sequential scan that
+    // reads every page of an extent, even more than once, only cycles through the probation queue and cannot flush the hot set
+    class TwoQueueReplacementPolicy final : public ReplacementPolicy {
+        list<Frame *> probationQueue;
+        list<Frame *> protectedQueue;
+        list<page_id_t> ghostQueue;
+        unordered_map<page_id_t, list<page_id_t>::iterator> ghostEntries;
+        size_t probationCapacity;
+        size_t ghostCapacity;
+
+        void RememberEvictedPage(const page_id_t &pageId);
+        static Frame *FindVictim(const list<Frame *> &queue);
+
+    public:
+        explicit TwoQueueReplacementPolicy(const size_t &capacity);
+        ~TwoQueueReplacementPolicy() override;
+
+        void RecordInsertion(Frame *frame) override;
+        void RecordAccess(Frame *frame) override;
+        void RecordRemoval(Frame *frame) override;
+        [[nodiscard]] Frame *SelectVictim() override;
+        void RestoreVictim(Frame *frame) override;
+        [[nodiscard]] bool IsAccessLockFree() const override;
+        void SetCapacity(const size_t &capacity) override;
+    };
+}
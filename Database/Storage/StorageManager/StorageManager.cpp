@@ -1,6 +1,8 @@
 #include "StorageManager.h"
+#include "../../../AdditionalLibraries/ThreadPool/ThreadPool.h"
 #include "../../Constants.h"
 #include "../../Database.h"
+#include "../../B+Tree/BPlusTree.h"
 #include "../../Pages/GlobalAllocationMap/GlobalAllocationMapPage.h"
 #include "../../Pages/Header/HeaderPage.h"
 #include "../../Pages/IndexMapAllocation/IndexAllocationMapPage.h"
@@ -15,27 +17,29 @@ using namespace Pages;
 
 namespace Storage {
 
-bool StorageManager::IsSystemCacheFull() const { return this->systemCache.size() == MAX_NUMBER_SYSTEM_PAGES; }
-
 StorageManager::StorageManager() 
+  : dataPool(StorageManager::GetPoolCapacity(DATA_POOL_BYTES), BUFFER_POOL_SHARDS, [this](Page *page, const vector<Page *> &neighbours) { this->RemovePage(page, neighbours); }),
+    systemPool(StorageManager::GetPoolCapacity(static_cast<size_t>(DATA_POOL_BYTES * SYSTEM_POOL_RATIO)), BUFFER_POOL_SHARDS, [this](Page *page, const vector<Page *> &neighbours) { this->RemovePage(page, neighbours); }),
+    pageFlusher({ &this->dataPool, &this->systemPool }, [this](const vector<Page *> &pages) { this->WritePagesToDisk(pages); }),
+    extentPrefetcher([this](const PrefetchRequest &request) { return this->HandlePrefetchRequest(request); })
 {
   this->database = nullptr;
-  this->cacheReaders = 0;
-  this->cacheWriters = 0;
-  this->dataReaders = 0;
-  this->dataWriters = 0;
+  this->isReadOnly = false;
+  this->ioBackend = IoBackend::Create(StorageSettings().ioBackend, &this->fileManager, &this->fileMutex);
 }
 
 StorageManager::~StorageManager() 
 {
-  const size_t pageListSize = this->pageList.size();
-  const size_t systemPageListSize = this->systemPageList.size();
+  this->extentPrefetcher.Stop();
+  this->pageFlusher.Stop();
 
-  for (size_t i = 0; i < pageListSize; i++)
-    this->RemovePage();
+  this->dataPool.Clear();
+  this->systemPool.Clear();
+  // dirty metadata pages go out in runs first, the region then only deletes them
+  this->FlushMetadataPages();
+  this->metadataRegion.Clear([this](Page *page) { this->RemovePage(page, {}); });
 
-  for (size_t i = 0; i < systemPageListSize; i++)
-    this->RemoveSystemPage();
+  delete this->ioBackend;
 }
 
 StorageManager& StorageManager::Get()
@@ -50,473 +54,637 @@ void StorageManager::BindDatabase(const Database *database)
   this->database = database;
 }
 
+void StorageManager::Configure(const StorageSettings &settings)
+{
+  this->dataPool.SetReplacementPolicy(settings.dataPagePolicy);
+  this->systemPool.SetReplacementPolicy(settings.systemPagePolicy);
+  this->ResizeBufferPools(settings.dataPoolBytes);
+
+  if (!settings.isReadOnly && settings.ioBackend == IoBackendType::MEMORY_MAPPED)
+    throw invalid_argument("StorageManager::Configure: Memory mapped databases have to be opened read only");
+
+  // read only databases are served straight out of a mapping of the file
+  const IoBackendType ioBackendType = settings.isReadOnly ? IoBackendType::MEMORY_MAPPED : settings.ioBackend;
+
+  if (this->ioBackend->GetType() != ioBackendType)
+  {
+    // the background threads are restarted below, nothing else does I/O while the database is being opened
+    this->extentPrefetcher.Stop();
+    this->pageFlusher.Stop();
+
+    delete this->ioBackend;
+
+    this->ioBackend = IoBackend::Create(ioBackendType, &this->fileManager, &this->fileMutex);
+  }
+
+  this->isReadOnly = settings.isReadOnly;
+
+  // nothing is written back from a read only database, so there is nothing to flush
+  if (this->isReadOnly)
+    this->pageFlusher.Stop();
+  else
+    this->pageFlusher.Start(settings);
+
+  this->extentPrefetcher.Start(settings);
+
+  // the pool is shared by every database of the process, the first one opened decides its size
+  Threading::ThreadPool::Get().Configure(settings.workerThreads);
+}
+
+void StorageManager::ResizeBufferPools(const size_t &dataPoolBytes)
+{
+  if (dataPoolBytes < PAGE_SIZE)
+    throw invalid_argument("StorageManager::ResizeBufferPools: The data pool must hold at least one page");
+
+  // pages are counted at PAGE_SIZE, the deserialized page objects are about as large as the page they were read from
+  this->dataPool.Resize(StorageManager::GetPoolCapacity(dataPoolBytes));
+  this->systemPool.Resize(StorageManager::GetPoolCapacity(static_cast<size_t>(static_cast<double>(dataPoolBytes) * SYSTEM_POOL_RATIO)));
+}
+
+size_t StorageManager::GetPoolCapacity(const size_t &poolBytes) { return poolBytes / PAGE_SIZE; }
+
+uint64_t StorageManager::GetElapsedMicroseconds(const chrono::steady_clock::time_point &start)
+{
+  return static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+}
+
 void StorageManager::CreateFile(const string& fileName, const string& extension)
 {
+  lock_guard lock(this->fileMutex);
+
   this->fileManager.CreateFile(fileName, extension);
 }
 
-Page *StorageManager::GetPage(const page_id_t &pageId, const extent_id_t &extentId,
-                           const Table *table) {
-  this->LockPageRead();
+PageGuard<Page> StorageManager::GetPage(const page_id_t &pageId, const extent_id_t &extentId, const Table *table) 
+{
+  Frame *frame = this->dataPool.PinPage(pageId);
 
-  auto pageHashIterator = this->cache.find(pageId);
+  const bool isHit = frame != nullptr;
+  const auto loadStart = chrono::steady_clock::now();
 
-  if (pageHashIterator == this->cache.end()) 
+  // under pressure the loaded page can be evicted again before it gets pinned, or be dropped because it was evicted while it was read,
+  // so the extent is read again
+  for (int attempt = 0; frame == nullptr && attempt < PAGE_LOAD_ATTEMPTS; attempt++)
   {
     this->OpenExtent(extentId, table);
-    pageHashIterator = this->cache.find(pageId);
-  }
-
-  // assign work to writer thread
 
-  this->pageList.push_front(*pageHashIterator->second);
-  this->pageList.erase(pageHashIterator->second);
-  this->cache[pageId] = this->pageList.begin();
+    // loading the page was its first reference, the replacement policy only hears about the next one
+    frame = this->dataPool.PinPage(pageId, false);
+  }
 
-  Page *page = *pageHashIterator->second;
+  if (frame == nullptr)
+    throw runtime_error("StorageManager::GetPage: Page " + to_string(pageId) + " could not be loaded");
 
-  this->UnlockPageRead();
+  if (isHit)
+    this->statistics.RecordHit(frame->page->GetPageType());
+  else
+    this->statistics.RecordMiss(frame->page->GetPageType(), StorageManager::GetElapsedMicroseconds(loadStart));
 
-  return page;
+  return PageGuard<Page>(frame->page, frame);
 }
 
-LargeDataPage *StorageManager::GetLargeDataPage(const page_id_t &pageId, const extent_id_t &extentId, const Table *table) 
+PageGuard<LargeDataPage> StorageManager::GetLargeDataPage(const page_id_t &pageId, const extent_id_t &extentId, const Table *table) 
 {
-  return dynamic_cast<LargeDataPage *>(this->GetPage(pageId, extentId, table));
+  return this->GetPage(pageId, extentId, table).Cast<LargeDataPage>();
 }
 
-Page *StorageManager::CreatePage(const page_id_t &pageId) 
+PageGuard<Page> StorageManager::CreatePage(const page_id_t &pageId) 
 {
   Page *page = new Page(pageId, true);
 
   const string &filename = this->database->GetFileName();
 
-  this->MovePageToFrontOfList(page, pageId, filename);
-
-  return page;
+  return this->InsertPinnedPageToPool(page, filename);
 }
 
-LargeDataPage *StorageManager::CreateLargeDataPage(const page_id_t &pageId) 
+PageGuard<LargeDataPage> StorageManager::CreateLargeDataPage(const page_id_t &pageId) 
 {
   LargeDataPage *page = new LargeDataPage(pageId, true);
 
   const string &filename = this->database->GetFileName();
 
-  this->MovePageToFrontOfList(page, pageId, filename);
-
-  return page;
+  return this->InsertPinnedPageToPool(page, filename).Cast<LargeDataPage>();
 }
 
-void StorageManager::RemovePage() 
+void StorageManager::RemovePage(Page *page, const vector<Page *> &neighbours) 
 {
-  Page *page = this->pageList.back();
-  const page_id_t pageId = page->GetPageId();
+  // pages already written by the background flusher are clean and evicted without touching the disk
+  // read only databases drop their changes, Database rejects anything that would make them
+  const bool isWriteBack = page->GetPageDirtyStatus() && !this->isReadOnly;
 
-  if (page->GetPageDirtyStatus()) 
+  // a failed write throws before the page is counted or released, the buffer pool keeps it
+  if (isWriteBack)
   {
-    const string &filename = page->GetFileName();
+    vector<Page *> pages = neighbours;
+    pages.push_back(page);
 
-    fstream *file = this->fileManager.GetFile(filename);
+    this->WritePagesToDisk(pages);
+  }
 
-    const streampos pageOffset = pageId * PAGE_SIZE;
+  this->statistics.RecordEviction(page->GetPageType(), isWriteBack);
 
-    SetWriteFilePointerToOffset(file, pageOffset);
+  delete page;
+}
 
-    page->WritePageToFile(file);
-  }
+void StorageManager::WritePagesToDisk(const vector<Page *> &pages)
+{
+  const auto writeStart = chrono::steady_clock::now();
 
-  this->cache.erase(pageId);
+  this->ioBackend->WritePages(pages);
 
-  this->pageList.pop_back();
+  // every page of the call waited for all of it
+  const uint64_t writeLatency = StorageManager::GetElapsedMicroseconds(writeStart);
 
-  delete page;
+  for (const auto &page : pages)
+    this->statistics.RecordWrite(page->GetPageType(), PAGE_SIZE, writeLatency);
 }
 
-void StorageManager::OpenExtent(const extent_id_t &extentId, const Table *table) 
+void StorageManager::ReadExtentFromFile(const extent_id_t &extentId, PageReadBuffer &readBuffer, page_id_t &firstExtentPageId)
 {
-  const string &filename = this->database->GetFileName();
+  firstExtentPageId = DatabaseEngine::Database::CalculateSystemPageOffsetByExtentId(extentId);
 
-  // read page from disk, call this->fileManager
-  fstream *file = this->fileManager.GetFile(filename);
+  // take into account the metadata page all the others
+  // every page of the extent is parsed, so the whole extent is read ahead
+  this->ReadPagesFromFile(this->database->GetFileName(), firstExtentPageId, EXTENT_SIZE, AccessPattern::SEQUENTIAL, readBuffer);
+}
 
-  const page_id_t firstExtentPageId = DatabaseEngine::Database::CalculateSystemPageOffsetByExtentId(extentId);
+void StorageManager::ReadPagesFromFile(const string &filename, const page_id_t &firstPageId, const size_t &pageCount, const AccessPattern &accessPattern, PageReadBuffer &readBuffer)
+{
+  // mapped files and direct I/O frames are parsed in place and handed back to the backend when the buffer goes out of scope
+  if (this->ioBackend->AcquirePages(filename, firstPageId, pageCount, accessPattern, readBuffer.pages))
+  {
+    readBuffer.owner = this->ioBackend;
+    return;
+  }
 
-  const streampos extentOffset = firstExtentPageId * PAGE_SIZE;
+  // scattered so each page is parsed from its own frame
+  readBuffer.buffers.assign(pageCount, vector<char>(PAGE_SIZE));
 
-  vector<char> buffer(EXTENT_BYTE_SIZE);
+  const streamsize bytesRead = this->ioBackend->ReadPages(filename, firstPageId, readBuffer.buffers);
 
-  SetReadFilePointerToOffset(file, extentOffset);
+  for (size_t i = 0; i < pageCount && static_cast<streamsize>(i * PAGE_SIZE) < bytesRead; i++)
+    readBuffer.pages.emplace_back(readBuffer.buffers[i].data(), PAGE_SIZE);
+}
 
-  // take into account the metadata page all the others
-  file->read(buffer.data(), EXTENT_BYTE_SIZE);
+void StorageManager::OpenExtent(const extent_id_t &extentId, const Table *table, const bool &isPrefetch) 
+{
+  const string &filename = this->database->GetFileName();
 
-  page_offset_t offSet = 0;
+  PageReadBuffer readBuffer;
+  page_id_t firstExtentPageId = DatabaseEngine::Database::CalculateSystemPageOffsetByExtentId(extentId);
 
-  const auto &bytesRead = file->gcount();
+  // the read is not latched, pages of the extent evicted while it runs are not replaced by what was read of them
+  const vector<uint64_t> loadTickets = this->dataPool.BeginPageLoads(firstExtentPageId, EXTENT_SIZE);
 
-  for (int i = 0; i < EXTENT_SIZE; i++) 
+  try
   {
-    offSet = i * PAGE_SIZE;
+    this->ReadExtentFromFile(extentId, readBuffer, firstExtentPageId);
 
-    if (bytesRead < offSet)
-      break;
+    page_offset_t offSet = 0;
 
-    const page_id_t currentPageId = firstExtentPageId + i;
+    for (size_t i = 0; i < readBuffer.pages.size(); i++) 
+    {
+      offSet = 0;
 
-    if (this->IsPageCached(currentPageId))
-      continue;
+      const span<const char> &buffer = readBuffer.pages[i];
 
-    if (this->pageList.size() == MAX_NUMBER_OF_PAGES)
-      this->RemovePage();
+      const page_id_t currentPageId = firstExtentPageId + i;
 
-    const PageHeader pageHeader = StorageManager::GetPageHeaderFromFile(buffer, offSet);
+      const PageHeader pageHeader = StorageManager::GetPageHeaderFromFile(buffer, offSet);
 
-    Page *page = nullptr;
+      // the whole extent came from disk, pages that were cached already included
+      this->statistics.RecordRead(pageHeader.pageType, PAGE_SIZE);
 
-    StorageManager::AllocateMemoryBasedOnPageType(&page, pageHeader);
+      if (this->IsPageCached(currentPageId))
+        continue;
 
-    page->GetPageDataFromFile(buffer, table, offSet, file);
+      Page *page = nullptr;
 
-    if(pageHeader.pageType == PageType::IAM)
-    {
-      this->systemPageList.push_front(page);
+      StorageManager::AllocateMemoryBasedOnPageType(&page, pageHeader);
 
-      this->systemCache[pageHeader.pageId] = this->systemPageList.begin();
-    }
-    else 
-    {
-      this->pageList.push_front(page);
+      page->GetPageDataFromFile(buffer, table, offSet, nullptr);
+      page->SetFileName(filename);
 
-      this->cache[page->GetPageId()] = this->pageList.begin();
+      if (StorageManager::IsMetadataPage(pageHeader.pageType))
+        this->InsertPageToMetadataRegion(page, filename);
+      else 
+        this->dataPool.InsertLoadedPage(page, loadTickets[i], isPrefetch);
     }
-    page->SetFileName(filename);
+  }
+  catch (...)
+  {
+    this->dataPool.EndPageLoads(firstExtentPageId, EXTENT_SIZE);
 
+    throw;
   }
+
+  this->dataPool.EndPageLoads(firstExtentPageId, EXTENT_SIZE);
 }
 
 ////////////////////////////////////////////////////
 ////////////////////System Pages///////////////////
 //////////////////////////////////////////////////
 
-HeaderPage *StorageManager::CreateHeaderPage(const string &filename) 
+PageGuard<HeaderPage> StorageManager::CreateHeaderPage(const string &filename) 
 {
   const page_id_t pageId = 0;
 
   HeaderPage *page = new HeaderPage(pageId);
 
-  this->MovePageToFrontOfSystemList(page, pageId, filename);
-
-  return page;
+  return this->InsertPinnedPageToSystemPool(page, filename).Cast<HeaderPage>();
 }
 
 GlobalAllocationMapPage *StorageManager::CreateGlobalAllocationMapPage(const string &filename, const page_id_t &pageId) 
 {
   GlobalAllocationMapPage *page = new GlobalAllocationMapPage(pageId);
 
-  this->MovePageToFrontOfSystemList(page, pageId, filename);
-
-  return page;
+  return dynamic_cast<GlobalAllocationMapPage *>(this->InsertPageToMetadataRegion(page, filename));
 }
 
 GlobalAllocationMapPage *StorageManager::CreateGlobalAllocationMapPage(const page_id_t &pageId) 
 {
   GlobalAllocationMapPage *page = new GlobalAllocationMapPage(pageId);
 
-  const string &filename = this->database->GetFileName();
-
-  this->MovePageToFrontOfSystemList(page, pageId, filename);
-
-  return page;
+  return dynamic_cast<GlobalAllocationMapPage *>(this->InsertPageToMetadataRegion(page, this->database->GetFileName()));
 }
 
 IndexAllocationMapPage *StorageManager::CreateIndexAllocationMapPage(const table_id_t &tableId, const page_id_t &pageId, const extent_id_t &startingExtentId) 
 {
   IndexAllocationMapPage *page = new IndexAllocationMapPage(tableId, pageId, startingExtentId);
 
-  const string &filename = this->database->GetFileName();
-
-  this->MovePageToFrontOfSystemList(page, pageId, filename);
-
-  return page;
+  return dynamic_cast<IndexAllocationMapPage *>(this->InsertPageToMetadataRegion(page, this->database->GetFileName()));
 }
 
 PageFreeSpacePage *StorageManager::CreatePageFreeSpacePage(const page_id_t &pageId) 
 {
   PageFreeSpacePage *page = new PageFreeSpacePage(pageId);
 
-  const string &filename = this->database->GetFileName();
-
-  this->MovePageToFrontOfSystemList(page, pageId, filename);
-
-  return page;
+  return dynamic_cast<PageFreeSpacePage *>(this->InsertPageToMetadataRegion(page, this->database->GetFileName()));
 }
 
 PageFreeSpacePage *StorageManager::CreatePageFreeSpacePage(const string &filename, const page_id_t &pageId) 
 {
   PageFreeSpacePage *page = new PageFreeSpacePage(pageId);
 
-  this->MovePageToFrontOfSystemList(page, pageId, filename);
-
-  return page;
+  return dynamic_cast<PageFreeSpacePage *>(this->InsertPageToMetadataRegion(page, filename));
 }
 
-IndexPage *StorageManager::CreateIndexPage(const page_id_t &pageId) 
+PageGuard<IndexPage> StorageManager::CreateIndexPage(const page_id_t &pageId) 
 {
   IndexPage *page = new IndexPage(pageId, true);
 
-  this->MovePageToFrontOfSystemList(page, pageId);
-
-  return page;
+  return this->InsertPinnedPageToSystemPool(page, this->database->GetFileName()).Cast<IndexPage>();
 }
 
-HeaderPage *StorageManager::GetHeaderPage(const string &filename) 
+PageGuard<HeaderPage> StorageManager::GetHeaderPage(const string &filename) 
 {
   constexpr page_id_t pageId = 0;
 
-  HeaderPage *page =
-      dynamic_cast<HeaderPage *>(this->GetSystemPage(pageId, filename));
-  return page;
+  return this->PinSystemPage(pageId, filename).Cast<HeaderPage>();
 }
 
 PageFreeSpacePage *StorageManager::GetPageFreeSpacePage(const page_id_t &pageId) 
 {
-  return dynamic_cast<PageFreeSpacePage *>(this->GetSystemPage(pageId));
+  return dynamic_cast<PageFreeSpacePage *>(this->GetMetadataPage(pageId));
 }
 
-IndexPage *StorageManager::GetIndexPage(const page_id_t &pageId) 
+PageGuard<IndexPage> StorageManager::GetIndexPage(const page_id_t &pageId) 
 {
-  return dynamic_cast<IndexPage *>(this->GetSystemPage(pageId));
+  return this->PinSystemPage(pageId, this->database->GetFileName()).Cast<IndexPage>();
 }
 
-IndexPage *StorageManager::GetIndexPage(const page_id_t &pageId, const extent_id_t &extentId, const Table* table) 
+PageGuard<IndexPage> StorageManager::GetIndexPage(const page_id_t &pageId, const extent_id_t &extentId, const Table* table) 
 {
-  return dynamic_cast<IndexPage *>(this->GetSystemPage(pageId, extentId, table));
+  return this->PinSystemPage(pageId, extentId, table).Cast<IndexPage>();
 }
 
 bool StorageManager::IsCacheFull() const 
 {
-  return this->pageList.size() == MAX_NUMBER_OF_PAGES;
+  return this->dataPool.GetSize() >= this->dataPool.GetCapacity();
 }
 
-IndexAllocationMapPage *StorageManager::GetIndexAllocationMapPage(const page_id_t &pageId) 
-{
-  return dynamic_cast<IndexAllocationMapPage *>(this->GetSystemPage(pageId));
-}
+size_t StorageManager::GetNumberOfShards() const { return this->dataPool.GetNumberOfShards(); }
 
-GlobalAllocationMapPage *StorageManager::GetGlobalAllocationMapPage(const page_id_t &pageId) 
+size_t StorageManager::GetDataPoolBytes() const { return this->dataPool.GetCapacity() * PAGE_SIZE; }
+
+size_t StorageManager::GetSystemPoolBytes() const { return this->systemPool.GetCapacity() * PAGE_SIZE; }
+
+IoBackendType StorageManager::GetIoBackendType() const { return this->ioBackend->GetType(); }
+
+bool StorageManager::IsReadOnly() const { return this->isReadOnly; }
+
+void StorageManager::PrefetchExtents(const vector<extent_id_t> &extentIds, const size_t &startIndex, const Table *table)
 {
-  return dynamic_cast<GlobalAllocationMapPage *>(this->GetSystemPage(pageId));
+  const size_t prefetchDepth = this->extentPrefetcher.GetPrefetchDepth();
+
+  for (size_t i = startIndex; i < extentIds.size() && i < startIndex + prefetchDepth; i++)
+    this->extentPrefetcher.Enqueue(PrefetchRequest(extentIds[i], table));
 }
 
-Page *StorageManager::GetSystemPage(const page_id_t &pageId) 
+void StorageManager::PrefetchIndexLeaves(const page_id_t &leafPageId, const page_offset_t &leafIndexPosition, const Table *table)
 {
-  this->LockSystemPageWrite();
+  const size_t prefetchDepth = this->extentPrefetcher.GetPrefetchDepth();
 
-  auto pageHashIterator = this->systemCache.find(pageId);
-  const string &filename = this->database->GetFileName();
+  if (prefetchDepth == 0 || leafPageId == 0)
+    return;
 
-  if (pageHashIterator == this->systemCache.end()) 
-  {
-    this->OpenSystemPage(pageId);
-    pageHashIterator = this->systemCache.find(pageId);
-  }
-
-  this->systemPageList.push_front(*pageHashIterator->second);
-  this->systemPageList.erase(pageHashIterator->second);
-  this->systemCache[pageId] = this->systemPageList.begin();
+  this->extentPrefetcher.Enqueue(PrefetchRequest(leafPageId, leafIndexPosition, prefetchDepth, table));
+}
 
-  (*pageHashIterator->second)->SetFileName(filename);
+PrefetchStatistics StorageManager::GetPrefetchStatistics() const
+{
+  PrefetchStatistics statistics;
 
-  Page *page = *pageHashIterator->second;
+  this->extentPrefetcher.GetStatistics(statistics);
 
-  this->UnlockSystemPageWrite();
+  statistics.hits = this->dataPool.GetPrefetchHits() + this->systemPool.GetPrefetchHits();
+  statistics.waste = this->dataPool.GetPrefetchWaste() + this->systemPool.GetPrefetchWaste();
 
-  return page;
+  return statistics;
 }
 
-Page *StorageManager::GetSystemPage(const page_id_t &pageId, const string &filename) 
-{
-  auto pageHashIterator = this->SearchSystemPageInCache(pageId);
+const BufferPoolStatistics &StorageManager::GetStatistics() const { return this->statistics; }
 
-  if (pageHashIterator == this->systemCache.end()) {
-    this->OpenSystemPage(pageId, filename);
+void StorageManager::ResetStatistics() { this->statistics.Reset(); }
 
-    pageHashIterator = this->SearchSystemPageInCache(pageId);
-  }
-  this->systemPageList.push_front(*pageHashIterator->second);
-  this->systemPageList.erase(pageHashIterator->second);
-  this->systemCache[pageId] = this->systemPageList.begin();
-  // this->MoveSystemPageToStart(pageHashIterator->second);
+void StorageManager::PrintStatistics(ostream &stream) const
+{
+  stream << "Data pool: " << this->dataPool.GetSize() << " / " << this->dataPool.GetCapacity() << " pages" << endl;
+  stream << "System pool: " << this->systemPool.GetSize() << " / " << this->systemPool.GetCapacity() << " pages" << endl;
+  stream << "Metadata region: " << this->metadataRegion.GetSize() << " pages" << endl;
+
+  this->statistics.Print(stream);
 
-  (*pageHashIterator->second)->SetFileName(filename);
+  const PrefetchStatistics prefetchStatistics = this->GetPrefetchStatistics();
 
-  return (*pageHashIterator->second);
+  stream << "Prefetch: " << prefetchStatistics.requestsQueued << " queued, " << prefetchStatistics.requestsDropped << " dropped, "
+         << prefetchStatistics.extentsRead << " extents read, " << prefetchStatistics.hits << " hits, " << prefetchStatistics.waste << " wasted" << endl;
 }
 
-Page *StorageManager::GetSystemPage(const page_id_t &pageId, const extent_id_t &extentId, const Table* table) 
+size_t StorageManager::HandlePrefetchRequest(const PrefetchRequest &request)
 {
-  auto pageHashIterator = this->SearchSystemPageInCache(pageId);
+  if (request.type == PrefetchType::INDEX_LEAF_CHAIN)
+    return this->PrefetchLeafChain(request);
 
-  if (pageHashIterator == this->systemCache.end()) 
-  {
-    this->OpenSystemExtent(extentId, table);
-    pageHashIterator = this->SearchSystemPageInCache(pageId);
-  }
+  if (this->IsExtentCached(request.extentId))
+    return 0;
 
-  this->systemPageList.push_front(*pageHashIterator->second);
-  this->systemPageList.erase(pageHashIterator->second);
-  this->systemCache[pageId] = this->systemPageList.begin();
-  // this->MoveSystemPageToStart(pageHashIterator->second);
+  this->OpenExtent(request.extentId, request.table, true);
 
-  return (*pageHashIterator->second);
+  return 1;
 }
 
-void StorageManager::OpenSystemPage(const page_id_t &pageId) 
+size_t StorageManager::PrefetchLeafChain(const PrefetchRequest &request)
 {
-  if (this->IsSystemCacheFull())
-    this->RemoveSystemPage();
+  size_t extentsRead = 0;
+  page_id_t leafPageId = request.leafPageId;
+  page_offset_t leafIndexPosition = request.leafIndexPosition;
 
-  const string &filename = this->database->GetFileName();
+  for (size_t i = 0; i < request.depth && leafPageId != 0; i++)
+  {
+    // pinned without counting as a reference, the scan has not reached the leaf yet
+    Frame *frame = this->systemPool.PinPage(leafPageId, false);
 
-  fstream *file = this->fileManager.GetFile(filename);
+    if (frame == nullptr)
+    {
+      this->OpenSystemExtent(DatabaseEngine::Database::CalculateExtentIdByPageId(leafPageId), request.table, true);
+      extentsRead++;
 
-  const streampos pageOffset = pageId * PAGE_SIZE;
-  vector<char> buffer(PAGE_SIZE);
-  SetReadFilePointerToOffset(file, pageOffset);
+      frame = this->systemPool.PinPage(leafPageId, false);
+    }
 
-  file->read(buffer.data(), PAGE_SIZE);
+    if (frame == nullptr)
+      break;
 
-  page_offset_t offSet = 0;
+    const PageGuard<IndexPage> indexPage = PageGuard<Page>(frame->page, frame).Cast<IndexPage>();
 
-  const PageHeader pageHeader =
-      StorageManager::GetPageHeaderFromFile(buffer, offSet);
+    if (!indexPage)
+      break;
 
-  Page *page = nullptr;
+    const Indexing::Node *leaf = indexPage->GetNodeByIndex(leafIndexPosition);
 
-  StorageManager::AllocateMemoryBasedOnSystemPageType(&page, pageHeader);
+    // clustered leaves also point at the data page holding their rows
+    if (leaf->isNodeClustered && leaf->dataPageId != 0)
+    {
+      const extent_id_t dataExtentId = DatabaseEngine::Database::CalculateExtentIdByPageId(leaf->dataPageId);
 
-  // this->LockSystemPageWrite();
+      if (!this->IsExtentCached(dataExtentId))
+      {
+        this->OpenExtent(dataExtentId, request.table, true);
+        extentsRead++;
+      }
+    }
+
+    leafPageId = leaf->nextNodeHeader.pageId;
+    leafIndexPosition = leaf->nextNodeHeader.indexPosition;
+  }
 
-  this->systemPageList.push_front(page);
-  this->systemCache[pageId] = this->systemPageList.begin();
+  return extentsRead;
+}
 
-  // this->UnlockSystemPageWrite();
+IndexAllocationMapPage *StorageManager::GetIndexAllocationMapPage(const page_id_t &pageId) 
+{
+  return dynamic_cast<IndexAllocationMapPage *>(this->GetMetadataPage(pageId));
+}
 
-  page->GetPageDataFromFile(buffer, nullptr, offSet, file);
+GlobalAllocationMapPage *StorageManager::GetGlobalAllocationMapPage(const page_id_t &pageId) 
+{
+  return dynamic_cast<GlobalAllocationMapPage *>(this->GetMetadataPage(pageId));
 }
 
-void StorageManager::OpenSystemExtent(const extent_id_t &extentId, const Table* table)
+Page *StorageManager::GetMetadataPage(const page_id_t &pageId)
 {
+  // page 0 is the header page, tables without an allocation map point there
+  if (pageId == 0)
+    return nullptr;
+
+  // resident until shutdown once loaded, lookups are not counted as hits to keep the insert and scan paths free of shared writes
+  Page *page = this->metadataRegion.FindPage(pageId);
+
+  if (page != nullptr)
+    return page;
+
+  const auto loadStart = chrono::steady_clock::now();
   const string &filename = this->database->GetFileName();
 
-  // read page from disk, call this->fileManager
-  fstream *file = this->fileManager.GetFile(filename);
+  page = this->InsertPageToMetadataRegion(this->ReadSystemPage(pageId, filename), filename);
 
-  const page_id_t firstExtentPageId = DatabaseEngine::Database::CalculateSystemPageOffsetByExtentId(extentId);
+  this->statistics.RecordMiss(page->GetPageType(), StorageManager::GetElapsedMicroseconds(loadStart));
 
-  const streampos extentOffset = firstExtentPageId * PAGE_SIZE;
+  return page;
+}
 
-  vector<char> buffer(EXTENT_BYTE_SIZE);
+void StorageManager::FlushMetadataPages()
+{
+  if (this->isReadOnly)
+    return;
 
-  SetReadFilePointerToOffset(file, extentOffset);
+  vector<Page *> dirtyPages;
 
-  // take into account the metadata page all the others
-  file->read(buffer.data(), EXTENT_BYTE_SIZE);
+  // metadata pages are modified without a pin, callers flush them while no inserts are running
+  this->metadataRegion.ForEachPage([&dirtyPages](Page *page)
+  {
+    if (page->GetPageDirtyStatus())
+      dirtyPages.push_back(page);
+  });
 
-  page_offset_t offSet = 0;
+  if (dirtyPages.empty())
+    return;
 
-  const auto &bytesRead = file->gcount();
+  this->WritePagesToDisk(dirtyPages);
 
-  for (int i = 0; i < EXTENT_SIZE; i++) {
-    offSet = i * PAGE_SIZE;
+  for (const auto &page : dirtyPages)
+    page->SetPageDirtyStatus(false);
+}
 
-    if (bytesRead < offSet)
-      break;
+PageGuard<Page> StorageManager::PinSystemPage(const page_id_t &pageId, const string &filename)
+{
+  Frame *frame = this->systemPool.PinPage(pageId);
 
-    const page_id_t currentPageId = firstExtentPageId + i;
+  const bool isHit = frame != nullptr;
+  const auto loadStart = chrono::steady_clock::now();
 
-    if (this->IsPageCached(currentPageId))
-      continue;
+  for (int attempt = 0; frame == nullptr && attempt < PAGE_LOAD_ATTEMPTS; attempt++)
+  {
+    this->OpenSystemPage(pageId, filename);
 
-    if (this->systemPageList.size() == MAX_NUMBER_SYSTEM_PAGES)
-        this->RemoveSystemPage();
+    frame = this->systemPool.PinPage(pageId, false);
+  }
 
-    PageHeader pageHeader = StorageManager::GetPageHeaderFromFile(buffer, offSet);
+  if (frame == nullptr)
+    throw runtime_error("StorageManager::PinSystemPage: Page " + to_string(pageId) + " could not be loaded");
 
-    Page *page = nullptr;
+  if (isHit)
+    this->statistics.RecordHit(frame->page->GetPageType());
+  else
+    this->statistics.RecordMiss(frame->page->GetPageType(), StorageManager::GetElapsedMicroseconds(loadStart));
 
-    StorageManager::AllocateMemoryBasedOnSystemPageType(&page, pageHeader);
+  return PageGuard<Page>(frame->page, frame);
+}
 
-    page->GetPageDataFromFile(buffer, table, offSet, file);
+PageGuard<Page> StorageManager::PinSystemPage(const page_id_t &pageId, const extent_id_t &extentId, const Table* table) 
+{
+  Frame *frame = this->systemPool.PinPage(pageId);
 
-    this->systemPageList.push_front(page);
+  const bool isHit = frame != nullptr;
+  const auto loadStart = chrono::steady_clock::now();
 
-    this->systemCache[page->GetPageId()] = this->systemPageList.begin();
+  for (int attempt = 0; frame == nullptr && attempt < PAGE_LOAD_ATTEMPTS; attempt++)
+  {
+    this->OpenSystemExtent(extentId, table);
 
-    page->SetFileName(filename);
+    frame = this->systemPool.PinPage(pageId, false);
   }
+
+  if (frame == nullptr)
+    throw runtime_error("StorageManager::PinSystemPage: Page " + to_string(pageId) + " could not be loaded");
+
+  if (isHit)
+    this->statistics.RecordHit(frame->page->GetPageType());
+  else
+    this->statistics.RecordMiss(frame->page->GetPageType(), StorageManager::GetElapsedMicroseconds(loadStart));
+
+  return PageGuard<Page>(frame->page, frame);
 }
 
-void StorageManager::OpenSystemPage(const page_id_t &pageId,const string &filename) 
+void StorageManager::OpenSystemExtent(const extent_id_t &extentId, const Table* table, const bool &isPrefetch)
 {
-  if (this->IsSystemCacheFull())
-    this->RemoveSystemPage();
+  const string &filename = this->database->GetFileName();
 
-  fstream *file = this->fileManager.GetFile(filename);
+  PageReadBuffer readBuffer;
+  page_id_t firstExtentPageId = DatabaseEngine::Database::CalculateSystemPageOffsetByExtentId(extentId);
 
-  const streampos pageOffset = pageId * PAGE_SIZE;
-  vector<char> buffer(PAGE_SIZE);
-  SetReadFilePointerToOffset(file, pageOffset);
+  const vector<uint64_t> loadTickets = this->systemPool.BeginPageLoads(firstExtentPageId, EXTENT_SIZE);
 
-  file->read(buffer.data(), PAGE_SIZE);
+  try
+  {
+    this->ReadExtentFromFile(extentId, readBuffer, firstExtentPageId);
 
-  page_offset_t offSet = 0;
+    page_offset_t offSet = 0;
 
-  const PageHeader pageHeader =
-      StorageManager::GetPageHeaderFromFile(buffer, offSet);
+    for (size_t i = 0; i < readBuffer.pages.size(); i++) {
+      offSet = 0;
 
-  Page *page = nullptr;
-  StorageManager::AllocateMemoryBasedOnSystemPageType(&page, pageHeader);
+      const span<const char> &buffer = readBuffer.pages[i];
+
+      const page_id_t currentPageId = firstExtentPageId + i;
+
+      PageHeader pageHeader = StorageManager::GetPageHeaderFromFile(buffer, offSet);
 
-  // this->LockSystemPageWrite();
+      this->statistics.RecordRead(pageHeader.pageType, PAGE_SIZE);
 
-  this->systemPageList.push_front(page);
+      if (this->IsPageCached(currentPageId))
+        continue;
 
-  this->systemCache[pageId] = this->systemPageList.begin();
+      Page *page = nullptr;
 
-  // this->UnlockSystemPageWrite();
+      StorageManager::AllocateMemoryBasedOnSystemPageType(&page, pageHeader);
 
-  page->GetPageDataFromFile(buffer, nullptr, offSet, file);
+      page->GetPageDataFromFile(buffer, table, offSet, nullptr);
+      page->SetFileName(filename);
+
+      if (StorageManager::IsMetadataPage(pageHeader.pageType))
+        this->InsertPageToMetadataRegion(page, filename);
+      else
+        this->systemPool.InsertLoadedPage(page, loadTickets[i], isPrefetch);
+    }
+  }
+  catch (...)
+  {
+    this->systemPool.EndPageLoads(firstExtentPageId, EXTENT_SIZE);
+
+    throw;
+  }
+
+  this->systemPool.EndPageLoads(firstExtentPageId, EXTENT_SIZE);
 }
 
-void StorageManager::RemoveSystemPage() 
+void StorageManager::OpenSystemPage(const page_id_t &pageId,const string &filename) 
 {
-  // this->LockSystemPageWrite();
+  const uint64_t loadTicket = this->systemPool.BeginPageLoads(pageId, 1)[0];
 
-  Page *page = this->systemPageList.back();
+  try
+  {
+    Page *page = this->ReadSystemPage(pageId, filename);
+    page->SetFileName(filename);
 
-  const page_id_t pageId = page->GetPageId();
+    this->systemPool.InsertLoadedPage(page, loadTicket);
+  }
+  catch (...)
+  {
+    this->systemPool.EndPageLoads(pageId, 1);
 
-  this->systemCache.erase(pageId);
+    throw;
+  }
 
-  this->systemPageList.pop_back();
+  this->systemPool.EndPageLoads(pageId, 1);
+}
 
-  // this->UnlockSystemPageWrite();
+Page *StorageManager::ReadSystemPage(const page_id_t &pageId, const string &filename)
+{
+  PageReadBuffer readBuffer;
 
-  if (page->GetPageDirtyStatus()) 
-  {
-    const string &filename = page->GetFileName();
+  // single page probes, nothing next to them is about to be read
+  this->ReadPagesFromFile(filename, pageId, 1, AccessPattern::RANDOM, readBuffer);
 
-    fstream *file = this->fileManager.GetFile(filename);
+  if (readBuffer.pages.empty())
+    throw runtime_error("StorageManager::ReadSystemPage: Page " + to_string(pageId) + " is past the end of " + filename);
 
-    const streampos pageOffset = pageId * PAGE_SIZE;
+  const span<const char> &buffer = readBuffer.pages[0];
 
-    SetWriteFilePointerToOffset(file, pageOffset);
+  page_offset_t offSet = 0;
 
-    page->WritePageToFile(file);
-  }
+  const PageHeader pageHeader =
+      StorageManager::GetPageHeaderFromFile(buffer, offSet);
 
-  delete page;
+  this->statistics.RecordRead(pageHeader.pageType, PAGE_SIZE);
+
+  Page *page = nullptr;
+  StorageManager::AllocateMemoryBasedOnSystemPageType(&page, pageHeader);
+
+  page->GetPageDataFromFile(buffer, nullptr, offSet, nullptr);
+
+  return page;
 }
 
 void StorageManager::AllocateMemoryBasedOnSystemPageType(Page **page, const PageHeader &pageHeader) 
@@ -547,29 +715,6 @@ void StorageManager::AllocateMemoryBasedOnSystemPageType(Page **page, const Page
 /////////////////////////Globally Used Functions///////////////////
 //////////////////////////////////////////////////////////////////
 
-unordered_map<page_id_t, PageIterator>::iterator
-StorageManager::SearchSystemPageInCache(const page_id_t &pageId) 
-{
-  // Page* page = nullptr;
-
-  // this->LockSystemPageRead();
-
-  return this->systemCache.find(pageId);
-
-  // this->UnlockSystemPageRead();
-}
-
-void StorageManager::MoveSystemPageToStart(const PageIterator &pageIterator) 
-{
-  // this->LockSystemPageWrite();
-
-  this->systemPageList.push_front(*pageIterator);
-  this->systemPageList.erase(pageIterator);
-  this->systemCache[(*pageIterator)->GetPageId()] = this->systemPageList.begin();
-
-  // this->UnlockSystemPageWrite();
-}
-
 void StorageManager::AllocateMemoryBasedOnPageType(Page **page, const PageHeader &pageHeader) 
 {
   switch (pageHeader.pageType) 
@@ -588,43 +733,56 @@ void StorageManager::AllocateMemoryBasedOnPageType(Page **page, const PageHeader
   }
 }
 
-void StorageManager::MovePageToFrontOfSystemList(Page *page,
-                                              const page_id_t &pageId,
-                                              const string &filename) {
-  if (this->systemPageList.size() == MAX_NUMBER_SYSTEM_PAGES)
-    this->RemoveSystemPage();
-
+Page *StorageManager::InsertPageToSystemPool(Page *page, const string &filename, const bool &isPrefetch) 
+{
   page->SetFileName(filename);
 
-  this->systemPageList.push_front(page);
-  this->systemCache[pageId] = this->systemPageList.begin();
+  return this->systemPool.InsertPage(page, isPrefetch);
 }
 
-void StorageManager::MovePageToFrontOfSystemList(Page *page,
-                                              const page_id_t &pageId) {
-  if (this->systemPageList.size() == MAX_NUMBER_SYSTEM_PAGES)
-    this->RemoveSystemPage();
+Page *StorageManager::InsertPageToSystemPool(Page *page) 
+{
+  return this->InsertPageToSystemPool(page, this->database->GetFileName());
+}
 
-  const string &filename = this->database->GetFileName();
+Page *StorageManager::InsertPageToMetadataRegion(Page *page, const string &filename)
+{
+  page->SetFileName(filename);
 
+  return this->metadataRegion.InsertPage(page);
+}
+
+bool StorageManager::IsMetadataPage(const PageType &pageType)
+{
+  return pageType == PageType::FREESPACE || pageType == PageType::GAM || pageType == PageType::IAM;
+}
+
+Page *StorageManager::InsertPageToPool(Page *page, const string &filename, const bool &isPrefetch) 
+{
   page->SetFileName(filename);
 
-  this->systemPageList.push_front(page);
-  this->systemCache[pageId] = this->systemPageList.begin();
+  return this->dataPool.InsertPage(page, isPrefetch);
 }
 
-void StorageManager::MovePageToFrontOfList(Page *page, const page_id_t &pageId,
-                                        const string &filename) {
-  if (this->pageList.size() == MAX_NUMBER_SYSTEM_PAGES)
-    this->RemovePage();
+PageGuard<Page> StorageManager::InsertPinnedPageToPool(Page *page, const string &filename)
+{
+  page->SetFileName(filename);
 
+  Frame *frame = this->dataPool.InsertPinnedPage(page);
+
+  return PageGuard<Page>(frame->page, frame);
+}
+
+PageGuard<Page> StorageManager::InsertPinnedPageToSystemPool(Page *page, const string &filename)
+{
   page->SetFileName(filename);
 
-  this->pageList.push_front(page);
-  this->cache[pageId] = this->pageList.begin();
+  Frame *frame = this->systemPool.InsertPinnedPage(page);
+
+  return PageGuard<Page>(frame->page, frame);
 }
 
-PageHeader StorageManager::GetPageHeaderFromFile(const vector<char> &data,
+PageHeader StorageManager::GetPageHeaderFromFile(const span<const char> &data,
                                               page_offset_t &offSet) {
   PageHeader pageHeader;
   memcpy(&pageHeader.pageId, data.data() + offSet, sizeof(page_id_t));
@@ -645,126 +803,19 @@ PageHeader StorageManager::GetPageHeaderFromFile(const vector<char> &data,
 
 bool StorageManager::IsPageCached(const page_id_t &pageId) 
 {
-  const auto &pageIterator = this->cache.find(pageId);
-
-  if (pageIterator != this->cache.end()) 
-  {
-    this->pageList.push_front(*pageIterator->second);
-    this->pageList.erase(pageIterator->second);
-
-    this->cache[pageId] = this->pageList.begin();
-
-    return true;
-  }
-
-  const auto &systemPageIterator = this->systemCache.find(pageId);
-
-  if (systemPageIterator != this->systemCache.end()) 
-  {
-    this->systemPageList.push_front(*systemPageIterator->second);
-    this->systemPageList.erase(systemPageIterator->second);
-
-    this->systemCache[pageId] = this->systemPageList.begin();
-
-    return true;
-  }
-
-  return false;
-}
-
-void StorageManager::SetReadFilePointerToOffset(fstream *file, const streampos &offSet) {
-  file->clear();
-  file->seekg(0, ios::beg);
-  file->seekg(offSet);
-}
-
-void StorageManager::SetWriteFilePointerToOffset(fstream *file, const streampos &offSet) 
-{
-  file->clear();
-  file->seekp(0, ios::beg);
-  file->seekp(offSet);
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////
-//////////////////////////////////Thread
-/// Synchronization//////////////////////////////////
-/////////////////////////////////////////////////////////////////////////////////////////
-
-void StorageManager::LockSystemPageRead() 
-{
-  unique_lock<mutex> lock(this->systemPageListMutex);
-
-  this->systemConditionVariable.wait(
-      lock, [this]() { return this->cacheWriters == 0; });
-
-  this->cacheReaders++;
-}
-
-void StorageManager::UnlockSystemPageRead() 
-{
-  unique_lock<mutex> lock(this->systemPageListMutex);
-  this->cacheReaders--;
-
-  if (this->cacheReaders == 0)
-    this->systemConditionVariable.notify_all();
-}
-
-void StorageManager::LockSystemPageWrite() 
-{
-  unique_lock<mutex> lock(this->systemPageListMutex);
-
-  this->systemConditionVariable.wait(lock, [this]() {
-    return this->cacheReaders == 0 && this->cacheWriters == 0;
-  });
-
-  this->cacheWriters++;
-}
-
-void StorageManager::UnlockSystemPageWrite() 
-{
-  unique_lock<mutex> lock(this->systemPageListMutex);
-
-  this->cacheWriters--;
-
-  this->systemConditionVariable.notify_all();
-}
-
-void StorageManager::LockPageRead() 
-{
-  unique_lock<mutex> lock(this->pageListMutex);
-
-  this->dataConditionVariable.wait(lock,
-                                   [this]() { return this->dataWriters == 0; });
-
-  this->dataReaders++;
+  return this->dataPool.ContainsPage(pageId) || this->systemPool.ContainsPage(pageId) || this->metadataRegion.FindPage(pageId) != nullptr;
 }
 
-void StorageManager::UnlockPageRead() 
+bool StorageManager::IsExtentCached(const extent_id_t &extentId)
 {
-  unique_lock<mutex> lock(this->pageListMutex);
-  this->dataReaders--;
-
-  if (this->dataReaders == 0)
-    this->dataConditionVariable.notify_all();
-}
-
-void StorageManager::LockPageWrite() 
-{
-  unique_lock<mutex> lock(this->pageListMutex);
-
-  this->dataConditionVariable.wait(lock, [this]() {
-    return this->dataReaders == 0 && this->dataWriters == 0;
-  });
-
-  this->dataWriters++;
-}
-
-void StorageManager::UnlockPageWrite() 
-{
-  unique_lock<mutex> lock(this->pageListMutex);
+  const page_id_t firstExtentPageId = DatabaseEngine::Database::CalculateSystemPageOffsetByExtentId(extentId);
 
-  this->dataWriters--;
+  for (page_id_t pageId = firstExtentPageId; pageId < firstExtentPageId + EXTENT_SIZE; pageId++)
+  {
+    if (!this->IsPageCached(pageId))
+      return false;
+  }
 
-  this->dataConditionVariable.notify_all();
+  return true;
 }
 } // namespace Storage
\ No newline at end of file
@@ -1,12 +1,20 @@
 #pragma once
 #include "../../Constants.h"
-#include <condition_variable>
-#include <list>
+#include <chrono>
 #include <mutex>
+#include <ostream>
+#include <span>
 #include <string>
-#include <unordered_map>
 #include <vector>
+#include "../BufferPool/BufferPool.h"
+#include "../BufferPoolStatistics/BufferPoolStatistics.h"
+#include "../ExtentPrefetcher/ExtentPrefetcher.h"
 #include "../FileManager/FileManager.h"
+#include "../IoBackends/IoBackend.h"
+#include "../MetadataPageRegion/MetadataPageRegion.h"
+#include "../PageFlusher/PageFlusher.h"
+#include "../PageGuard/PageGuard.h"
+#include "../StorageSettings/StorageSettings.h"
 
 namespace DatabaseEngine {
 class Database;
@@ -31,71 +39,64 @@ namespace Storage {
 class FileManager;
 using namespace std;
 
-typedef list<Pages::Page *>::iterator PageIterator;
-
 class StorageManager final{
-  list<Pages::Page *> pageList;
-  unordered_map<Constants::page_id_t, PageIterator> cache;
-  list<Pages::Page *> systemPageList;
-  unordered_map<Constants::page_id_t, PageIterator> systemCache;
+  BufferPool dataPool;
+  BufferPool systemPool;
+  MetadataPageRegion metadataRegion;
   const DatabaseEngine::Database *database;
-  mutex pageListMutex;
-  mutex systemPageListMutex;
-  condition_variable systemConditionVariable;
-  condition_variable dataConditionVariable;
-  int cacheReaders;
-  int cacheWriters;
-  int dataReaders;
-  int dataWriters;
+  mutex fileMutex;
   FileManager fileManager;
+  IoBackend *ioBackend;
+  bool isReadOnly;
+  PageFlusher pageFlusher;
+  ExtentPrefetcher extentPrefetcher;
+  BufferPoolStatistics statistics;
 
 protected:
   explicit StorageManager();
-  void RemovePage();
-  void RemoveSystemPage();
+  void RemovePage(Pages::Page *page, const vector<Pages::Page *> &neighbours);
+  void WritePagesToDisk(const vector<Pages::Page *> &pages);
   static void AllocateMemoryBasedOnSystemPageType(Pages::Page **page, const Pages::PageHeader &pageHeader);
   static void AllocateMemoryBasedOnPageType(Pages::Page **page, const Pages::PageHeader &pageHeader);
-  void OpenExtent(const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table *table);
-  void OpenSystemExtent(const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table* table);
-  void OpenSystemPage(const Constants::page_id_t &pageId);
+  static size_t GetPoolCapacity(const size_t &poolBytes);
+  static uint64_t GetElapsedMicroseconds(const chrono::steady_clock::time_point &start);
+  static bool IsMetadataPage(const Constants::PageType &pageType);
+  void OpenExtent(const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table *table, const bool &isPrefetch = false);
+  void OpenSystemExtent(const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table* table, const bool &isPrefetch = false);
   void OpenSystemPage(const Constants::page_id_t &pageId, const string &filename);
-  Pages::Page *GetSystemPage(const Constants::page_id_t &pageId);
-  Pages::Page *GetSystemPage(const Constants::page_id_t &pageId, const string &filename);
-  Pages::Page *GetSystemPage(const Constants::page_id_t &pageId, const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table *table = nullptr);
-  static void SetReadFilePointerToOffset(fstream *file, const streampos &offSet);
-  static void SetWriteFilePointerToOffset(fstream *file, const streampos &offSet);
-  static Pages::PageHeader GetPageHeaderFromFile(const vector<char> &data, Constants::page_offset_t &offSet);
+  Pages::Page *ReadSystemPage(const Constants::page_id_t &pageId, const string &filename);
+  void ReadExtentFromFile(const Constants::extent_id_t &extentId, PageReadBuffer &readBuffer, Constants::page_id_t &firstExtentPageId);
+  void ReadPagesFromFile(const string &filename, const Constants::page_id_t &firstPageId, const size_t &pageCount, const Constants::AccessPattern &accessPattern, PageReadBuffer &readBuffer);
+  Pages::Page *GetMetadataPage(const Constants::page_id_t &pageId);
+  PageGuard<Pages::Page> PinSystemPage(const Constants::page_id_t &pageId, const string &filename);
+  PageGuard<Pages::Page> PinSystemPage(const Constants::page_id_t &pageId, const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table *table);
   bool IsPageCached(const Constants::page_id_t &pageId);
-  void MovePageToFrontOfSystemList(Pages::Page *page, const Constants::page_id_t &pageId, const string &filename);
-  void MovePageToFrontOfSystemList(Pages::Page *page, const Constants::page_id_t &pageId);
-  void MovePageToFrontOfList(Pages::Page *page, const Constants::page_id_t &pageId, const string &filename);
-  void MovePageToFrontOfList(Pages::Page *page, const Constants::page_id_t &pageId);
-  void ReadSystemPageFromFile(Pages::Page *page, const vector<char> &buffer, const Constants::page_id_t &pageId, Constants::page_offset_t &offSet, fstream *file);
-  void ReadPageFromFile(Pages::Page *page, const vector<char> &buffer, const DatabaseEngine::StorageTypes::Table *table, Constants::page_offset_t &offSet, fstream *file);
-  bool IsSystemCacheFull() const;
-  void LockSystemPageRead();
-  void UnlockSystemPageRead();
-  void LockSystemPageWrite();
-  void UnlockSystemPageWrite();
-  void LockPageRead();
-  void UnlockPageRead();
-  void LockPageWrite();
-  void UnlockPageWrite();
-  unordered_map<Constants::page_id_t, PageIterator>::iterator
-  SearchSystemPageInCache(const Constants::page_id_t &pageId);
-  void MoveSystemPageToStart(const PageIterator &pageIterator);
+  bool IsExtentCached(const Constants::extent_id_t &extentId);
+  size_t HandlePrefetchRequest(const PrefetchRequest &request);
+  size_t PrefetchLeafChain(const PrefetchRequest &request);
+  Pages::Page *InsertPageToSystemPool(Pages::Page *page, const string &filename, const bool &isPrefetch = false);
+  Pages::Page *InsertPageToSystemPool(Pages::Page *page);
+  Pages::Page *InsertPageToMetadataRegion(Pages::Page *page, const string &filename);
+  Pages::Page *InsertPageToPool(Pages::Page *page, const string &filename, const bool &isPrefetch = false);
+  PageGuard<Pages::Page> InsertPinnedPageToPool(Pages::Page *page, const string &filename);
+  PageGuard<Pages::Page> InsertPinnedPageToSystemPool(Pages::Page *page, const string &filename);
 
 public:
   static StorageManager& Get();
   ~StorageManager();
   void CreateFile(const string& fileName, const string& extension);
+  static Pages::PageHeader GetPageHeaderFromFile(const span<const char> &data, Constants::page_offset_t &offSet);
   void BindDatabase(const DatabaseEngine::Database *database);
-  Pages::Page *CreatePage(const Constants::page_id_t &pageId);
-  Pages::Page *GetPage(const Constants::page_id_t &pageId, const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table *table);
-  Pages::HeaderPage *GetHeaderPage(const string &filename);
-  Pages::HeaderPage *CreateHeaderPage(const string &filename);
-  Pages::LargeDataPage *CreateLargeDataPage(const Constants::page_id_t &pageId);
-  Pages::LargeDataPage * GetLargeDataPage(const Constants::page_id_t &pageId, const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table *table);
+  void Configure(const StorageSettings &settings);
+  void ResizeBufferPools(const size_t &dataPoolBytes);
+  void FlushMetadataPages();
+  // created pages come back pinned like the ones that are read
+  PageGuard<Pages::Page> CreatePage(const Constants::page_id_t &pageId);
+  PageGuard<Pages::Page> GetPage(const Constants::page_id_t &pageId, const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table *table);
+  PageGuard<Pages::HeaderPage> GetHeaderPage(const string &filename);
+  PageGuard<Pages::HeaderPage> CreateHeaderPage(const string &filename);
+  PageGuard<Pages::LargeDataPage> CreateLargeDataPage(const Constants::page_id_t &pageId);
+  PageGuard<Pages::LargeDataPage> GetLargeDataPage(const Constants::page_id_t &pageId, const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table *table);
   Pages::GlobalAllocationMapPage *CreateGlobalAllocationMapPage(const string &filename, const Constants::page_id_t &pageId);
   Pages::GlobalAllocationMapPage *CreateGlobalAllocationMapPage(const Constants::page_id_t &pageId);
   Pages::GlobalAllocationMapPage *GetGlobalAllocationMapPage(const Constants::page_id_t &pageId);
@@ -104,10 +105,21 @@ public:
   Pages::PageFreeSpacePage *CreatePageFreeSpacePage(const string &filename, const Constants::page_id_t &pageId);
   Pages::PageFreeSpacePage *CreatePageFreeSpacePage(const Constants::page_id_t &pageId);
   Pages::PageFreeSpacePage * GetPageFreeSpacePage(const Constants::page_id_t &pageId);
-  Pages::IndexPage *CreateIndexPage(const Constants::page_id_t &pageId);
-  Pages::IndexPage *GetIndexPage(const Constants::page_id_t &pageId);
-  Pages::IndexPage *GetIndexPage(const Constants::page_id_t &pageId, const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table* table);
+  PageGuard<Pages::IndexPage> CreateIndexPage(const Constants::page_id_t &pageId);
+  PageGuard<Pages::IndexPage> GetIndexPage(const Constants::page_id_t &pageId);
+  PageGuard<Pages::IndexPage> GetIndexPage(const Constants::page_id_t &pageId, const Constants::extent_id_t &extentId, const DatabaseEngine::StorageTypes::Table* table);
   [[nodiscard]] bool IsCacheFull() const;
+  [[nodiscard]] size_t GetNumberOfShards() const;
+  [[nodiscard]] size_t GetDataPoolBytes() const;
+  [[nodiscard]] size_t GetSystemPoolBytes() const;
+  [[nodiscard]] IoBackendType GetIoBackendType() const;
+  [[nodiscard]] bool IsReadOnly() const;
+  void PrefetchExtents(const vector<Constants::extent_id_t> &extentIds, const size_t &startIndex, const DatabaseEngine::StorageTypes::Table *table);
+  void PrefetchIndexLeaves(const Constants::page_id_t &leafPageId, const Constants::page_offset_t &leafIndexPosition, const DatabaseEngine::StorageTypes::Table *table);
+  [[nodiscard]] PrefetchStatistics GetPrefetchStatistics() const;
+  [[nodiscard]] const BufferPoolStatistics &GetStatistics() const;
+  void ResetStatistics();
+  void PrintStatistics(ostream &stream) const;
 };
 
 } // namespace Storage
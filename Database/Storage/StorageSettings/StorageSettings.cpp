@@ -0,0 +1,27 @@
+#include "StorageSettings.h"
+
+namespace Storage {
+    StorageSettings::StorageSettings()
+    {
+        this->dataPagePolicy = ReplacementPolicyType::LRU;
+        this->systemPagePolicy = ReplacementPolicyType::LRU;
+        this->dataPoolBytes = DATA_POOL_BYTES;
+        this->isBackgroundFlushEnabled = true;
+        this->flushIntervalMs = FLUSH_INTERVAL_MS;
+        this->flushDirtyRatio = FLUSH_DIRTY_RATIO;
+        this->maxDirtyRatio = MAX_DIRTY_RATIO;
+        this->prefetchDepth = PREFETCH_DEPTH;
+        this->ioBackend = IoBackendType::POSITIONAL;
+        this->isReadOnly = false;
+        this->workerThreads = WORKER_THREADS;
+    }
+
+    StorageSettings::StorageSettings(const ReplacementPolicyType &dataPagePolicy, const ReplacementPolicyType &systemPagePolicy)
+        : StorageSettings()
+    {
+        this->dataPagePolicy = dataPagePolicy;
+        this->systemPagePolicy = systemPagePolicy;
+    }
+
+    StorageSettings::~StorageSettings() = default;
+}
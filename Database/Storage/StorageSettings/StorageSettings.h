@@ -0,0 +1,33 @@
+#pragma once
+#include "../../Constants.h"
+
+using namespace Constants;
+
+namespace Storage {
+    // buffer manager options applied when a database is opened
+    typedef struct StorageSettings {
+        ReplacementPolicyType dataPagePolicy;
+        ReplacementPolicyType systemPagePolicy;
+        // memory of the data page pool counted in PAGE_SIZE pages, the system page pool gets SYSTEM_POOL_RATIO times as much
+        size_t dataPoolBytes;
+        bool isBackgroundFlushEnabled;
+        uint32_t flushIntervalMs;
+        // the flusher writes the oldest dirty pages of a pool until its dirty share drops to flushDirtyRatio
+        // and skips its sleep while the share is still above maxDirtyRatio
+        double flushDirtyRatio;
+        double maxDirtyRatio;
+        // number of extents (or index leaves) scans read ahead of the page they are on, 0 turns read-ahead off
+        size_t prefetchDepth;
+        // POSITIONAL by default, IO_URING falls back to FSTREAM on platforms or kernels without io_uring
+        // DIRECT bypasses the page cache and goes through it only on file systems without direct I/O
+        IoBackendType ioBackend;
+        // read only databases are served out of a memory mapping of the file whatever ioBackend is set to, nothing is ever written back
+        bool isReadOnly;
+        // workers of the thread pool heap scans and sorts run on, 0 starts one per hardware thread, only the first database opened sets it
+        size_t workerThreads;
+
+        StorageSettings();
+        StorageSettings(const ReplacementPolicyType &dataPagePolicy, const ReplacementPolicyType &systemPagePolicy);
+        ~StorageSettings();
+    } StorageSettings;
+}
@@ -47,9 +47,10 @@ namespace DatabaseEngine::StorageTypes {
 
     void Table::GetClusteredIndexFromDisk() const
     {
-        Node* root = Table::GetIndexFromDisk(this->header.clusteredIndexPageId);
+        PageGuard<IndexPage> rootPage = Table::GetIndexFromDisk(this->header.clusteredIndexPageId);
+        Node* root = rootPage->GetRoot();
 
-        this->clusteredIndexedTree->SetRoot(root);
+        this->clusteredIndexedTree->SetRoot(root, std::move(rootPage));
 
         this->clusteredIndexedTree->SetTreeType(TreeType::Clustered);
     }
@@ -59,19 +60,18 @@ namespace DatabaseEngine::StorageTypes {
         if(this->header.nonClusteredIndexPageIds[indexId] == 0)
             return;
 
-        Node* root =  Table::GetIndexFromDisk(this->header.nonClusteredIndexPageIds[indexId]);
+        PageGuard<IndexPage> rootPage = Table::GetIndexFromDisk(this->header.nonClusteredIndexPageIds[indexId]);
+        Node* root = rootPage->GetRoot();
 
-        this->nonClusteredIndexedTrees[indexId]->SetRoot(root);
+        this->nonClusteredIndexedTrees[indexId]->SetRoot(root, std::move(rootPage));
 
         this->nonClusteredIndexedTrees[indexId]->SetTreeType(TreeType::NonClustered);
     }
 
-    Node* Table::GetIndexFromDisk(const page_id_t & indexPageId) const
+    PageGuard<IndexPage> Table::GetIndexFromDisk(const page_id_t & indexPageId) const
     {
         const extent_id_t indexPageExtentId = Database::CalculateExtentIdByPageId(indexPageId);
 
-        IndexPage* indexPage = StorageManager::Get().GetIndexPage(indexPageId, indexPageExtentId, this);
-
-        return indexPage->GetRoot();
+        return StorageManager::Get().GetIndexPage(indexPageId, indexPageExtentId, this);
     }
 }
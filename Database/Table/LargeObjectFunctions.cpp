@@ -28,7 +28,7 @@ namespace DatabaseEngine::StorageTypes {
 
         for (const auto &largeBlockIndex : largeBlockIndexes) 
         {
-            rowHeader->largeObjectBitMap->Set(largeBlockIndex, true);
+            rowHeader->largeObjectBitMap.Set(largeBlockIndex, true);
 
             page_offset_t offset = 0;
 
@@ -41,7 +41,7 @@ namespace DatabaseEngine::StorageTypes {
 
     void Table::RecursiveInsertToLargePage(Row *&row, page_offset_t &offset, const column_index_t &columnIndex, block_size_t &remainingBlockSize, const bool &isFirstRecursion, DataObject **previousDataObject) 
     {
-        LargeDataPage *largeDataPage = this->GetOrCreateLargeDataPage();
+        const PageGuard<LargeDataPage> largeDataPage = this->GetOrCreateLargeDataPage();
 
         const auto &pageSize = largeDataPage->GetBytesLeft();
 
@@ -55,7 +55,7 @@ namespace DatabaseEngine::StorageTypes {
             largeDataPage->InsertObject(data + offset, remainingBlockSize,
                                         &objectIndex);
 
-            this->database->SetPageMetaDataToPfs(largeDataPage);
+            this->database->SetPageMetaDataToPfs(largeDataPage.Get());
 
             Table::InsertLargeDataObjectPointerToRow(row, isFirstRecursion, objectIndex,
                                                     largeDataPage->GetPageId(),
@@ -78,7 +78,7 @@ namespace DatabaseEngine::StorageTypes {
         DataObject *dataObject = largeDataPage->InsertObject(
             data + offset, bytesToBeInserted, &objectIndex);
 
-        this->database->SetPageMetaDataToPfs(largeDataPage);
+        this->database->SetPageMetaDataToPfs(largeDataPage.Get());
 
         if (previousDataObject != nullptr) 
         {
@@ -96,13 +96,14 @@ namespace DatabaseEngine::StorageTypes {
                                                 columnIndex);
     }
 
-    LargeDataPage *Table::GetOrCreateLargeDataPage() const 
+    PageGuard<LargeDataPage> Table::GetOrCreateLargeDataPage() const 
     {
-        LargeDataPage *largeDataPage = this->database->GetTableLastLargeDataPage(this->header.tableId, OBJECT_METADATA_SIZE_T + 1);
+        PageGuard<LargeDataPage> largeDataPage = this->database->GetTableLastLargeDataPage(this->header.tableId, OBJECT_METADATA_SIZE_T + 1);
 
-        return (largeDataPage == nullptr)
-                    ? this->database->CreateLargeDataPage(this->header.tableId)
-                    : largeDataPage;
+        if (largeDataPage == nullptr)
+            return this->database->CreateLargeDataPage(this->header.tableId);
+
+        return largeDataPage;
     }
 
     void Table::LinkLargePageDataObjectChunks(DataObject *dataObject, const page_id_t &lastLargePageId, const large_page_index_t &objectIndex) 
@@ -127,7 +128,7 @@ namespace DatabaseEngine::StorageTypes {
         row->UpdateColumnData(block);
     }
 
-    LargeDataPage *Table::GetLargeDataPage(const page_id_t &pageId) const { return this->database->GetLargeDataPage(pageId, this->header.tableId); }
+    PageGuard<LargeDataPage> Table::GetLargeDataPage(const page_id_t &pageId) const { return this->database->GetLargeDataPage(pageId, this->header.tableId); }
 
     const vector<vector<column_index_t>> & Table::GetNonClusteredIndexes() const { return this->header.nonClusteredColumnIndexes; }
 
@@ -1,6 +1,7 @@
 ﻿#include "Table.h"
 #include "../../AdditionalLibraries/AdditionalDataTypes/Field/Field.h"
 #include "../../AdditionalLibraries/BitMap/BitMap.h"
+#include "../../AdditionalLibraries/ThreadPool/ThreadPool.h"
 #include "../Block/Block.h"
 #include "../Column/Column.h"
 #include "../Constants.h"
@@ -12,7 +13,9 @@
 #include "../Storage/StorageManager/StorageManager.h"
 #include "../Pages/Page.h"
 #include "../Row/Row.h"
+#include "../RowPredicate/RowPredicate.h"
 #include "../B+Tree/BPlusTree.h"
+#include <algorithm>
 #include <stdexcept>
 #include <unordered_set>
 
@@ -116,7 +119,7 @@ namespace DatabaseEngine::StorageTypes {
         for (int i = 0; i < this->nonClusteredIndexedTrees.size(); i++)
             delete this->nonClusteredIndexedTrees[i];
 
-        HeaderPage* headerPage = StorageManager::Get().GetHeaderPage(this->database->GetFileName());
+        const PageGuard<HeaderPage> headerPage = StorageManager::Get().GetHeaderPage(this->database->GetFileName());
 
         headerPage->SetTableHeader(this);
 
@@ -241,7 +244,7 @@ namespace DatabaseEngine::StorageTypes {
         return false;
       }
 
-      void Table::Select(vector<Row> &selectedRows, const vector<column_index_t>& selectedColumnIndices, const vector<Field> *conditions, const size_t &count) 
+      void Table::Select(vector<Row> &selectedRows, const vector<column_index_t>& selectedColumnIndices, const vector<Field> *conditions, const size_t &count, Arenas::MonotonicArena *resultArena) 
       {
         const size_t rowsToSelect =  (count == -1) 
                                   ? numeric_limits<size_t>::max() 
@@ -262,20 +265,25 @@ namespace DatabaseEngine::StorageTypes {
         bool clusteredIndexSeek = false;
         bool nonClusteredIndexSeek = false;
 
-        if(conditions != nullptr)
+        // the index is only searched for equal keys, Or, grouped, range and null conditions are evaluated by the heap scan
+        const bool isIndexUsable = conditions == nullptr || all_of(conditions->begin(), conditions->end(), [](const Field &condition)
+        {
+            const Operator &operatorType = condition.GetOperatorType();
+
+            return condition.GetConditionType() != ConditionType::Or
+                   && condition.GetChildren().empty()
+                   && !condition.GetIsNull()
+                   && (operatorType == Operator::Equal || operatorType == Operator::OperatorNone);
+        });
+
+        if(conditions != nullptr && isIndexUsable)
           for(const auto& condition: *conditions)
           {
               const auto& columnIndex = condition.GetColumnIndex();
-              const auto& data = condition.GetData();
 
-              Block *block = new Block(columns[columnIndex]);
+              const Block *block = this->CreateConditionBlock(condition);
 
-              const ColumnType columnType = columns[columnIndex]->GetColumnType();
-    
-              if (columnType > ColumnType::ColumnTypeCount)
-                throw invalid_argument("Table::Select: Unsupported Column Type");
-    
-              this->setBlockDataByDataTypeArray[static_cast<int>(columnType)]( block, condition);
+              const ColumnType columnType = block->GetColumnType();
 
               int indexPosition = 0;
               if(Table::VectorContainsIndex(clusteredIndexes, columnIndex, indexPosition))
@@ -322,21 +330,39 @@ namespace DatabaseEngine::StorageTypes {
 
               minimumValue.InsertKey(Key(block->GetBlockData(), block->GetBlockSize(), columnType));
               maximumValue.InsertKey(Key(block->GetBlockData(), block->GetBlockSize(), columnType));
+
+              delete block;
           }
 
         //handle more complex queries like prefer index seek over index scan
         if(useClusteredIndex)
         {
-            this->SelectRowsFromClusteredIndex(&selectedRows, rowsToSelect, minimumValue, maximumValue, clusteredIndexSeek, selectedColumnIndices);
+            this->SelectRowsFromClusteredIndex(&selectedRows, rowsToSelect, minimumValue, maximumValue, clusteredIndexSeek, selectedColumnIndices, resultArena);
             return;
         }
         else if (useNonClusteredIndex)
         {
-            this->SelectRowsFromNonClusteredIndex(&selectedRows, rowsToSelect, conditions, selectedColumnIndices);
+            this->SelectRowsFromNonClusteredIndex(&selectedRows, rowsToSelect, conditions, selectedColumnIndices, resultArena);
             return;
         }
       
-        this->SelectRowsFromHeap(&selectedRows, rowsToSelect, conditions);
+        this->SelectRowsFromHeap(&selectedRows, rowsToSelect, conditions, selectedColumnIndices, resultArena);
+      }
+
+      Block *Table::CreateConditionBlock(const Field &condition) const
+      {
+        const auto& columnIndex = condition.GetColumnIndex();
+
+        Block *block = new Block(this->columns[columnIndex]);
+
+        const ColumnType columnType = this->columns[columnIndex]->GetColumnType();
+
+        if (columnType > ColumnType::ColumnTypeCount)
+          throw invalid_argument("Table::CreateConditionBlock: Unsupported Column Type");
+
+        this->setBlockDataByDataTypeArray[static_cast<int>(columnType)](block, condition);
+
+        return block;
       }
 
       void Table::Update(const vector<Field> &updates, const vector<Field> *conditions) const 
@@ -410,7 +436,7 @@ namespace DatabaseEngine::StorageTypes {
         return maximumRowSize;
     }
 
-    void Table::SelectRowsFromClusteredIndex(vector<Row> *selectedRows, const size_t &rowsToSelect, const Key& minimumValue, const Key& maximumValue, const bool indexSeek, const vector<column_index_t>& selectedColumnIndices)
+    void Table::SelectRowsFromClusteredIndex(vector<Row> *selectedRows, const size_t &rowsToSelect, const Key& minimumValue, const Key& maximumValue, const bool indexSeek, const vector<column_index_t>& selectedColumnIndices, Arenas::MonotonicArena *resultArena)
     {
         vector<QueryData> results;
         const int32_t minKey = 0;
@@ -427,7 +453,7 @@ namespace DatabaseEngine::StorageTypes {
             return;
 
         extent_id_t pageExtentId = Database::CalculateExtentIdByPageId(results[0].pageId);
-        const Page *page = StorageManager::Get().GetPage(results[0].pageId, pageExtentId, this);
+        PageGuard<Page> page = StorageManager::Get().GetPage(results[0].pageId, pageExtentId, this);
 
         for (const auto &result : results)
         {
@@ -438,11 +464,11 @@ namespace DatabaseEngine::StorageTypes {
                 page = StorageManager::Get().GetPage(result.pageId, pageExtentId, this);
             }
 
-            page->GetRowByIndex(selectedRows, *this, result.indexPosition, selectedColumnIndices);
+            page->GetRowByIndex(selectedRows, *this, result.indexPosition, selectedColumnIndices, resultArena);
         }
     }
 
-    void Table::SelectRowsFromNonClusteredIndex(vector<Row>* selectedRows, const size_t & rowsToSelect, const vector<Field>* conditions, const vector<column_index_t>& selectedColumnIndices)
+    void Table::SelectRowsFromNonClusteredIndex(vector<Row>* selectedRows, const size_t & rowsToSelect, const vector<Field>* conditions, const vector<column_index_t>& selectedColumnIndices, Arenas::MonotonicArena *resultArena)
     {
         //find which index to use
 
@@ -469,7 +495,7 @@ namespace DatabaseEngine::StorageTypes {
             return;
 
         extent_id_t pageExtentId = Database::CalculateExtentIdByPageId(results[0].pageId);
-        const Page *page = StorageManager::Get().GetPage(results[0].pageId, pageExtentId, this);
+        PageGuard<Page> page = StorageManager::Get().GetPage(results[0].pageId, pageExtentId, this);
 
         for (const auto &result : results)
         {
@@ -480,11 +506,11 @@ namespace DatabaseEngine::StorageTypes {
                 page = StorageManager::Get().GetPage(result.pageId, pageExtentId, this);
             }
 
-            page->GetRowByIndex(selectedRows, *this, result.index, selectedColumnIndices);
+            page->GetRowByIndex(selectedRows, *this, result.index, selectedColumnIndices, resultArena);
         }
     }
 
-    void Table::SelectRowsFromHeap(vector<Row> *selectedRows, const size_t &rowsToSelect, const vector<Field> *conditions)
+    void Table::SelectRowsFromHeap(vector<Row> *selectedRows, const size_t &rowsToSelect, const vector<Field> *conditions, const vector<column_index_t>& selectedColumnIndices, Arenas::MonotonicArena *resultArena)
     {
         if(this->header.indexAllocationMapPageId == 0)
             return;
@@ -494,18 +520,29 @@ namespace DatabaseEngine::StorageTypes {
         vector<extent_id_t> tableExtentIds;
         tableMapPage->GetAllocatedExtents(&tableExtentIds);
 
-        vector<thread> workerThreads;
+        // the conditions are compiled once and shared by every extent task, evaluating them does not modify the predicate
+        const unique_ptr<const RowPredicate> predicate = (conditions != nullptr && !conditions->empty())
+                                                        ? make_unique<const RowPredicate>(*this, *conditions)
+                                                        : nullptr;
+
+        // rows found by every extent task so far, the others stop early once the limit is reached
+        atomic<size_t> selectedRowCount = 0;
+
+        // one task per extent on the shared pool, the workers steal extents from each other when the pages are unevenly full
+        Threading::TaskGroup extentTasks;
         for (const auto &extentId : tableExtentIds)
         {
-            workerThreads.emplace_back([this, selectedRows, conditions, rowsToSelect, extentId, tableMapPage]
-                                        { ThreadSelect(tableMapPage, extentId, rowsToSelect, conditions, selectedRows); });
+            // every task carves its rows from an arena of its own, they are freed with the result arena
+            Arenas::MonotonicArena *extentArena = (resultArena != nullptr) ? resultArena->CreateChildArena() : nullptr;
+
+            extentTasks.Run([this, selectedRows, &predicate, &selectedColumnIndices, &selectedRowCount, rowsToSelect, extentId, tableMapPage, extentArena]
+                            { ThreadSelect(tableMapPage, extentId, rowsToSelect, predicate.get(), selectedColumnIndices, selectedRows, selectedRowCount, extentArena); });
         }
 
-        for (auto &workerThread : workerThreads)
-            workerThread.join();
+        extentTasks.Wait();
     }
 
-    void Table::ThreadSelect(const Pages::IndexAllocationMapPage *tableMapPage, const extent_id_t &extentId, const size_t &rowsToSelect, const vector<Field> *conditions, vector<Row> *selectedRows)
+    void Table::ThreadSelect(const Pages::IndexAllocationMapPage *tableMapPage, const extent_id_t &extentId, const size_t &rowsToSelect, const RowPredicate *predicate, const vector<column_index_t>& selectedColumnIndices, vector<Row> *selectedRows, atomic<size_t> &selectedRowCount, Arenas::MonotonicArena *extentArena)
     {
         const page_id_t extentFirstPageId = Database::CalculateSystemPageOffset(extentId * EXTENT_SIZE);
 
@@ -517,25 +554,40 @@ namespace DatabaseEngine::StorageTypes {
                                     ? extentFirstPageId
                                     : extentFirstPageId + 1;
 
+        // the pages are read, filtered and copied without a lock, only the rows found are handed over under it
+        vector<Row> extentRows;
+
         for (page_id_t extentPageId = pageId; extentPageId < extentFirstPageId + EXTENT_SIZE; extentPageId++)
         {
+            if (selectedRowCount.load(memory_order_relaxed) >= rowsToSelect)
+                break;
+
             if (pageFreeSpacePage->GetPageType(extentPageId) != PageType::DATA)
                 break;
 
-            const Page *page = StorageManager::Get().GetPage(extentPageId, extentId, this);
+            const PageGuard<Page> page = StorageManager::Get().GetPage(extentPageId, extentId, this);
 
             if (page->GetPageSize() == 0)
                 continue;
 
-            this->pageSelectMutex.lock();
+            const size_t previousRowCount = extentRows.size();
 
-            page->GetRows(selectedRows, *this, rowsToSelect, conditions);
+            // no selected columns is every column on a heap scan
+            page->GetRows(&extentRows, *this, rowsToSelect, selectedColumnIndices.empty() ? nullptr : &selectedColumnIndices, predicate, extentArena);
 
-            this->pageSelectMutex.unlock();
-
-            if (selectedRows->size() >= rowsToSelect)
-                return;
+            selectedRowCount.fetch_add(extentRows.size() - previousRowCount, memory_order_relaxed);
         }
+
+        if (extentRows.empty())
+            return;
+
+        lock_guard lock(this->selectedRowsMutex);
+
+        // the count above is a hint, the limit holds for what ends up in selectedRows
+        const size_t rowsLeft = (selectedRows->size() < rowsToSelect) ? rowsToSelect - selectedRows->size() : 0;
+        const size_t rowsToMove = min(rowsLeft, extentRows.size());
+
+        selectedRows->insert(selectedRows->end(), make_move_iterator(extentRows.begin()), make_move_iterator(extentRows.begin() + static_cast<ptrdiff_t>(rowsToMove)));
     }
 
     unordered_set<column_index_t> Table::GetClusteredIndexesMap() const
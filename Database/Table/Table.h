@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <unordered_set>
@@ -15,6 +16,11 @@ namespace Indexing{
     class BPlusTree;
 }
 
+namespace Arenas
+{
+    class MonotonicArena;
+}
+
 namespace DatabaseEngine
 {
     class Database;
@@ -22,6 +28,7 @@ namespace DatabaseEngine
     namespace StorageTypes
     {
         class Row;
+        class RowPredicate;
     }
 }
 
@@ -29,6 +36,7 @@ namespace Pages
 {
     class Page;
     class LargeDataPage;
+    class IndexPage;
     struct DataObject;
 }
 
@@ -90,14 +98,15 @@ namespace DatabaseEngine::StorageTypes
         const vector<void (*)(Block *&block, const Field &inputData)> setBlockDataByDataTypeArray = {&Table::SetTinyIntData, &Table::SetSmallIntData, &Table::SetIntData, &Table::SetBigIntData, &Table::SetDecimalData, &Table::SetStringData, &Table::SetUnicodeStringData, &Table::SetBoolData, &Table::SetDateTimeData};
         Indexing::BPlusTree* clusteredIndexedTree;
         vector<Indexing::BPlusTree*> nonClusteredIndexedTrees;
-        mutex pageSelectMutex;
+        // extent tasks of a heap scan hand their rows over under it
+        mutex selectedRowsMutex;
 
         protected:
 
             [[nodiscard]] unordered_set<column_index_t> GetClusteredIndexesMap() const;
             
             void InsertLargeObjectToPage(Row *row);
-            [[nodiscard]] Pages::LargeDataPage *GetOrCreateLargeDataPage() const;
+            [[nodiscard]] Storage::PageGuard<Pages::LargeDataPage> GetOrCreateLargeDataPage() const;
             
             static void LinkLargePageDataObjectChunks(Pages::DataObject *dataObject, const page_id_t &lastLargePageId, const large_page_index_t &objectIndex);
             void InsertLargeDataObjectPointerToRow(Row *row, const bool &isFirstRecursion, const large_page_index_t &objectIndex, const page_id_t &lastLargePageId, const column_index_t &largeBlockIndex) const;
@@ -120,12 +129,13 @@ namespace DatabaseEngine::StorageTypes
         
             void GetClusteredIndexFromDisk() const;
             void GetNonClusteredIndexFromDisk(const int& indexId) const;
-            [[nodiscard]] Indexing::Node* GetIndexFromDisk(const page_id_t& indexPageId) const;
+            // the root node is only valid while the returned page is held
+            [[nodiscard]] Storage::PageGuard<Pages::IndexPage> GetIndexFromDisk(const page_id_t& indexPageId) const;
         
-            void SelectRowsFromClusteredIndex(vector<Row> *selectedRows, const size_t &rowsToSelect, const Indexing::Key& minimumValue, const Indexing::Key& maximumValue, const bool indexSeek, const vector<column_index_t>& selectedColumnIndices);
-            void SelectRowsFromNonClusteredIndex(vector<Row> *selectedRows, const size_t &rowsToSelect, const vector<Field> *conditions, const vector<column_index_t>& selectedColumnIndices);
-            void SelectRowsFromHeap(vector<Row> *selectedRows, const size_t &rowsToSelect, const vector<Field> *conditions);
-            void ThreadSelect(const Pages::IndexAllocationMapPage *tableMapPage, const extent_id_t &extentId, const size_t &rowsToSelect, const vector<Field> *conditions, vector<Row> *selectedRows);
+            void SelectRowsFromClusteredIndex(vector<Row> *selectedRows, const size_t &rowsToSelect, const Indexing::Key& minimumValue, const Indexing::Key& maximumValue, const bool indexSeek, const vector<column_index_t>& selectedColumnIndices, Arenas::MonotonicArena *resultArena);
+            void SelectRowsFromNonClusteredIndex(vector<Row> *selectedRows, const size_t &rowsToSelect, const vector<Field> *conditions, const vector<column_index_t>& selectedColumnIndices, Arenas::MonotonicArena *resultArena);
+            void SelectRowsFromHeap(vector<Row> *selectedRows, const size_t &rowsToSelect, const vector<Field> *conditions, const vector<column_index_t>& selectedColumnIndices, Arenas::MonotonicArena *resultArena);
+            void ThreadSelect(const Pages::IndexAllocationMapPage *tableMapPage, const extent_id_t &extentId, const size_t &rowsToSelect, const RowPredicate *predicate, const vector<column_index_t>& selectedColumnIndices, vector<Row> *selectedRows, atomic<size_t> &selectedRowCount, Arenas::MonotonicArena *extentArena);
             
             Row* CreateRow(const vector<Field>& inputData);
 
@@ -148,13 +158,17 @@ namespace DatabaseEngine::StorageTypes
 
             [[nodiscard]] const vector<Column *> &GetColumns() const;
 
-            [[nodiscard]] Pages::LargeDataPage *GetLargeDataPage(const page_id_t &pageId) const;
+            [[nodiscard]] Storage::PageGuard<Pages::LargeDataPage> GetLargeDataPage(const page_id_t &pageId) const;
 
             [[nodiscard]] const vector<vector<column_index_t>>& GetNonClusteredIndexes() const;
 
             [[nodiscard]] const vector<column_index_t>& GetClusteredIndex() const;
 
-            void Select(vector<Row> &selectedRows, const vector<column_index_t>& selectedColumnIndices, const vector<Field> *conditions = nullptr, const size_t &count = -1);
+            // result rows are carved from resultArena when one is given, it has to outlive selectedRows
+            void Select(vector<Row> &selectedRows, const vector<column_index_t>& selectedColumnIndices, const vector<Field> *conditions = nullptr, const size_t &count = -1, Arenas::MonotonicArena *resultArena = nullptr);
+
+            // the value of the condition as a Block of its column, the caller owns it
+            [[nodiscard]] Block *CreateConditionBlock(const Field &condition) const;
 
             void Update(const vector<Field> &updates, const vector<Field> *conditions = nullptr) const;
 
@@ -1,17 +1,34 @@
-﻿#include <chrono>
+﻿#include <bit>
+#include <chrono>
 #include <cstdint>
 #include <exception>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 #include "./Database/Database.h"
 #include "./Database/Row/Row.h"
+#include <sstream>
 #include "AdditionalLibraries/AdditionalDataTypes/DateTime/DateTime.h"
 #include "AdditionalLibraries/AdditionalDataTypes/Field/Field.h"
 #include "AdditionalLibraries/AdditionalDataTypes/GroupCondition/GroupCondition.h"
 #include "Database/Column/Column.h"
 #include "Database/Constants.h"
 #include "Database/AdditionalFunctions/SortingFunctions.h"
+#include "Database/AdditionalFunctions/FilterKernels/FilterKernels.h"
+#include "Database/Pages/Page.h"
+#include "Database/Pages/IndexMapAllocation/IndexAllocationMapPage.h"
+#include "Database/Pages/IndexPage/IndexPage.h"
+#include "Database/Pages/PageFreeSpace/PageFreeSpacePage.h"
+#include "Database/QueryOperators/QueryOperator.h"
+#include "Database/QueryOperators/Batch/RowBatch.h"
+#include "Database/QueryOperators/Batch/BatchAggregate/BatchAggregateOperator.h"
+#include "Database/QueryOperators/Batch/BatchFilter/BatchFilterOperator.h"
+#include "Database/QueryOperators/Batch/BatchScan/BatchScanOperator.h"
+#include "Database/QueryOperators/Project/ProjectOperator.h"
+#include "Database/QueryOperators/Scan/ScanOperator.h"
+#include "Database/QueryOperators/Sort/SortOperator.h"
+#include "Database/Storage/BufferPool/BufferPool.h"
 #include "Database/Storage/StorageManager/StorageManager.h"
 #include "Database/Table/Table.h"
 #include "QueryParser/Tokenizer/Tokenizer.h"
@@ -21,12 +38,17 @@ using namespace DatabaseEngine;
 using namespace DatabaseEngine::StorageTypes;
 using namespace Storage;
 using namespace QueryParser;
+using namespace QueryOperators;
 
 void ExecuteQuery(Table* table, const vector<column_index_t>& selectedColumnIndices);
 void CreateMoviesTables(Database *db);
 void CreateActorsTable(Database *db);
 void InsertRowsToActorsTable(Table* table);
 void InsertRowsToMoviesTable(Table* table);
+void BenchmarkBufferPoolHits(const Table* table);
+void BenchmarkExtentLoadAndEviction(const Table* table);
+void BenchmarkFilterKernels();
+bool CheckTwoQueueScanResistance();
 // handle updates
 // deletes
 // row ids
@@ -36,10 +58,14 @@ void InsertRowsToMoviesTable(Table* table);
 //handle joins
 //deletes
 //advanced functions
-int main() 
+int main(int argc, char *argv[]) 
 {
 
     setlocale(LC_ALL, "");
+
+    // --stats dumps the buffer pool counters once the queries have run
+    const bool isStatisticsDumpEnabled = argc > 1 && string(argv[1]) == "--stats";
+
     Database *db = nullptr;
     try 
     {
@@ -88,6 +114,17 @@ int main()
         //table->Update(updates, nullptr);
 
         ExecuteQuery(table, selectedColumnIndices);
+
+        // BenchmarkBufferPoolHits(table);
+
+        // BenchmarkExtentLoadAndEviction(table);
+
+        // BenchmarkFilterKernels();
+
+        // CheckTwoQueueScanResistance();
+
+        if (isStatisticsDumpEnabled)
+            StorageManager::Get().PrintStatistics(cout);
     }
     catch (const exception &exception) 
     {
@@ -106,50 +143,62 @@ void ExecuteQuery(Table* table, const vector<column_index_t>& selectedColumnIndi
     //    Field("5", 0 , Operator::OperatorNone, ConditionType::ConditionNone)
     //};
 
-    vector<Row> rows;
-    vector<Row*> result;
-
-    const auto start = std::chrono::high_resolution_clock::now();
-
     const vector<Field> conditions = {
         Field("10", 0, Operator::GreaterThan, ConditionType::ConditionNone),
     };
 
-    table->Select(rows, selectedColumnIndices, &conditions);
+    // rows are pulled through the plan one at a time, only the sort holds on to them
+    // the conditions are checked on the pages, rows that fail them are never copied out
+    QueryOperator* plan = new ScanOperator(table, {}, conditions);
+    plan = new SortOperator(plan, { SortCondition(0, SortType::DESCENDING, false) });
+    plan = new ProjectOperator(plan, table, selectedColumnIndices);
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    plan->Open();
+
+    uint64_t rowCount = 0;
+    const Row* row;
+
+    while (plan->Next(row))
+    {
+        row->PrintRow();
+        rowCount++;
+    }
+
+    plan->Close();
 
     const auto end = std::chrono::high_resolution_clock::now();
 
-    result.reserve(rows.size());
-    for(auto& row: rows)
-            result.push_back(&row);
+    delete plan;
 
-    // Database::JoinTables(result, table, { Field("", 0, Operator::OperatorNone, ConditionType::ConditionNone) });
+    cout << "Rows printed: " << rowCount << endl;
 
     const auto elapsed = std::chrono::duration<double, std::milli>(end - start);
 
-    const auto orderStart = std::chrono::high_resolution_clock::now();
+    // Database::JoinTables(result, table, { Field("", 0, Operator::OperatorNone, ConditionType::ConditionNone) });
 
-    SortingFunctions::OrderBy(result, { SortCondition(0, SortType::DESCENDING, false)});
+    const auto groupByStart = std::chrono::high_resolution_clock::now();
 
-    const auto orderEnd = std::chrono::high_resolution_clock::now();
+    // only the grouped column is scanned, the rows travel in batches of typed column vectors
+    BatchAggregateOperator groupBy(new BatchFilterOperator(new BatchScanOperator(table, { 0 }), table, conditions), { GroupCondition(0, ColumnType::Int, AggregateFunction::COUNT, false, nullptr)});
 
-    const auto orderElapsed = std::chrono::duration<double, std::milli>(orderEnd - orderStart);
+    groupBy.Open();
 
-    const auto groupByStart = std::chrono::high_resolution_clock::now();
+    uint64_t groupCount = 0;
+    RowBatch *groupBatch;
+
+    while (groupBy.Next(groupBatch))
+        groupCount += groupBatch->GetSize();
 
-    const auto groupByResult = SortingFunctions::GroupBy(result, { GroupCondition(0, ColumnType::Int, AggregateFunction::COUNT, false, nullptr)});
+    groupBy.Close();
 
     const auto groupByEnd = std::chrono::high_resolution_clock::now();
 
     const auto groupByElapsed = std::chrono::duration<double, std::milli>(groupByEnd - groupByStart);
 
-    //construct the query result here
-
-    PrintRows(result);
-    
     cout << "Time elapsed : " << elapsed.count() << "ms" << endl;
-    cout<< "Order By Time: "<< orderElapsed.count() << "ms" << endl;
-    cout<< "Group By Time: "<< groupByElapsed.count() << "ms" << endl;
+    cout<< "Group By Time: "<< groupByElapsed.count() << "ms (" << groupCount << " groups)" << endl;
 }
 
 void CreateActorsTable(Database *db) 
@@ -270,4 +319,267 @@ void InsertRowsToMoviesTable(Table* table)
     }
 
     table->InsertRows(inputData);
-}
\ No newline at end of file
+}
+
+void BenchmarkBufferPoolHits(const Table* table)
+{
+    const page_id_t indexAllocationMapPageId = table->GetTableHeader().indexAllocationMapPageId;
+
+    if (indexAllocationMapPageId == 0)
+        return;
+
+    const Pages::IndexAllocationMapPage* tableMapPage = StorageManager::Get().GetIndexAllocationMapPage(indexAllocationMapPageId);
+
+    vector<extent_id_t> extentIds;
+    tableMapPage->GetAllocatedExtents(&extentIds);
+
+    //keep the working set well below the cache size so every lookup is a hit
+    vector<pair<page_id_t, extent_id_t>> residentPages;
+    for (const auto& extentId : extentIds)
+    {
+        const page_id_t firstExtentPageId = Database::CalculateSystemPageOffsetByExtentId(extentId);
+
+        for (page_id_t pageId = firstExtentPageId; pageId < firstExtentPageId + EXTENT_SIZE; pageId++)
+        {
+            const Pages::PageFreeSpacePage* pageFreeSpacePage = StorageManager::Get().GetPageFreeSpacePage(Database::GetPfsAssociatedPage(pageId));
+
+            if (pageFreeSpacePage->GetPageType(pageId) == PageType::DATA && residentPages.size() < StorageManager::Get().GetDataPoolBytes() / PAGE_SIZE / 2)
+                residentPages.emplace_back(pageId, extentId);
+        }
+    }
+
+    if (residentPages.empty())
+        return;
+
+    for (const auto& [pageId, extentId] : residentPages)
+        (void)StorageManager::Get().GetPage(pageId, extentId, table);
+
+    constexpr size_t lookupsPerThread = 1000000;
+
+    cout << "Buffer pool shards: " << StorageManager::Get().GetNumberOfShards() << endl;
+
+    for (size_t numberOfThreads = 1; numberOfThreads <= 32; numberOfThreads *= 2)
+    {
+        vector<thread> workerThreads;
+
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        for (size_t threadIndex = 0; threadIndex < numberOfThreads; threadIndex++)
+        {
+            workerThreads.emplace_back([&residentPages, table, threadIndex]
+            {
+                size_t position = threadIndex * 7919;
+
+                for (size_t i = 0; i < lookupsPerThread; i++)
+                {
+                    const auto& [pageId, extentId] = residentPages[position % residentPages.size()];
+
+                    (void)StorageManager::Get().GetPage(pageId, extentId, table);
+
+                    position++;
+                }
+            });
+        }
+
+        for (auto& workerThread : workerThreads)
+            workerThread.join();
+
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        const auto elapsed = std::chrono::duration<double>(end - start);
+
+        const double lookupsPerSecond = static_cast<double>(numberOfThreads * lookupsPerThread) / elapsed.count();
+
+        cout << "Threads: " << numberOfThreads << " || GetPage hits/s: " << static_cast<uint64_t>(lookupsPerSecond) << endl;
+    }
+}
+
+void BenchmarkExtentLoadAndEviction(const Table* table)
+{
+    const page_id_t indexAllocationMapPageId = table->GetTableHeader().indexAllocationMapPageId;
+
+    if (indexAllocationMapPageId == 0)
+        return;
+
+    const Pages::IndexAllocationMapPage* tableMapPage = StorageManager::Get().GetIndexAllocationMapPage(indexAllocationMapPageId);
+
+    vector<extent_id_t> extentIds;
+    tableMapPage->GetAllocatedExtents(&extentIds);
+
+    //serialize the data pages once and replay loading and evicting them, so only decoding and freeing is measured
+    vector<string> pageImages;
+    for (const auto& extentId : extentIds)
+    {
+        const page_id_t firstExtentPageId = Database::CalculateSystemPageOffsetByExtentId(extentId);
+
+        for (page_id_t pageId = firstExtentPageId; pageId < firstExtentPageId + EXTENT_SIZE; pageId++)
+        {
+            const Pages::PageFreeSpacePage* pageFreeSpacePage = StorageManager::Get().GetPageFreeSpacePage(Database::GetPfsAssociatedPage(pageId));
+
+            if (pageFreeSpacePage->GetPageType(pageId) != PageType::DATA)
+                continue;
+
+            const PageGuard<Pages::Page> page = StorageManager::Get().GetPage(pageId, extentId, table);
+
+            stringstream pageStream;
+            page->WritePageToFile(&pageStream);
+
+            string pageImage = pageStream.str();
+            pageImage.resize(PAGE_SIZE);
+
+            pageImages.push_back(std::move(pageImage));
+        }
+    }
+
+    if (pageImages.empty())
+        return;
+
+    constexpr size_t rounds = 100;
+
+    for (const bool isRowArenaEnabled : { false, true })
+    {
+        Pages::Page::SetRowArenaEnabled(isRowArenaEnabled);
+
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        for (size_t round = 0; round < rounds; round++)
+        {
+            for (const auto& pageImage : pageImages)
+            {
+                const span<const char> buffer(pageImage.data(), pageImage.size());
+                page_offset_t offSet = 0;
+
+                const Pages::PageHeader pageHeader = StorageManager::GetPageHeaderFromFile(buffer, offSet);
+
+                //load decodes every row and eviction frees them, as an update or a split would
+                auto* page = new Pages::Page(pageHeader);
+                page->GetPageDataFromFile(buffer, table, offSet, nullptr);
+                (void)page->GetDataRowsUnsafe();
+
+                delete page;
+            }
+        }
+
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        const auto elapsed = std::chrono::duration<double>(end - start);
+
+        const double extentsPerSecond = static_cast<double>(rounds * pageImages.size()) / EXTENT_SIZE / elapsed.count();
+
+        cout << "Row arena: " << (isRowArenaEnabled ? "on" : "off") << " || extent load and evict/s: " << static_cast<uint64_t>(extentsPerSecond) << endl;
+    }
+
+    Pages::Page::SetRowArenaEnabled(true);
+}
+
+void BenchmarkFilterKernels()
+{
+    constexpr size_t numberOfValues = 1 << 24;
+    constexpr size_t rounds = 20;
+
+    //values spread over a small range so every operator selects a fair share of them
+    vector<int32_t> values(numberOfValues);
+    uint32_t seed = 12345;
+
+    for (auto& value : values)
+    {
+        seed = seed * 1664525 + 1013904223;
+        value = static_cast<int32_t>(seed >> 16) % 1000;
+    }
+
+    vector<uint64_t> selection((BATCH_SIZE + 63) / 64);
+
+    const vector<pair<Operator, string>> operators = { {Equal, "="}, {NotEqual, "!="}, {LessThan, "<"}, {LessOrEqual, "<="}, {GreaterThan, ">"}, {GreaterOrEqual, ">="}, {OperatorNone, "BETWEEN"} };
+    const vector<pair<FilterKernelLevel, string>> kernelLevels = { {FilterKernelLevel::SCALAR, "scalar"}, {FilterKernelLevel::SSE42, "sse4.2"}, {FilterKernelLevel::AVX2, "avx2"} };
+
+    for (const auto& [kernelLevel, kernelName] : kernelLevels)
+    {
+        if (kernelLevel > FilterKernels::GetSupportedKernelLevel())
+            continue;
+
+        FilterKernels::SetKernelLevel(kernelLevel);
+
+        for (const auto& [operatorType, operatorName] : operators)
+        {
+            //the count keeps the compiler from dropping the work and shows every level selects the same rows
+            uint64_t selectedRows = 0;
+
+            const auto start = std::chrono::high_resolution_clock::now();
+
+            for (size_t round = 0; round < rounds; round++)
+            {
+                //one batch at a time, as BatchFilterOperator runs them
+                for (size_t offset = 0; offset < numberOfValues; offset += BATCH_SIZE)
+                {
+                    if (operatorName == "BETWEEN")
+                        FilterKernels::Between(values.data() + offset, BATCH_SIZE, 250, 750, selection.data());
+                    else
+                        FilterKernels::Compare(values.data() + offset, BATCH_SIZE, operatorType, 500, selection.data());
+
+                    for (const auto& word : selection)
+                        selectedRows += popcount(word);
+                }
+            }
+
+            const auto end = std::chrono::high_resolution_clock::now();
+
+            const auto elapsed = std::chrono::duration<double>(end - start);
+
+            const double valuesPerSecond = static_cast<double>(rounds * numberOfValues) / elapsed.count();
+
+            cout << "Kernel: " << kernelName << " || Operator: " << operatorName << " || values/s: " << static_cast<uint64_t>(valuesPerSecond) << " || selected: " << selectedRows / rounds << endl;
+        }
+    }
+
+    FilterKernels::SetKernelLevel(FilterKernels::GetSupportedKernelLevel());
+}
+
+bool CheckTwoQueueScanResistance()
+{
+    constexpr size_t capacity = 64;
+    constexpr page_id_t numberOfIndexPages = 8;
+    constexpr page_id_t firstScanPageId = 1000;
+    constexpr size_t scannedExtents = 4 * capacity / EXTENT_SIZE;
+
+    BufferPool bufferPool(capacity, 1, [](Pages::Page *page, const vector<Pages::Page *> &) { delete page; }, ReplacementPolicyType::TWO_QUEUE);
+
+    //index pages are read once, pushed out of probation by other pages and read again, which makes them protected
+    for (page_id_t pageId = 1; pageId <= numberOfIndexPages; pageId++)
+        bufferPool.InsertPage(new Pages::IndexPage(pageId, true));
+
+    for (page_id_t pageId = firstScanPageId - capacity; pageId < firstScanPageId; pageId++)
+        bufferPool.InsertPage(new Pages::Page(pageId, true));
+
+    for (page_id_t pageId = 1; pageId <= numberOfIndexPages; pageId++)
+    {
+        bufferPool.InsertPage(new Pages::IndexPage(pageId, true));
+        (void)bufferPool.GetPage(pageId);
+    }
+
+    //a heap scan over four times as many pages as the pool holds, extents are loaded whole and every page is read twice
+    for (size_t extent = 0; extent < scannedExtents; extent++)
+    {
+        const page_id_t firstExtentPageId = firstScanPageId + extent * EXTENT_SIZE;
+
+        for (page_id_t pageId = firstExtentPageId; pageId < firstExtentPageId + EXTENT_SIZE; pageId++)
+            bufferPool.InsertPage(new Pages::Page(pageId, true));
+
+        for (page_id_t pageId = firstExtentPageId; pageId < firstExtentPageId + EXTENT_SIZE; pageId++)
+        {
+            (void)bufferPool.GetPage(pageId);
+            (void)bufferPool.GetPage(pageId);
+        }
+    }
+
+    page_id_t residentIndexPages = 0;
+
+    for (page_id_t pageId = 1; pageId <= numberOfIndexPages; pageId++)
+        if (bufferPool.ContainsPage(pageId))
+            residentIndexPages++;
+
+    const bool isScanResistant = residentIndexPages == numberOfIndexPages;
+
+    cout << "2Q scan resistance: " << residentIndexPages << " / " << numberOfIndexPages << " index pages resident after the scan || " << (isScanResistant ? "passed" : "failed") << endl;
+
+    return isScanResistant;
+}